@@ -1,20 +1,20 @@
 rm *.out *.tbl *.dot *.svg *.lda *.tok *.mtk *.err *.html
 
-./geraLR -w 0 -yndfoxlsLSNDA -C bege_marrom.cfg gram00.grm
-./geraLR -w 0 -yndfoxlsLSNDA -C bege_marrom.cfg gram01.grm
-./geraLR -w 0 -yndfoxlsLSNDA -C bege_marrom.cfg gram02.grm
-./geraLR -w 0 -yndfoxlsLSNDA -C bege_marrom.cfg gram03.grm
-./geraLR -w 0 -yndfoxlsLSNDA -C bege_marrom.cfg gram04a.grm
-./geraLR -w 0 -yndfoxlsLSNDA -C bege_marrom.cfg gram04b.grm
-./geraLR -w 0 -yndfoxlsLSNDA -C bege_marrom.cfg gram05.grm
-./geraLR -w 0 -yndfoxlsLSNDA -C bege_marrom.cfg gram06.grm
-./geraLR -w 0 -yndfoxlsLSNDA -C bege_marrom.cfg gram07.grm
-./geraLR -w 0 -yndfoxlsLSNDA -C bege_marrom.cfg gram08.grm
-./geraLR -w 0 -yndfoxlsLSNDA -C bege_marrom.cfg gram09a.grm
-./geraLR -w 0 -yndfoxlsLSNDA -C bege_marrom.cfg gram09b.grm
-./geraLR -w 0 -yndfoxlsLSNDA -C bege_marrom.cfg gram10.grm
-./geraLR -w 0 -yndfoxlsLSNDA -C bege_marrom.cfg gram11.grm
-./geraLR -w 0 -yndfoxlsLSNDA -C bege_marrom.cfg gram12.grm
+./geraLR -w 0 -yndfoxlsLSNDAG -C bege_marrom.cfg gram00.grm
+./geraLR -w 0 -yndfoxlsLSNDAG -C bege_marrom.cfg gram01.grm
+./geraLR -w 0 -yndfoxlsLSNDAG -C bege_marrom.cfg gram02.grm
+./geraLR -w 0 -yndfoxlsLSNDAG -C bege_marrom.cfg gram03.grm
+./geraLR -w 0 -yndfoxlsLSNDAG -C bege_marrom.cfg gram04a.grm
+./geraLR -w 0 -yndfoxlsLSNDAG -C bege_marrom.cfg gram04b.grm
+./geraLR -w 0 -yndfoxlsLSNDAG -C bege_marrom.cfg gram05.grm
+./geraLR -w 0 -yndfoxlsLSNDAG -C bege_marrom.cfg gram06.grm
+./geraLR -w 0 -yndfoxlsLSNDAG -C bege_marrom.cfg gram07.grm
+./geraLR -w 0 -yndfoxlsLSNDAG -C bege_marrom.cfg gram08.grm
+./geraLR -w 0 -yndfoxlsLSNDAG -C bege_marrom.cfg gram09a.grm
+./geraLR -w 0 -yndfoxlsLSNDAG -C bege_marrom.cfg gram09b.grm
+./geraLR -w 0 -yndfoxlsLSNDAG -C bege_marrom.cfg gram10.grm
+./geraLR -w 0 -yndfoxlsLSNDAG -C bege_marrom.cfg gram11.grm
+./geraLR -w 0 -yndfoxlsLSNDAG -C bege_marrom.cfg gram12.grm
 
 ./lidas -d LiDAS.mel -p gram00.grm-NFA.lda gram00.grm-NFA.svg
 ./lidas -d LiDAS.mel -p gram01.grm-NFA.lda gram01.grm-NFA.svg
@@ -508,6 +508,7 @@ static bool options_are_exclusive (int index1, int index2)
 *---------------------------------------------------------------------
 *   Free all memory dinamically allocated by the parsing procedure.
 *   Return a boolean indicating whether it was successful.
+*   Everything is reset, so another command line can be parsed.
 *---------------------------------------------------------------------
 */
 
@@ -547,6 +548,18 @@ void COMMLINE_free_commLine_data (void)
    free (formatStr);
  if (str2val_error)
    free (str2val_error);
+ optData         = NULL;
+ optUses         = NULL;
+ nonOptArgsData  = NULL;
+ optExclData     = NULL;
+ formatStr       = NULL;
+ str2val_error   = NULL;
+ formal_options  = 0;
+ actual_options  = 0;
+ non_opt_args    = 0;
+ b_commLine_ok   = false;
+ b_formalOpts_ok = false;
+ b_nonOptArgs_ok = false;
 }
 
 /*
@@ -0,0 +1,272 @@
+/*
+*-----------------------------------------------------------------------
+*
+*   File         : conflicts.c
+*   Created      : 2026-10-19
+*   Last Modified: 2026-10-19
+*
+*   DESCRIPTION:
+*   Finds the parse table cells that would get more than one action,
+*   state by state, using only the DFA items and the FOLLOW sets. The
+*   rules are those of build_LR0_parse_table() and
+*   build_sLR1_parse_table(): a shift item shifts on its transition
+*   symbol; a reduction item reduces on every terminal in LR(0), and
+*   on the FOLLOW set of its lefthand symbol in sLR(1), except that
+*   the first rule accepts on end-of-input.
+*
+*   A cell with a shift and at least one reduction is a shift/reduce
+*   conflict; a cell with two or more reductions and no shift is a
+*   reduce/reduce conflict. Each conflict is printed with the items
+*   that compete for the cell as soon as its state has been scanned,
+*   and no parse table is ever built.
+*
+*-----------------------------------------------------------------------
+*/
+
+/*
+*-----------------------------------------------------------------------
+*   LIBRARIES AND INCLUDE FILES
+*-----------------------------------------------------------------------
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "common.h"
+#include "error.h"
+#include "grammar.h"
+#include "conflicts.h"
+
+/*
+*---------------------------------------------------------------------
+*
+*   INTERFACE (visible from other modules)
+*
+*---------------------------------------------------------------------
+*/
+
+/*                     */
+/* Function prototypes */
+/*                     */
+
+unsigned int report_conflicts (t_parse_table_type parse_table_type);
+
+/* To prevent "implicit declaration" warnings */
+
+int snprintf (char *str, size_t size, const char *format, ...);
+
+/*
+*---------------------------------------------------------------------
+*
+*   IMPLEMENTATION (not visible from other modules)
+*
+*---------------------------------------------------------------------
+*/
+
+/* Actions in the row of the state being scanned, by terminal code minus the first terminal code */
+
+static bool
+  b_shiftOn [MAX_TERMINALS];
+static unsigned int
+  totReductionsOn [MAX_TERMINALS];
+
+/*                       */
+/* Function declarations */
+/*                       */
+
+static bool b_reducesOn    (t_parse_table_type parse_table_type, t_ruleNumber ruleNumber, t_symbolCode symbolCode);
+static void print_item     (t_itemCode itemCode);
+static void print_conflict (t_parse_table_type parse_table_type, t_stateCode stateCode, t_symbolCode symbolCode);
+
+/*
+*---------------------------------------------------------------------
+* Tell whether a reduction by a rule goes in the column of a terminal
+*---------------------------------------------------------------------
+*/
+
+static bool b_reducesOn (t_parse_table_type parse_table_type, t_ruleNumber ruleNumber, t_symbolCode symbolCode)
+{
+ t_symbolCode
+   lefthandSymbol;
+ unsigned int
+   iFollowSymbol;
+
+ if (parse_table_type == t_LR0_parse_table)
+   return (true);
+ if (ruleNumber == 1)
+   return (symbolCode == end_of_input_code);
+ lefthandSymbol = rulePos2symbolCode (ruleNumber, 0);
+ for (iFollowSymbol = 1; iFollowSymbol <= setSize (t_followSet, lefthandSymbol); iFollowSymbol++)
+   if (getSymbolInSet (t_followSet, lefthandSymbol, iFollowSymbol) == symbolCode)
+     return (true);
+ return (false);
+}
+
+/*
+*---------------------------------------------------------------------
+* Print an LR(0) item the way the DFA text report does
+*---------------------------------------------------------------------
+*/
+
+static void print_item (t_itemCode itemCode)
+{
+ t_ruleNumber
+   ruleNumber;
+ t_dotPosition
+   dotPosition;
+ unsigned int
+   iSymbol,
+   ruleSize;
+
+ ruleNumber = itemCode2ruleNumber (itemCode);
+ ruleSize = ruleNumber2ruleSize (ruleNumber);
+ dotPosition = itemCode2dotPosition (itemCode);
+ printf ("%s ->", symbolCode2symbolString (rulePos2symbolCode (ruleNumber, 0)));
+ if (dotPosition == 0)
+   printf (" •");
+ for (iSymbol = 1; iSymbol <= ruleSize; iSymbol++) {
+   printf (" %s", symbolCode2symbolString (rulePos2symbolCode (ruleNumber, iSymbol)));
+   if (dotPosition == iSymbol)
+     printf (" •");
+ }
+ printf ("\n");
+}
+
+/*
+*---------------------------------------------------------------------
+* Print one conflict and the items of the state that take part in it
+*---------------------------------------------------------------------
+*/
+
+static void print_conflict (t_parse_table_type parse_table_type, t_stateCode stateCode, t_symbolCode symbolCode)
+{
+ unsigned int
+   iItem,
+   symbolIndex;
+ t_itemCode
+   itemCode;
+ t_ruleNumber
+   ruleNumber;
+
+ symbolIndex = (unsigned int) (symbolCode - symbolNumber2symbolCode (1, t_terminal));
+ printf ("State %d on %s: %s conflict\n", stateCode, symbolCode2symbolString (symbolCode),
+         b_shiftOn[symbolIndex] ? "shift/reduce" : "reduce/reduce");
+ for (iItem = 1; iItem <= dfa_stateCode2totItems (stateCode); iItem++) {
+   itemCode = dfa_stateCode2itemCode (stateCode, iItem);
+   if (isReductionItem (itemCode)) {
+     ruleNumber = itemCode2ruleNumber (itemCode);
+     if (! b_reducesOn (parse_table_type, ruleNumber, symbolCode))
+       continue;
+     printf ("  %-7s", ruleNumber == 1 ? "accept" : "reduce");
+   }
+   else if (itemCode2transitionSymbol (itemCode) == symbolCode)
+     printf ("  %-7s", "shift");
+   else
+     continue;
+   print_item (itemCode);
+ }
+}
+
+/*
+*---------------------------------------------------------------------
+* Scan every DFA state for the conflicts of an LR(0) or an sLR(1)
+* parse table, print them and return how many there are
+*---------------------------------------------------------------------
+*/
+
+unsigned int report_conflicts (t_parse_table_type parse_table_type)
+{
+ unsigned int
+   iState,
+   iItem,
+   iSymbol,
+   iFollowSymbol,
+   totShiftReduce    = 0,
+   totReduceReduce   = 0,
+   totConflictStates = 0;
+ t_stateCode
+   stateCode;
+ t_itemCode
+   itemCode;
+ t_ruleNumber
+   ruleNumber;
+ t_symbolCode
+   firstTerminalCode,
+   lefthandSymbol,
+   symbolCode;
+ t_symbolType
+   symbolType;
+ bool
+   b_stateHasConflicts;
+ const char
+   *tableName = NULL;
+
+ switch (parse_table_type) {
+   case (t_LR0_parse_table):  tableName = "LR(0)";  break;
+   case (t_sLR1_parse_table): tableName = "sLR(1)"; break;
+   default:
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "No conflicts report for parse table type %d\n", parse_table_type);
+     ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+ }
+ printf ("%s conflicts\n", tableName);
+ printf ("%.*s\n", (int) strlen (tableName) + 10, "----------------------");
+ firstTerminalCode = symbolNumber2symbolCode (1, t_terminal);
+
+ for (iState = 1; iState <= totDFAstates; iState++) {
+   stateCode = dfa_stateNumber2stateCode (iState);
+
+   /* Work out the shifts and the number of reductions on each terminal */
+
+   memset (b_shiftOn,       0, totTerminals * sizeof (bool));
+   memset (totReductionsOn, 0, totTerminals * sizeof (unsigned int));
+   for (iItem = 1; iItem <= dfa_stateCode2totItems (stateCode); iItem++) {
+     itemCode = dfa_stateCode2itemCode (stateCode, iItem);
+     if (isReductionItem (itemCode)) {
+       ruleNumber = itemCode2ruleNumber (itemCode);
+       if (parse_table_type == t_LR0_parse_table)
+         for (iSymbol = 0; iSymbol < totTerminals; iSymbol++)
+           totReductionsOn[iSymbol]++;
+       else if (ruleNumber == 1)
+         totReductionsOn[end_of_input_code - firstTerminalCode]++;
+       else {
+         lefthandSymbol = rulePos2symbolCode (ruleNumber, 0);
+         for (iFollowSymbol = 1; iFollowSymbol <= setSize (t_followSet, lefthandSymbol); iFollowSymbol++)
+           totReductionsOn[getSymbolInSet (t_followSet, lefthandSymbol, iFollowSymbol) - firstTerminalCode]++;
+       }
+     }
+     else {
+       symbolCode = itemCode2transitionSymbol (itemCode);
+       symbolType = symbolCode2symbolType (symbolCode);
+       if ((symbolType == t_terminal) || (symbolType == t_endOfInput))
+         b_shiftOn[symbolCode - firstTerminalCode] = true;
+     }
+   }
+
+   /* Any terminal with more than one action is a conflict */
+
+   b_stateHasConflicts = false;
+   for (iSymbol = 0; iSymbol < totTerminals; iSymbol++) {
+     if ((totReductionsOn[iSymbol] == 0) || ((totReductionsOn[iSymbol] == 1) && ! b_shiftOn[iSymbol]))
+       continue;
+     if (b_shiftOn[iSymbol])
+       totShiftReduce++;
+     else
+       totReduceReduce++;
+     b_stateHasConflicts = true;
+     print_conflict (parse_table_type, stateCode, (t_symbolCode) (firstTerminalCode + (t_symbolCode) iSymbol));
+   }
+   if (b_stateHasConflicts)
+     totConflictStates++;
+ }
+
+ if (totShiftReduce + totReduceReduce == 0)
+   printf ("%s: no conflicts\n", tableName);
+ else
+   printf ("%s: %u conflict%s (%u shift/reduce, %u reduce/reduce) in %u state%s\n", tableName,
+           totShiftReduce + totReduceReduce, (totShiftReduce + totReduceReduce == 1) ? "" : "s",
+           totShiftReduce, totReduceReduce, totConflictStates, (totConflictStates == 1) ? "" : "s");
+ printf ("\n");
+ return (totShiftReduce + totReduceReduce);
+}
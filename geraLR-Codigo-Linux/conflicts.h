@@ -0,0 +1,44 @@
+/*
+*-----------------------------------------------------------------------
+*
+*   File         : conflicts.h
+*   Created      : 2026-10-19
+*   Last Modified: 2026-10-19
+*
+*   DESCRIPTION:
+*   Shift/reduce and reduce/reduce conflicts of the LR(0) and sLR(1)
+*   parse tables, found straight from the DFA and the FOLLOW sets
+*   without building the tables
+*
+*-----------------------------------------------------------------------
+*/
+
+/*                                           */
+/* Make sure this file is not included twice */
+/*                                           */
+
+#ifndef _CONFLICTS_DOT_H_
+#define _CONFLICTS_DOT_H_
+
+/*
+*---------------------------------------------------------------------
+*   INCLUDE FILES
+*---------------------------------------------------------------------
+*/
+
+#include "grammar.h"
+
+/*
+*---------------------------------------------------------------------
+* Function prototypes
+*---------------------------------------------------------------------
+*/
+
+/* report_conflicts() prints each conflict to stdout as soon as it */
+/* is found, followed by a one-line summary, and returns the total */
+/* number of conflicts. parse_table_type must be t_LR0_parse_table */
+/* or t_sLR1_parse_table.                                          */
+
+extern unsigned int report_conflicts (t_parse_table_type parse_table_type);
+
+#endif /* ifndef _CONFLICTS_DOT_H_ */
@@ -1338,7 +1338,6 @@ static void validate_two_DATA_set_operation (DATA_t_set_code set1, DATA_t_set_co
 static unsigned int find_free_genericArray (void)
 {
  size_t
-   oldSize,
    newSize;
  unsigned int
    newMaximum,
@@ -1363,7 +1362,6 @@ static unsigned int find_free_genericArray (void)
  genericArrays_infoVector_totResizes_currBlockSize++;
 
  newMaximum = max_genericArrays + genericArrays_infoVector_currBlockSize;
- oldSize = genericArrays_infoVector_currSize;
  newSize = newMaximum * sizeof (t_genericArray_info);
  genericArrays_infoVector = (t_genericArray_info *) realloc ((void *) genericArrays_infoVector, newSize);
  if (genericArrays_infoVector == NULL) {
@@ -1371,7 +1369,7 @@ static unsigned int find_free_genericArray (void)
    data_error (0, __FILE__, __func__, auxErrorStr);
    return ((unsigned int) 0);
  }
- memset ((void *) &(genericArrays_infoVector[tot_genericArrays]), 0, newSize - oldSize);
+ genericArrays_infoVector_currSize = newSize;
  freeArrayIndex = max_genericArrays;
  max_genericArrays = newMaximum;
  for (iArray = freeArrayIndex; iArray < max_genericArrays; iArray++) {
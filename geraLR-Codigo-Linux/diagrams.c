@@ -47,10 +47,14 @@
 /*                     */
 
 void initialize_svg_attributes     (void);
+void reset_svg_attributes          (void);
 void initialize_nfa_svg_attributes (void);
 void initialize_dfa_svg_attributes (void);
 void free_svg_diagrams_data        (void);
 
+void open_graphviz_context  (void);
+int  close_graphviz_context (void);
+
 void print_nfa_txt (int argc, char *argv[]);
 void print_nfa_dot (void);
 int  print_nfa_svg (void);
@@ -81,6 +85,15 @@ int snprintf (char *str, size_t size, const char *format, ...);
 /* Pointer to config file */
 config_t configFilePt;
 
+/* Graphviz context, shared by every SVG export until it is closed */
+static GVC_t *graphvizContext = NULL;
+
+/* Built-in attributes, saved before a configuration file overrides */
+/* any of them, so reset_svg_attributes() can put them back          */
+
+static t_fsa_svg_attributes FSA_defaults[2];
+static bool b_FSA_defaults_saved = false;
+
 /* Array position indexed by t_FSA_type: t_NFA = 0, t_DFA = 1 */
 
 static t_fsa_svg_attributes FSA[2] = {  
@@ -350,6 +363,10 @@ const char * DFA_Attributes[] = {
 */
 
 void initialize_svg_attributes (void) {
+  if (! b_FSA_defaults_saved) {
+    memcpy (FSA_defaults, FSA, sizeof (FSA));
+    b_FSA_defaults_saved = true;
+  }
   config_init (&configFilePt);
 
   /* Read the file. If there is an error, report it and use de default values. */
@@ -362,6 +379,19 @@ void initialize_svg_attributes (void) {
   initialize_dfa_svg_attributes();
 }
 
+/*
+*-----------------------------------------------------------------------------
+* Put back the built-in SVG attributes, as if no configuration file had been
+* read. A server request without -C, or with a configuration file other than
+* the one the server read, must draw the same diagrams as a standalone run.
+*-----------------------------------------------------------------------------
+*/
+
+void reset_svg_attributes (void) {
+  if (b_FSA_defaults_saved)
+    memcpy (FSA, FSA_defaults, sizeof (FSA));
+}
+
 void initialize_nfa_svg_attributes (void) {
   config_setting_t 
     *setting;
@@ -683,6 +713,34 @@ void free_svg_diagrams_data (void) {
   config_destroy (&configFilePt);
 }
 
+/*
+*-----------------------------------------------------------------------------
+* Create the Graphviz context, unless there is one already. A server opens
+* it once and every request it forks reuses it.
+*-----------------------------------------------------------------------------
+*/
+
+void open_graphviz_context (void) {
+  if (graphvizContext == NULL)
+    graphvizContext = gvContext();
+}
+
+/*
+*-----------------------------------------------------------------------------
+* Free the Graphviz context
+*-----------------------------------------------------------------------------
+*/
+
+int close_graphviz_context (void) {
+  int rc = 0;
+
+  if (graphvizContext != NULL) {
+    rc = gvFreeContext (graphvizContext);
+    graphvizContext = NULL;
+  }
+  return (rc);
+}
+
 /*
 *-----------------------------------------------------------------------------
 * Print NFA, i.e. complete set of states and LR (0) items, in plain text format
@@ -695,6 +753,7 @@ void print_nfa_txt (int argc, char *argv[]) {
     iSymbol,
     iState,
     iTransition,
+    transitionNumber,
     dotPosition,
     ruleSize,
     symbolNumber,
@@ -777,11 +836,7 @@ void print_nfa_txt (int argc, char *argv[]) {
   }
   REPORT_newLine (nfaTextFilePt, 1);
 
-  /* Sort transitions by origin state code */
-
-  nfa_sortTransitions (t_transitionSortKey_origin);
-
-  /* Now print NFA state transitions */
+  /* Now print NFA state transitions, by origin state code */
 
   (void) STRING_copy ((char **) &headerLine1, "+--------------------------");
   (void) STRING_extend ((char **) &headerLine1, '-', (size_t) symbolWidth-8);
@@ -813,11 +868,12 @@ void print_nfa_txt (int argc, char *argv[]) {
   fprintf (nfaTextFilePt, "%s\n", headerLine2);
 
   for (iTransition = 1; iTransition <= totNFAtransitions; iTransition++) {
+    transitionNumber = nfa_sortedTransition2transitionNumber (t_transitionSortKey_origin, iTransition);
     (void) STRING_extend ((char **) &detailLine, 0, (size_t) 20);
     snprintf (detailLine, 19, "| %5d | %5d | ",
-              nfa_transitionNumber2originState (iTransition),
-              nfa_transitionNumber2destState (iTransition) );
-    (void) STRING_copy ((char **) &auxString, symbolCode2symbolString (nfa_transitionNumber2symbol (iTransition)));
+              nfa_transitionNumber2originState (transitionNumber),
+              nfa_transitionNumber2destState (transitionNumber) );
+    (void) STRING_copy ((char **) &auxString, symbolCode2symbolString (nfa_transitionNumber2symbol (transitionNumber)));
     (void) STRING_justify ((char **) &auxString, symbolWidth, ' ', STRING_t_justify_left);
     (void) STRING_concatenate ((char **) &detailLine, auxString);
     (void) STRING_concatenate ((char **) &detailLine, " |");
@@ -976,6 +1032,7 @@ void print_dfa_txt (int argc, char *argv[]) {
     iState,
     iSymbol,
     iTransition,
+    transitionNumber,
     dotPosition,
     symbolNumber,
     ruleSize,
@@ -1230,11 +1287,7 @@ void print_dfa_txt (int argc, char *argv[]) {
     fprintf (dfaTextFilePt, "+--------------------------------------+\n");
   REPORT_newLine (dfaTextFilePt, 1);
 
-  /* Sort transitions by origin state code */
-
-  dfa_sortTransitions (t_transitionSortKey_origin);
-
-  /* Now print DFA state transitions */
+  /* Now print DFA state transitions, by origin state code */
 
   (void) STRING_copy ((char **) &headerLine1, "+--------------------------");
   (void) STRING_extend ((char **) &headerLine1, '-', (size_t) symbolWidth-8);
@@ -1268,11 +1321,12 @@ void print_dfa_txt (int argc, char *argv[]) {
   fprintf (dfaTextFilePt, "%s\n", headerLine2);
 
   for (iTransition = 1; iTransition <= totDFAtransitions; iTransition++) {
+    transitionNumber = dfa_sortedTransition2transitionNumber (t_transitionSortKey_origin, iTransition);
     (void) STRING_set ((char **) &detailLine, 0, (size_t) 20);
     snprintf (detailLine, 19, "| %5d | %5d | ",
-              dfa_transitionNumber2originState (iTransition),
-              dfa_transitionNumber2destState (iTransition) );
-    (void) STRING_copy ((char **) &auxString, symbolCode2symbolString (dfa_transitionNumber2symbol (iTransition)));
+              dfa_transitionNumber2originState (transitionNumber),
+              dfa_transitionNumber2destState (transitionNumber) );
+    (void) STRING_copy ((char **) &auxString, symbolCode2symbolString (dfa_transitionNumber2symbol (transitionNumber)));
     (void) STRING_justify ((char **) &auxString, symbolWidth, ' ', STRING_t_justify_left);
     (void) STRING_concatenate ((char **) &detailLine, auxString);
     (void) STRING_concatenate ((char **) &detailLine, " |");
@@ -1430,6 +1484,7 @@ void print_nfa_dot (void) {
     iSymbol,
     iState,
     iTransition,
+    transitionNumber,
     dotPosition,
     ruleSize;
   t_stateCode
@@ -1444,7 +1499,7 @@ void print_nfa_dot (void) {
     symbolType;
   
   /* Open Dot file */
-  /* In geraLR.c the file is already open */
+  /* In geraLR.c the file is already open, as a memory stream */
 
   /* If initialize_svg_attributes() is not called, SVG diagrams will use these default values */
 
@@ -1626,9 +1681,6 @@ void print_nfa_dot (void) {
     }
   }
 
-  /* Sort transitions by origin state code */
-  nfa_sortTransitions (t_transitionSortKey_origin);
-  
   /* NFA state transitions */
   fprintf (nfaDotFilePt, "\n// TRANSITIONS: %d \n", (int) totNFAtransitions);
   fprintf (nfaDotFilePt, "%s",         EDGE_LABEL_START);
@@ -1648,8 +1700,9 @@ void print_nfa_dot (void) {
   fprintf (nfaDotFilePt, "%s=%.2f ",   NFA_Attributes[nfa_transition_arrow_penwidth],      FSA[0].transitionArrow.penwidth);
   fprintf (nfaDotFilePt, "%s",         LABEL_END);
   for (iTransition = 1; iTransition <= totNFAtransitions; iTransition++) {
-    fprintf (nfaDotFilePt, "%s%d->%s%d [id=\"%s%d\" label=<", ID_LABEL_STATE, nfa_transitionNumber2originState (iTransition), ID_LABEL_STATE, nfa_transitionNumber2destState (iTransition), ID_LABEL_TRANSITION, iTransition);
-    symbolCode = nfa_transitionNumber2symbol (iTransition);
+    transitionNumber = nfa_sortedTransition2transitionNumber (t_transitionSortKey_origin, iTransition);
+    fprintf (nfaDotFilePt, "%s%d->%s%d [id=\"%s%d\" label=<", ID_LABEL_STATE, nfa_transitionNumber2originState (transitionNumber), ID_LABEL_STATE, nfa_transitionNumber2destState (transitionNumber), ID_LABEL_TRANSITION, transitionNumber);
+    symbolCode = nfa_transitionNumber2symbol (transitionNumber);
     symbolType = symbolCode2symbolType (symbolCode);
     switch (symbolType) {
       case (t_terminal)   : fprintf (nfaDotFilePt, "<font color=\"%s\" face=\"%s\" point-size=\"%.1f\"> %s</font>", FSA[0].font.colour.terminal,     FSA[0].font.name.terminal,     FSA[0].font.size.terminal,     symbolCode2symbolString (symbolCode));  break;
@@ -1673,14 +1726,10 @@ void print_nfa_dot (void) {
 
 int print_nfa_svg (void) {
   graph_t *g;
-  GVC_t *gvc = gvContext();
+  GVC_t *gvc;
 
-  /* Open dot file for reading */
-  errno = 0;
-  if ((nfaDotFilePt = fopen (nfaDotFileName, "r")) == NULL) {
-    snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Cannot open \"%s\" for reading", nfaDotFileName);
-    ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
-  }
+  open_graphviz_context ();
+  gvc = graphvizContext;
 
   /* Open svg file for writing */
   errno = 0;
@@ -1699,19 +1748,22 @@ int print_nfa_svg (void) {
     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
   }
 
-  /* Export graph in svg format */
-  g = agread (nfaDotFilePt, 0);
+  /* Export graph in svg format, straight from the DOT source in memory */
+  if ((g = agmemread (nfaDotText)) == NULL) {
+    snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Graphviz cannot read the DOT source of \"%s\"", nfaDotFileName);
+    ERROR_fatal_error (0, progName, __func__, ERROR_auxErrorMsg);
+  }
   gvLayout (gvc, g, "dot");
   gvRender (gvc, g, "svg", nfaSvgFilePt);
   gvFreeLayout (gvc, g);
   agclose (g);
 
   /* That's all */
-  fclose (nfaDotFilePt);
   fclose (nfaSvgFilePt);
-  return (gvFreeContext (gvc));
+  return (0);
 }
 
+/* Runs the dot program on the .dot file, so it needs option -G */
 int print_nfa_svg2 (void) {
   /* Open svg file for writing */
   errno = 0;
@@ -1743,6 +1795,7 @@ void print_dfa_dot (void) {
     iState,
     iSymbol,
     iTransition,
+    transitionNumber,
     dotPosition,
     ruleSize;
   t_stateCode
@@ -1757,7 +1810,7 @@ void print_dfa_dot (void) {
     symbolType;
 
   /* Open Dot file */
-  /* In geraLR.c the file is already open */
+  /* In geraLR.c the file is already open, as a memory stream */
 
   /* If initialize_svg_attributes() is not called, SVG diagrams will use these default values */
 
@@ -2028,9 +2081,6 @@ void print_dfa_dot (void) {
     }
   }
 
-  /* Sort transitions by origin state code */
-  dfa_sortTransitions (t_transitionSortKey_origin);
-
   /* State transitions */
   fprintf (dfaDotFilePt, "\n// TRANSITIONS: %d \n", (int) totDFAtransitions);
   fprintf (dfaDotFilePt, "%s",         EDGE_LABEL_START);
@@ -2050,8 +2100,9 @@ void print_dfa_dot (void) {
   fprintf (dfaDotFilePt, "%s=%.2f ",   DFA_Attributes[dfa_transition_arrow_penwidth],      FSA[1].transitionArrow.penwidth);
   fprintf (dfaDotFilePt, "%s",         LABEL_END);
   for (iTransition = 1; iTransition <= totDFAtransitions; iTransition++) {
-    fprintf (dfaDotFilePt, "%s%d->%s%d [id=\"%s%d\" label=<", ID_LABEL_STATE, dfa_transitionNumber2originState (iTransition), ID_LABEL_STATE, dfa_transitionNumber2destState (iTransition), ID_LABEL_TRANSITION, iTransition);
-    symbolCode = dfa_transitionNumber2symbol (iTransition);
+    transitionNumber = dfa_sortedTransition2transitionNumber (t_transitionSortKey_origin, iTransition);
+    fprintf (dfaDotFilePt, "%s%d->%s%d [id=\"%s%d\" label=<", ID_LABEL_STATE, dfa_transitionNumber2originState (transitionNumber), ID_LABEL_STATE, dfa_transitionNumber2destState (transitionNumber), ID_LABEL_TRANSITION, transitionNumber);
+    symbolCode = dfa_transitionNumber2symbol (transitionNumber);
     symbolType = symbolCode2symbolType (symbolCode);
     switch (symbolType) {
       case (t_terminal)   : fprintf (dfaDotFilePt, "<font color=\"%s\" face=\"%s\" point-size=\"%.1f\"> %s</font>", FSA[1].font.colour.terminal,     FSA[1].font.name.terminal,     FSA[1].font.size.terminal,     symbolCode2symbolString (symbolCode));  break;
@@ -2076,14 +2127,10 @@ void print_dfa_dot (void) {
 
 int print_dfa_svg (void) {
   graph_t *g;
-  GVC_t *gvc = gvContext();
+  GVC_t *gvc;
 
-  /* Open dot file for reading */
-  errno = 0;
-  if ((dfaDotFilePt = fopen (dfaDotFileName, "r")) == NULL) {
-    snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Cannot open \"%s\" for reading", dfaDotFileName);
-    ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
-  }
+  open_graphviz_context ();
+  gvc = graphvizContext;
 
   /* Open svg file for writing */
   errno = 0;
@@ -2102,20 +2149,23 @@ int print_dfa_svg (void) {
     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
   }
 
-  /* Graph render to svg */
-  g = agread (dfaDotFilePt, 0);
+  /* Graph render to svg, straight from the DOT source in memory */
+  if ((g = agmemread (dfaDotText)) == NULL) {
+    snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Graphviz cannot read the DOT source of \"%s\"", dfaDotFileName);
+    ERROR_fatal_error (0, progName, __func__, ERROR_auxErrorMsg);
+  }
   gvLayout (gvc, g, "dot");
   gvRender (gvc, g, "svg", dfaSvgFilePt);
   gvFreeLayout (gvc, g);
   agclose (g);
 
   /* That's all */
-  fclose (dfaDotFilePt);
   fclose (dfaSvgFilePt);
 
-  return (gvFreeContext (gvc));
+  return (0);
 }
 
+/* Runs the dot program on the .dot file, so it needs option -G */
 int print_dfa_svg2 (void) {
   /* Open svg file to writing */
   errno = 0;
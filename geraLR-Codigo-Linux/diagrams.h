@@ -736,10 +736,14 @@ typedef enum {
  */
 
 extern void initialize_svg_attributes     (void);
+extern void reset_svg_attributes          (void);
 extern void initialize_nfa_svg_attributes (void);
 extern void initialize_dfa_svg_attributes (void);
 extern void free_svg_diagrams_data        (void);
 
+extern void open_graphviz_context  (void);
+extern int  close_graphviz_context (void);
+
 extern void print_nfa_txt (int argc, char *argv[]);
 extern void print_nfa_dot (void);
 extern int  print_nfa_svg (void);
@@ -0,0 +1,587 @@
+/*
+*-----------------------------------------------------------------------
+*
+*   File         : export.c
+*   Created      : 2026-10-19
+*   Last Modified: 2026-10-19
+*
+*   DESCRIPTION:
+*   Machine-readable export of everything geraLR builds, for tools that
+*   would otherwise have to scrape the text reports. Both formats are
+*   written in a single pass over the data structures, through a large
+*   stdio buffer, and hold the same fields in the same order:
+*
+*     format, version, grammar (file name)
+*     symbols     : [ {code, name, type} ]          type: terminal,
+*                                                   nonTerminal, endOfInput
+*     epsilon     : code of epsilon
+*     rules       : [ {lhs, rhs: [symbol codes]} ]  rule N is element N
+*     items       : [ {code, rule, dot} ]
+*     nfa         : {states: [ {item, type} ], transitions: [ {from, symbol, to} ]}
+*     dfa         : {states: [ {type, items: [item codes]} ], transitions: [ {from, symbol, to} ]}
+*     first       : [ {symbol, set: [symbol codes]} ]   terminals and non-terminals
+*     follow      : [ {symbol, set: [symbol codes]} ]   non-terminals
+*     lr0, slr1   : [ [ {symbol, action, state | rule} ] ]  one list per DFA state
+*
+*   States are referred to by their number (1 onwards), as in the text
+*   reports, and symbols, rules and items by the codes used there. The
+*   action is one of shift, reduce, goto or accept; shift and goto give
+*   the next state and reduce gives the rule. Accept has no parameter.
+*
+*   JSON: a single compact object (no whitespace) with the keys above.
+*
+*   Binary: the magic bytes "GLRX" and a version byte, then the fields
+*   from grammar onwards, in the order above and without keys. Numbers
+*   are unsigned LEB128 (seven bits per byte, least significant first,
+*   high bit set on all bytes but the last), strings are their length
+*   followed by their bytes, each list is its length followed by its
+*   elements, and the symbol type, state type and action are one byte
+*   each, numbered as their enumerations in "grammar.h". The accept
+*   action is followed by a 0.
+*
+*-----------------------------------------------------------------------
+*/
+
+/*
+*-----------------------------------------------------------------------
+*   LIBRARIES AND INCLUDE FILES
+*-----------------------------------------------------------------------
+*/
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+
+#include "error.h"
+#include "grammar.h"
+#include "export.h"
+
+/*
+*---------------------------------------------------------------------
+*
+*   INTERFACE (visible from other modules)
+*
+*---------------------------------------------------------------------
+*/
+
+/*                     */
+/* Function prototypes */
+/*                     */
+
+void export_automata (FILE *filePt, t_exportFormat exportFormat, const char *grammarFileName);
+
+/*
+*---------------------------------------------------------------------
+*
+*   IMPLEMENTATION (not visible from other modules)
+*
+*---------------------------------------------------------------------
+*/
+
+#define EXPORT_VERSION      1
+#define EXPORT_MAGIC        "GLRX"
+#define EXPORT_BUFFER_SIZE  (1 << 16)
+#define EXPORT_MAX_DEPTH    8      /* Deepest nesting is 4 (tables) */
+
+static FILE
+  *exportFilePt;
+
+static t_exportFormat
+  format;
+
+/* For JSON, whether the next value is the first one in each of the */
+/* objects and lists being written, to know when to put a comma     */
+
+static bool
+  b_firstInContainer [EXPORT_MAX_DEPTH];
+
+static int
+  depth;
+
+static const char
+  *symbolTypeNames[] = { "terminal", "nonTerminal", "epsilon", "endOfInput" },
+  *stateTypeNames[]  = { "nfaShift", "nfaReduce", "nfaNonDeterministic",
+                         "dfaShift", "dfa1Reduce", "dfaNReduce", "dfaShift1Reduce", "dfaShiftNReduce" },
+  *actionNames[]     = { "shift", "reduce", "goto", "accept", "error" };
+
+/*                       */
+/* Function declarations */
+/*                       */
+
+static void put_key       (const char *key);
+static void begin_object  (const char *key);
+static void end_object    (void);
+static void begin_list    (const char *key, unsigned int totElements);
+static void end_list      (void);
+static void put_uint      (const char *key, unsigned int value);
+static void put_string    (const char *key, const char *string);
+static void put_enum      (const char *key, const char *names[], unsigned int value);
+
+static void export_symbols      (void);
+static void export_rules        (void);
+static void export_items        (void);
+static void export_nfa          (void);
+static void export_dfa          (void);
+static void export_set          (const char *key, t_setType setType);
+static void export_parse_table  (const char *key, t_parse_table_type parse_table_type);
+
+/*
+*---------------------------------------------------------------------
+* Print a string as a quoted JSON string. Shared by the export, the
+* metrics file (-m) and the JSON profile (-p json).
+*---------------------------------------------------------------------
+*/
+
+void print_json_string (FILE *filePt, const char *string)
+{
+ const unsigned char
+   *p_char;
+
+ putc ('"', filePt);
+ for (p_char = (const unsigned char *) string; *p_char != '\0'; p_char++)
+   if ((*p_char == '"') || (*p_char == '\\')) {
+     putc ('\\', filePt);
+     putc (*p_char, filePt);
+   }
+   else if (*p_char < 0x20)
+     fprintf (filePt, "\\u%04x", *p_char);
+   else
+     putc (*p_char, filePt);
+ putc ('"', filePt);
+}
+
+/*
+*---------------------------------------------------------------------
+* Begin a value. In JSON, put the comma that separates it from the
+* previous one and, inside an object, its key. Keys are plain
+* identifiers, so they need no escaping.
+*---------------------------------------------------------------------
+*/
+
+static void put_key (const char *key)
+{
+ if (format != t_export_json)
+   return;
+ if (! b_firstInContainer[depth])
+   putc (',', exportFilePt);
+ b_firstInContainer[depth] = false;
+ if (key != NULL) {
+   putc ('"', exportFilePt);
+   fputs (key, exportFilePt);
+   fputs ("\":", exportFilePt);
+ }
+}
+
+/*
+*---------------------------------------------------------------------
+* Objects and lists. In binary an object is just its fields in order,
+* and a list is its number of elements followed by the elements.
+*---------------------------------------------------------------------
+*/
+
+static void begin_object (const char *key)
+{
+ put_key (key);
+ if (format == t_export_json) {
+   putc ('{', exportFilePt);
+   b_firstInContainer[++depth] = true;
+ }
+}
+
+static void end_object (void)
+{
+ if (format == t_export_json) {
+   putc ('}', exportFilePt);
+   depth--;
+ }
+}
+
+static void begin_list (const char *key, unsigned int totElements)
+{
+ put_key (key);
+ if (format == t_export_json) {
+   putc ('[', exportFilePt);
+   b_firstInContainer[++depth] = true;
+ }
+ else
+   put_uint (NULL, totElements);
+}
+
+static void end_list (void)
+{
+ if (format == t_export_json) {
+   putc (']', exportFilePt);
+   depth--;
+ }
+}
+
+/*
+*---------------------------------------------------------------------
+* Scalars. put_uint() writes decimal digits in JSON and an unsigned
+* LEB128 number in binary, where values below 128 take one byte.
+*---------------------------------------------------------------------
+*/
+
+static void put_uint (const char *key, unsigned int value)
+{
+ char
+   digits [16];
+ int
+   iDigit = 0;
+
+ put_key (key);
+ if (format == t_export_json) {
+   do {
+     digits[iDigit++] = (char) ('0' + value % 10);
+     value /= 10;
+   } while (value > 0);
+   while (iDigit > 0)
+     putc (digits[--iDigit], exportFilePt);
+ }
+ else {
+   while (value >= 0x80) {
+     putc ((int) ((value & 0x7F) | 0x80), exportFilePt);
+     value >>= 7;
+   }
+   putc ((int) value, exportFilePt);
+ }
+}
+
+static void put_string (const char *key, const char *string)
+{
+ put_key (key);
+ if (format == t_export_json) {
+   print_json_string (exportFilePt, string);
+ }
+ else {
+   put_uint (NULL, (unsigned int) strlen (string));
+   fputs (string, exportFilePt);
+ }
+}
+
+static void put_enum (const char *key, const char *names[], unsigned int value)
+{
+ if (format == t_export_json)
+   put_string (key, names[value]);
+ else
+   putc ((int) value, exportFilePt);
+}
+
+/*
+*---------------------------------------------------------------------
+* Grammar symbols: terminals (end-of-input among them), then
+* non-terminals
+*---------------------------------------------------------------------
+*/
+
+static void export_symbols (void)
+{
+ unsigned int
+   iSymbol;
+ t_symbolCode
+   symbolCode;
+
+ begin_list ("symbols", totTerminals + totNonTerminals);
+ for (iSymbol = 1; iSymbol <= totGrammarSymbols; iSymbol++) {
+   if (iSymbol <= totTerminals)
+     symbolCode = symbolNumber2symbolCode (iSymbol, t_terminal);
+   else
+     symbolCode = symbolNumber2symbolCode (iSymbol - totTerminals, t_nonTerminal);
+   begin_object (NULL);
+   put_uint   ("code", (unsigned int) symbolCode);
+   put_string ("name", symbolCode2symbolString (symbolCode));
+   put_enum   ("type", symbolTypeNames, (unsigned int) symbolCode2symbolType (symbolCode));
+   end_object ();
+ }
+ end_list ();
+ put_uint ("epsilon", (unsigned int) epsilon_code);
+}
+
+/*
+*---------------------------------------------------------------------
+* Grammar rules. An epsilon rule has an empty right hand side.
+*---------------------------------------------------------------------
+*/
+
+static void export_rules (void)
+{
+ t_ruleNumber
+   iRule;
+ unsigned int
+   iPos,
+   ruleSize;
+
+ begin_list ("rules", totRules);
+ for (iRule = 1; iRule <= totRules; iRule++) {
+   ruleSize = ruleNumber2ruleSize (iRule);
+   begin_object (NULL);
+   put_uint ("lhs", (unsigned int) rulePos2symbolCode (iRule, 0));
+   begin_list ("rhs", ruleSize);
+   for (iPos = 1; iPos <= ruleSize; iPos++)
+     put_uint (NULL, (unsigned int) rulePos2symbolCode (iRule, iPos));
+   end_list ();
+   end_object ();
+ }
+ end_list ();
+}
+
+/*
+*---------------------------------------------------------------------
+* LR(0) items
+*---------------------------------------------------------------------
+*/
+
+static void export_items (void)
+{
+ unsigned int
+   iItem;
+ t_itemCode
+   itemCode;
+
+ begin_list ("items", totLR0items);
+ for (iItem = 1; iItem <= totLR0items; iItem++) {
+   itemCode = itemNumber2itemCode (iItem);
+   begin_object (NULL);
+   put_uint ("code", (unsigned int) itemCode);
+   put_uint ("rule", itemCode2ruleNumber (itemCode));
+   put_uint ("dot",  itemCode2dotPosition (itemCode));
+   end_object ();
+ }
+ end_list ();
+}
+
+/*
+*---------------------------------------------------------------------
+* NFA states and transitions
+*---------------------------------------------------------------------
+*/
+
+static void export_nfa (void)
+{
+ unsigned int
+   iState,
+   iTransition;
+ t_stateCode
+   stateCode;
+
+ begin_object ("nfa");
+ begin_list ("states", totNFAstates);
+ for (iState = 1; iState <= totNFAstates; iState++) {
+   stateCode = nfa_stateNumber2stateCode (iState);
+   begin_object (NULL);
+   put_uint ("item", (unsigned int) nfa_stateCode2itemCode (stateCode));
+   put_enum ("type", stateTypeNames, (unsigned int) stateCode2stateType (stateCode));
+   end_object ();
+ }
+ end_list ();
+ begin_list ("transitions", totNFAtransitions);
+ for (iTransition = 1; iTransition <= totNFAtransitions; iTransition++) {
+   begin_object (NULL);
+   put_uint ("from",   nfa_stateCode2stateNumber (nfa_transitionNumber2originState (iTransition)));
+   put_uint ("symbol", (unsigned int) nfa_transitionNumber2symbol (iTransition));
+   put_uint ("to",     nfa_stateCode2stateNumber (nfa_transitionNumber2destState (iTransition)));
+   end_object ();
+ }
+ end_list ();
+ end_object ();
+}
+
+/*
+*---------------------------------------------------------------------
+* DFA states, each with its items, and transitions
+*---------------------------------------------------------------------
+*/
+
+static void export_dfa (void)
+{
+ unsigned int
+   iState,
+   iItem,
+   totItems,
+   iTransition;
+ t_stateCode
+   stateCode;
+
+ begin_object ("dfa");
+ begin_list ("states", totDFAstates);
+ for (iState = 1; iState <= totDFAstates; iState++) {
+   stateCode = dfa_stateNumber2stateCode (iState);
+   totItems = dfa_stateCode2totItems (stateCode);
+   begin_object (NULL);
+   put_enum ("type", stateTypeNames, (unsigned int) stateCode2stateType (stateCode));
+   begin_list ("items", totItems);
+   for (iItem = 1; iItem <= totItems; iItem++)
+     put_uint (NULL, (unsigned int) dfa_stateCode2itemCode (stateCode, iItem));
+   end_list ();
+   end_object ();
+ }
+ end_list ();
+ begin_list ("transitions", totDFAtransitions);
+ for (iTransition = 1; iTransition <= totDFAtransitions; iTransition++) {
+   begin_object (NULL);
+   put_uint ("from",   dfa_stateCode2stateNumber (dfa_transitionNumber2originState (iTransition)));
+   put_uint ("symbol", (unsigned int) dfa_transitionNumber2symbol (iTransition));
+   put_uint ("to",     dfa_stateCode2stateNumber (dfa_transitionNumber2destState (iTransition)));
+   end_object ();
+ }
+ end_list ();
+ end_object ();
+}
+
+/*
+*---------------------------------------------------------------------
+* FIRST sets of all grammar symbols, or FOLLOW sets of the
+* non-terminals
+*---------------------------------------------------------------------
+*/
+
+static void export_set (const char *key, t_setType setType)
+{
+ unsigned int
+   iSymbol,
+   firstSymbol,
+   iPosInSet,
+   symbolsInSet;
+ t_symbolCode
+   symbolCode;
+
+ firstSymbol = (setType == t_firstSet) ? 1 : totTerminals + 1;
+ begin_list (key, totGrammarSymbols - firstSymbol + 1);
+ for (iSymbol = firstSymbol; iSymbol <= totGrammarSymbols; iSymbol++) {
+   if (iSymbol <= totTerminals)
+     symbolCode = symbolNumber2symbolCode (iSymbol, t_terminal);
+   else
+     symbolCode = symbolNumber2symbolCode (iSymbol - totTerminals, t_nonTerminal);
+   symbolsInSet = setSize (setType, symbolCode);
+   begin_object (NULL);
+   put_uint ("symbol", (unsigned int) symbolCode);
+   begin_list ("set", symbolsInSet);
+   for (iPosInSet = 1; iPosInSet <= symbolsInSet; iPosInSet++)
+     put_uint (NULL, (unsigned int) getSymbolInSet (setType, symbolCode, iPosInSet));
+   end_list ();
+   end_object ();
+ }
+ end_list ();
+}
+
+/*
+*---------------------------------------------------------------------
+* A parse table, one list of actions per DFA state. As in the binary
+* parse table files, the augmented start symbol has no column.
+*---------------------------------------------------------------------
+*/
+
+static void export_parse_table (const char *key, t_parse_table_type parse_table_type)
+{
+ unsigned int
+   iState,
+   iSymbol,
+   iParseAction,
+   totParseActions,
+   actionsInCell;
+ t_stateCode
+   stateCode;
+ t_symbolCode
+   symbolCode;
+ t_parseAction
+   parseAction;
+
+ begin_list (key, totDFAstates);
+ for (iState = 1; iState <= totDFAstates; iState++) {
+   stateCode = dfa_stateNumber2stateCode (iState);
+
+   totParseActions = 0;
+   for (iSymbol = 1; iSymbol <= totGrammarSymbols; iSymbol++) {
+     if (iSymbol == totTerminals + 1)
+       continue;
+     if (iSymbol <= totTerminals)
+       symbolCode = symbolNumber2symbolCode (iSymbol, t_terminal);
+     else
+       symbolCode = symbolNumber2symbolCode (iSymbol - totTerminals, t_nonTerminal);
+     totParseActions += parseTablePos2totParseActions (parse_table_type, stateCode, symbolCode);
+   }
+
+   begin_list (NULL, totParseActions);
+   for (iSymbol = 1; iSymbol <= totGrammarSymbols; iSymbol++) {
+     if (iSymbol == totTerminals + 1)
+       continue;
+     if (iSymbol <= totTerminals)
+       symbolCode = symbolNumber2symbolCode (iSymbol, t_terminal);
+     else
+       symbolCode = symbolNumber2symbolCode (iSymbol - totTerminals, t_nonTerminal);
+     actionsInCell = parseTablePos2totParseActions (parse_table_type, stateCode, symbolCode);
+     for (iParseAction = 1; iParseAction <= actionsInCell; iParseAction++) {
+       parseAction = parseTablePos2parseAction (parse_table_type, stateCode, symbolCode, iParseAction);
+       begin_object (NULL);
+       put_uint ("symbol", (unsigned int) symbolCode);
+       put_enum ("action", actionNames, (unsigned int) parseAction.parseActionType);
+       switch (parseAction.parseActionType) {
+         case (t_shift):
+         case (t_goto):
+           put_uint ("state", dfa_stateCode2stateNumber (parseAction.parseActionParam.nextState));
+           break;
+         case (t_reduce):
+           put_uint ("rule", parseAction.parseActionParam.reductionRule);
+           break;
+         default:
+           if (format == t_export_binary)
+             put_uint (NULL, 0);
+           break;
+       }
+       end_object ();
+     }
+   }
+   end_list ();
+ }
+ end_list ();
+}
+
+/*
+*---------------------------------------------------------------------
+* Export the grammar, the automata, the sets and both parse tables
+*---------------------------------------------------------------------
+*/
+
+void export_automata (FILE *filePt, t_exportFormat exportFormat, const char *grammarFileName)
+{
+ exportFilePt = filePt;
+ format = exportFormat;
+ depth = 0;
+ b_firstInContainer[0] = true;
+
+ /* Nothing has been written to the file yet, so it can still be given */
+ /* a buffer large enough to keep the number of write() calls small    */
+
+ setvbuf (exportFilePt, NULL, _IOFBF, EXPORT_BUFFER_SIZE);
+
+ if (format == t_export_binary) {
+   fputs (EXPORT_MAGIC, exportFilePt);
+   putc (EXPORT_VERSION, exportFilePt);
+ }
+ else {
+   begin_object (NULL);
+   put_string ("format",  "geraLR");
+   put_uint   ("version", EXPORT_VERSION);
+ }
+ put_string ("grammar", grammarFileName);
+
+ export_symbols ();
+ export_rules ();
+ export_items ();
+ export_nfa ();
+ export_dfa ();
+ export_set ("first",  t_firstSet);
+ export_set ("follow", t_followSet);
+ export_parse_table ("lr0",  t_LR0_parse_table);
+ export_parse_table ("slr1", t_sLR1_parse_table);
+
+ if (format == t_export_json) {
+   end_object ();
+   putc ('\n', exportFilePt);
+ }
+
+ errno = 0;
+ if ((fflush (exportFilePt) != 0) || ferror (exportFilePt))
+   ERROR_fatal_error (errno, __FILE__, __func__, "Cannot write the export file");
+}
@@ -0,0 +1,61 @@
+/*
+*-----------------------------------------------------------------------
+*
+*   File         : export.h
+*   Created      : 2026-10-19
+*   Last Modified: 2026-10-19
+*
+*   DESCRIPTION:
+*   Machine-readable export of the grammar, its LR(0) items, the NFA
+*   and DFA, the FIRST and FOLLOW sets and the LR(0) and sLR(1) parse
+*   tables, as compact JSON or in a compact binary encoding
+*
+*-----------------------------------------------------------------------
+*/
+
+/*                                           */
+/* Make sure this file is not included twice */
+/*                                           */
+
+#ifndef _EXPORT_DOT_H_
+#define _EXPORT_DOT_H_
+
+/*
+*---------------------------------------------------------------------
+*   INCLUDE FILES
+*---------------------------------------------------------------------
+*/
+
+#include <stdio.h>
+
+/*
+*---------------------------------------------------------------------
+*   Type definitions
+*---------------------------------------------------------------------
+*/
+
+typedef enum {
+  t_export_json,
+  t_export_binary
+}
+  t_exportFormat;
+
+/*
+*---------------------------------------------------------------------
+* Function prototypes
+*---------------------------------------------------------------------
+*/
+
+/* export_automata() writes everything in one pass over the data     */
+/* structures, once the DFA, the FIRST and FOLLOW sets and both parse */
+/* tables have been built. The layout of both formats is described at */
+/* the top of "export.c".                                             */
+
+extern void export_automata (FILE *filePt, t_exportFormat exportFormat, const char *grammarFileName);
+
+/* print_json_string() writes a string as a quoted JSON string, with */
+/* '"', '\' and control characters escaped                           */
+
+extern void print_json_string (FILE *filePt, const char *string);
+
+#endif /* ifndef _EXPORT_DOT_H_ */
@@ -0,0 +1,536 @@
+/*
+*-----------------------------------------------------------------------
+*
+*   File         : geraGram.c
+*   Created      : 2026-10-19
+*   Last Modified: 2026-10-19
+*
+*   DESCRIPTION:
+*
+*   This program writes a random context free grammar in the format
+*   read by geraLR. The number of terminals, non-terminals and rules,
+*   the righthand side lengths, and the number of epsilon, left
+*   recursive and right recursive rules are all under control of the
+*   command line, and the same seed always yields the same grammar,
+*   so the output is suitable for scalability benchmarks of geraLR.
+*
+*   Every generated grammar is reduced: every non-terminal is reachable
+*   from the start symbol and derives at least one terminal string.
+*   Grammars are kept within the limits set in "grammar.h".
+*
+*   USAGE:
+*   geraGram -h for help
+*
+*-----------------------------------------------------------------------
+*/
+
+/*
+*-----------------------------------------------------------------------
+* INCLUDE FILES
+*-----------------------------------------------------------------------
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "common.h"
+#include "error.h"
+#include "commline.h"
+#include "random.h"
+#include "grammar.h"
+
+/*
+*-----------------------------------------------------------------------
+* IMPLEMENTATION (invisible from other modules)
+*-----------------------------------------------------------------------
+*/
+
+#define VERSION  "1.0"
+
+#define DEFAULT_TOT_TERMINALS         10
+#define DEFAULT_TOT_NON_TERMINALS     5
+#define DEFAULT_TOT_RULES             20
+#define DEFAULT_MIN_RIGHTHAND_SIZE    1
+#define DEFAULT_MAX_RIGHTHAND_SIZE    5
+#define DEFAULT_SEED                  5489UL  /* The MT19937 reference seed */
+
+#define MAX_DUPLICATE_RULE_RETRIES    100
+
+/* Symbols in a generated rule: non-terminals are positive, terminals negative */
+
+typedef struct {
+  unsigned int lefthand;
+  unsigned int righthandSize;
+  int          righthand [MAX_SYMBOLS_EACH_RIGHTHAND];
+}
+  t_genRule;
+
+static char
+  *progName       = NULL,
+  *outputFileName = NULL;
+
+static FILE
+  *outputFilePt = NULL;
+
+static unsigned long int
+  genTerminals           = DEFAULT_TOT_TERMINALS,
+  genNonTerminals        = DEFAULT_TOT_NON_TERMINALS,
+  genRules               = DEFAULT_TOT_RULES,
+  minRighthandSize       = DEFAULT_MIN_RIGHTHAND_SIZE,
+  maxRighthandSize       = DEFAULT_MAX_RIGHTHAND_SIZE,
+  genEpsilonRules        = 0,
+  genLeftRecursiveRules  = 0,
+  genRightRecursiveRules = 0,
+  seed                   = DEFAULT_SEED;
+
+static t_genRule
+  rules [MAX_RULES + 1];
+
+static unsigned int
+  totGeneratedRules = 0;
+
+/*
+*---------------------------------------------------------------------
+* Function prototypes
+*---------------------------------------------------------------------
+*/
+
+int  main (int argc, char *argv[]);
+
+static void          process_commLine     (int argc, char *argv[]);
+static unsigned int  random_range         (unsigned int min, unsigned int max);
+static int           random_symbol        (void);
+static bool          is_duplicate_rule    (const t_genRule *p_rule);
+static void          add_generated_rule   (t_genRule *p_rule);
+static void          generate_base_rules  (void);
+static void          generate_extra_rules (void);
+static void          print_grammar        (int argc, char *argv[]);
+
+/* To prevent "implicit declaration" warnings */
+
+int snprintf (char *str, size_t size, const char *format, ...);
+
+/*
+*---------------------------------------------------------------------
+* Process options and arguments in the command line
+*---------------------------------------------------------------------
+*/
+
+typedef enum {
+  commLineOpt_help = 0,
+  commLineOpt_usage,
+  commLineOpt_terminals,
+  commLineOpt_nonterminals,
+  commLineOpt_rules,
+  commLineOpt_minsize,
+  commLineOpt_maxsize,
+  commLineOpt_epsilon,
+  commLineOpt_leftrec,
+  commLineOpt_rightrec,
+  commLineOpt_seed
+}
+t_commLineOpts;
+
+int
+  commLine_totOptions = (int) commLineOpt_seed + 1;
+
+static void process_commLine (int argc, char *argv[])
+{
+ bool
+   commLineOK;
+ int
+   optUses;
+
+ /* If there was an error in the command line */
+ /* then display program usage info and abort */
+
+ progName = COMMLINE_get_program_short_name (argv[0]);
+ commLineOK = COMMLINE_parse_commLine (argc, argv,
+   commLine_totOptions,
+      commLineOpt_help,         'h', "help",         COMMLINE_opt_arg_none,      0, COMMLINE_OPT_FREE_USE, 0,
+      commLineOpt_usage,        'u', "usage",        COMMLINE_opt_arg_none,      0, COMMLINE_OPT_FREE_USE, 0,
+      commLineOpt_terminals,    't', "terminals",    COMMLINE_opt_arg_ulong_int, 0, 1,            0,
+      commLineOpt_nonterminals, 'n', "nonterminals", COMMLINE_opt_arg_ulong_int, 0, 1,            0,
+      commLineOpt_rules,        'r', "rules",        COMMLINE_opt_arg_ulong_int, 0, 1,            0,
+      commLineOpt_minsize,      'm', "minsize",      COMMLINE_opt_arg_ulong_int, 0, 1,            0,
+      commLineOpt_maxsize,      'M', "maxsize",      COMMLINE_opt_arg_ulong_int, 0, 1,            0,
+      commLineOpt_epsilon,      'e', "epsilon",      COMMLINE_opt_arg_ulong_int, 0, 1,            0,
+      commLineOpt_leftrec,      'L', "leftrec",      COMMLINE_opt_arg_ulong_int, 0, 1,            0,
+      commLineOpt_rightrec,     'R', "rightrec",     COMMLINE_opt_arg_ulong_int, 0, 1,            0,
+      commLineOpt_seed,         's', "seed",         COMMLINE_opt_arg_ulong_int, 0, 1,            0,
+   1,
+      COMMLINE_opt_arg_string );
+
+ if (! commLineOK) {
+   COMMLINE_display_usage();
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ }
+
+ /* If the user asked for help then provide it and exit */
+
+ if (! COMMLINE_optId2optUses (commLineOpt_help, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ if (optUses > 0) {
+   printf("\n");
+   printf("This program writes a random context free grammar, in the\n");
+   printf("format read by geraLR, for scalability benchmarks.\n");
+   printf("Usage:\n");
+   printf("\n");
+   printf("%s grammar_file [options]\n", progName);
+   printf("\n");
+   printf("+---------------------------------------------------------------------------+\n");
+   printf("| Option     Purpose                                                Default |\n");
+   printf("+---------------------------------------------------------------------------+\n");
+   printf("| -h         Display this help message                                      |\n");
+   printf("| -u         Display details on command line options                        |\n");
+   printf("| -t N       Number of terminals (not counting $)                        10 |\n");
+   printf("| -n N       Number of non-terminals (not counting E')                    5 |\n");
+   printf("| -r N       Number of rules, epsilon and recursive rules included       20 |\n");
+   printf("| -m N       Minimum righthand side size of non-epsilon rules             1 |\n");
+   printf("| -M N       Maximum righthand side size                                  5 |\n");
+   printf("| -e N       Number of epsilon rules (at most one per non-terminal)       0 |\n");
+   printf("| -L N       Number of left recursive rules (A -> A ...)                  0 |\n");
+   printf("| -R N       Number of right recursive rules (A -> ... A)                 0 |\n");
+   printf("| -s N       Seed for the random number generator                      5489 |\n");
+   printf("+---------------------------------------------------------------------------+\n");
+   printf(" \n");
+   exit (EXIT_SUCCESS);
+ }
+
+ /* If the user asked for program usage info then provide it and exit */
+
+ if (! COMMLINE_optId2optUses (commLineOpt_usage, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ if (optUses > 0) {
+   COMMLINE_display_usage();
+   exit (EXIT_SUCCESS);
+ }
+
+ /* Grammar size and shape */
+
+ if (! COMMLINE_optId2optUses (commLineOpt_terminals, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ if ((optUses > 0) && ! COMMLINE_optUse2optArg (commLineOpt_terminals, 1, &genTerminals))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+
+ if (! COMMLINE_optId2optUses (commLineOpt_nonterminals, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ if ((optUses > 0) && ! COMMLINE_optUse2optArg (commLineOpt_nonterminals, 1, &genNonTerminals))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+
+ if (! COMMLINE_optId2optUses (commLineOpt_rules, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ if ((optUses > 0) && ! COMMLINE_optUse2optArg (commLineOpt_rules, 1, &genRules))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+
+ if (! COMMLINE_optId2optUses (commLineOpt_minsize, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ if ((optUses > 0) && ! COMMLINE_optUse2optArg (commLineOpt_minsize, 1, &minRighthandSize))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+
+ if (! COMMLINE_optId2optUses (commLineOpt_maxsize, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ if ((optUses > 0) && ! COMMLINE_optUse2optArg (commLineOpt_maxsize, 1, &maxRighthandSize))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+
+ if (! COMMLINE_optId2optUses (commLineOpt_epsilon, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ if ((optUses > 0) && ! COMMLINE_optUse2optArg (commLineOpt_epsilon, 1, &genEpsilonRules))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+
+ if (! COMMLINE_optId2optUses (commLineOpt_leftrec, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ if ((optUses > 0) && ! COMMLINE_optUse2optArg (commLineOpt_leftrec, 1, &genLeftRecursiveRules))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+
+ if (! COMMLINE_optId2optUses (commLineOpt_rightrec, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ if ((optUses > 0) && ! COMMLINE_optUse2optArg (commLineOpt_rightrec, 1, &genRightRecursiveRules))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+
+ if (! COMMLINE_optId2optUses (commLineOpt_seed, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ if ((optUses > 0) && ! COMMLINE_optUse2optArg (commLineOpt_seed, 1, &seed))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+
+ /* The grammar must be one that geraLR can read */
+
+ if ((genTerminals < 1) || (genTerminals > MAX_TERMINALS - 1)) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Number of terminals must be between 1 and %d", MAX_TERMINALS - 1);
+   ERROR_short_fatal_error (ERROR_auxErrorMsg);
+ }
+ if ((genNonTerminals < 1) || (genNonTerminals > MAX_NON_TERMINALS - 1)) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Number of non-terminals must be between 1 and %d", MAX_NON_TERMINALS - 1);
+   ERROR_short_fatal_error (ERROR_auxErrorMsg);
+ }
+ if ((minRighthandSize < 1) || (minRighthandSize > maxRighthandSize) || (maxRighthandSize > MAX_SYMBOLS_EACH_RIGHTHAND)) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Righthand side sizes must satisfy 1 <= min <= max <= %d", MAX_SYMBOLS_EACH_RIGHTHAND);
+   ERROR_short_fatal_error (ERROR_auxErrorMsg);
+ }
+ if (genEpsilonRules > genNonTerminals)
+   ERROR_short_fatal_error ("There can be no more epsilon rules than non-terminals");
+ if ((genLeftRecursiveRules + genRightRecursiveRules > 0) && (maxRighthandSize < 2))
+   ERROR_short_fatal_error ("Recursive rules need a maximum righthand side size of at least 2");
+ if ((genRules < genNonTerminals + genEpsilonRules + genLeftRecursiveRules + genRightRecursiveRules) || (genRules > MAX_RULES - 1)) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Number of rules must be between %lu (one per non-terminal plus the epsilon and recursive ones) and %d",
+             genNonTerminals + genEpsilonRules + genLeftRecursiveRules + genRightRecursiveRules, MAX_RULES - 1);
+   ERROR_short_fatal_error (ERROR_auxErrorMsg);
+ }
+
+ /* Output file */
+
+ if (! COMMLINE_argPos2argVal (1, &outputFileName))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ errno = 0;
+ if ((outputFilePt = fopen (outputFileName, "w")) == NULL) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Cannot open \"%s\" for writing", outputFileName);
+   ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
+ }
+
+ COMMLINE_free_commLine_data();
+}
+
+/*
+*---------------------------------------------------------------------
+* Return a random integer in the range [min, max]
+*---------------------------------------------------------------------
+*/
+
+static unsigned int random_range (unsigned int min, unsigned int max)
+{
+ return (min + (unsigned int) (RANDOM_genrand_int32 () % (unsigned long int) (max - min + 1)));
+}
+
+/*
+*---------------------------------------------------------------------
+* Return a random grammar symbol: terminal or non-terminal with the
+* same probability, then any symbol of that kind
+*---------------------------------------------------------------------
+*/
+
+static int random_symbol (void)
+{
+ if (RANDOM_genrand_int32 () & 1)
+   return ((int) random_range (1, (unsigned int) genNonTerminals));
+ return (- (int) random_range (1, (unsigned int) genTerminals));
+}
+
+/*
+*---------------------------------------------------------------------
+* Check whether an identical rule has already been generated
+*---------------------------------------------------------------------
+*/
+
+static bool is_duplicate_rule (const t_genRule *p_rule)
+{
+ unsigned int
+   iRule;
+
+ for (iRule = 1; iRule <= totGeneratedRules; iRule++)
+   if ((rules[iRule].lefthand == p_rule->lefthand) &&
+       (rules[iRule].righthandSize == p_rule->righthandSize) &&
+       (memcmp (rules[iRule].righthand, p_rule->righthand, p_rule->righthandSize * sizeof (int)) == 0))
+     return (true);
+ return (false);
+}
+
+/*
+*---------------------------------------------------------------------
+* Append a rule to the generated grammar
+*---------------------------------------------------------------------
+*/
+
+static void add_generated_rule (t_genRule *p_rule)
+{
+ if (totGeneratedRules >= MAX_RULES) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Too many rules (max = %d)", MAX_RULES);
+   ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+ }
+ rules[++totGeneratedRules] = *p_rule;
+}
+
+/*
+*---------------------------------------------------------------------
+* Generate one rule for each non-terminal, so that the grammar is
+* reduced no matter what other rules are added later:
+* - each non-terminal but the first gets a parent among the ones
+*   before it, and appears in the parent's rule (reachability);
+* - these rules use only terminals and later non-terminals, so the
+*   last non-terminal derives a terminal string, and by induction so
+*   do all the others (productivity).
+*---------------------------------------------------------------------
+*/
+
+static void generate_base_rules (void)
+{
+ unsigned int
+   iSymbol,
+   iPos,
+   parent,
+   totChildren [MAX_NON_TERMINALS + 1],
+   parentOf    [MAX_NON_TERMINALS + 1];
+ t_genRule
+   rule;
+
+ for (iSymbol = 1; iSymbol <= genNonTerminals; iSymbol++)
+   totChildren[iSymbol] = 0;
+ for (iSymbol = 2; iSymbol <= genNonTerminals; iSymbol++) {
+   parent = random_range (1, iSymbol - 1);
+   if (totChildren[parent] >= maxRighthandSize)
+     parent = iSymbol - 1;   /* It has no children yet */
+   parentOf[iSymbol] = parent;
+   totChildren[parent]++;
+ }
+
+ for (iSymbol = 1; iSymbol <= genNonTerminals; iSymbol++) {
+   rule.lefthand = iSymbol;
+   rule.righthandSize = random_range ((unsigned int) minRighthandSize, (unsigned int) maxRighthandSize);
+   rule.righthandSize = GREATEST (rule.righthandSize, totChildren[iSymbol]);
+   for (iPos = 0; iPos < rule.righthandSize; iPos++)
+     rule.righthand[iPos] = - (int) random_range (1, (unsigned int) genTerminals);
+
+   /* Children go to distinct random positions, in increasing order */
+
+   for (parent = iSymbol + 1, iPos = 0; parent <= genNonTerminals; parent++) {
+     if (parentOf[parent] != iSymbol)
+       continue;
+     iPos = random_range (iPos, rule.righthandSize - totChildren[iSymbol]);
+     rule.righthand[iPos++] = (int) parent;
+     totChildren[iSymbol]--;
+   }
+   add_generated_rule (&rule);
+ }
+}
+
+/*
+*---------------------------------------------------------------------
+* Generate the epsilon, left recursive, right recursive and plain rules
+*---------------------------------------------------------------------
+*/
+
+static void generate_extra_rules (void)
+{
+ unsigned int
+   iRule,
+   iPos,
+   iRetry,
+   iSymbol,
+   swap,
+   permutation [MAX_NON_TERMINALS + 1];
+ t_genRule
+   rule;
+
+ /* Epsilon rules go to distinct non-terminals, since geraLR */
+ /* accepts no more than one epsilon rule for each symbol    */
+
+ for (iSymbol = 1; iSymbol <= genNonTerminals; iSymbol++)
+   permutation[iSymbol] = iSymbol;
+ for (iSymbol = (unsigned int) genNonTerminals; iSymbol > 1; iSymbol--) {
+   iPos = random_range (1, iSymbol);
+   swap = permutation[iSymbol];
+   permutation[iSymbol] = permutation[iPos];
+   permutation[iPos] = swap;
+ }
+ for (iRule = 1; iRule <= genEpsilonRules; iRule++) {
+   rule.lefthand = permutation[iRule];
+   rule.righthandSize = 0;
+   add_generated_rule (&rule);
+ }
+
+ /* Recursive and plain rules, avoiding exact duplicates */
+
+ for (iRule = 1; iRule <= genRules - genNonTerminals - genEpsilonRules; iRule++) {
+   for (iRetry = 0; iRetry < MAX_DUPLICATE_RULE_RETRIES; iRetry++) {
+     rule.lefthand = random_range (1, (unsigned int) genNonTerminals);
+     if (iRule <= genLeftRecursiveRules + genRightRecursiveRules)
+       rule.righthandSize = random_range ((unsigned int) GREATEST (minRighthandSize, 2), (unsigned int) maxRighthandSize);
+     else
+       rule.righthandSize = random_range ((unsigned int) minRighthandSize, (unsigned int) maxRighthandSize);
+     for (iPos = 0; iPos < rule.righthandSize; iPos++)
+       rule.righthand[iPos] = random_symbol ();
+     if (iRule <= genLeftRecursiveRules)
+       rule.righthand[0] = (int) rule.lefthand;
+     else if (iRule <= genLeftRecursiveRules + genRightRecursiveRules)
+       rule.righthand[rule.righthandSize - 1] = (int) rule.lefthand;
+     if (! is_duplicate_rule (&rule))
+       break;
+   }
+   add_generated_rule (&rule);
+ }
+}
+
+/*
+*---------------------------------------------------------------------
+* Print the grammar, rules grouped by lefthand side
+*---------------------------------------------------------------------
+*/
+
+static void print_grammar (int argc, char *argv[])
+{
+ unsigned int
+   iSymbol,
+   iRule,
+   iPos,
+   totAlternatives;
+ int
+   iArg;
+
+ fprintf (outputFilePt, "/*\n");
+ fprintf (outputFilePt, " * Random grammar written by %s v.%s\n", progName, VERSION);
+ fprintf (outputFilePt, " *\n");
+ fprintf (outputFilePt, " * Command line:");
+ for (iArg = 0; iArg < argc; iArg++)
+   fprintf (outputFilePt, " %s", argv[iArg]);
+ fprintf (outputFilePt, "\n *\n");
+ fprintf (outputFilePt, " * Terminals      : %lu\n", genTerminals);
+ fprintf (outputFilePt, " * Non-terminals  : %lu\n", genNonTerminals);
+ fprintf (outputFilePt, " * Rules          : %lu\n", genRules);
+ fprintf (outputFilePt, " * Righthand sizes: %lu to %lu\n", minRighthandSize, maxRighthandSize);
+ fprintf (outputFilePt, " * Epsilon rules  : %lu\n", genEpsilonRules);
+ fprintf (outputFilePt, " * Left recursive : %lu\n", genLeftRecursiveRules);
+ fprintf (outputFilePt, " * Right recursive: %lu\n", genRightRecursiveRules);
+ fprintf (outputFilePt, " * Seed           : %lu\n", seed);
+ fprintf (outputFilePt, " */\n\n");
+
+ for (iSymbol = 1; iSymbol <= genNonTerminals; iSymbol++) {
+   totAlternatives = 0;
+   for (iRule = 1; iRule <= totGeneratedRules; iRule++) {
+     if (rules[iRule].lefthand != iSymbol)
+       continue;
+     if (totAlternatives++ == 0)
+       fprintf (outputFilePt, "N%u ->", iSymbol);
+     else
+       fprintf (outputFilePt, "\n   |");
+     for (iPos = 0; iPos < rules[iRule].righthandSize; iPos++)
+       if (rules[iRule].righthand[iPos] > 0)
+         fprintf (outputFilePt, " N%d", rules[iRule].righthand[iPos]);
+       else
+         fprintf (outputFilePt, " 't%d'", - rules[iRule].righthand[iPos]);
+   }
+   fprintf (outputFilePt, " ;\n\n");
+ }
+}
+
+/*
+*-----------------------------------------------------------------------
+* Main program
+*-----------------------------------------------------------------------
+*/
+
+int main (int argc, char *argv[])
+{
+ process_commLine (argc, argv);
+ RANDOM_init_genrand (seed);
+ generate_base_rules ();
+ generate_extra_rules ();
+ print_grammar (argc, argv);
+ errno = 0;
+ if (fclose (outputFilePt) != 0) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Cannot close \"%s\"", outputFileName);
+   ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
+ }
+ free (outputFileName);
+ return (EXIT_SUCCESS);
+}
@@ -24,21 +24,31 @@
 *-----------------------------------------------------------------------
 */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <malloc.h>
+#include <sys/stat.h>
 
 #include "common.h"
 #include "datastructs.h"
 #include "error.h"
 #include "mystrings.h"
+#include "mytime.h"
 #include "report.h"
 #include "lexan.h"
 #include "commline.h"
 #include "grammar.h"
 #include "diagrams.h"
 #include "geraLR.h"
+#include "parsergen.h"
+#include "subsetdfa.h"
+#include "conflicts.h"
+#include "server.h"
+#include "watch.h"
+#include "export.h"
 
 /*
 *-----------------------------------------------------------------------
@@ -66,9 +76,13 @@ char
   setsFileName            [FILE_NAME_SIZE] = "",
   lr0binaryTableFileName  [FILE_NAME_SIZE] = "",
   slr1binaryTableFileName [FILE_NAME_SIZE] = "",
+  slr1ParserCodeFileName  [FILE_NAME_SIZE] = "",
   textTablesFileName      [FILE_NAME_SIZE] = "",
   answerSheetFileName     [FILE_NAME_SIZE] = "",
-  oneOutputFileName       [FILE_NAME_SIZE] = "";
+  oneOutputFileName       [FILE_NAME_SIZE] = "",
+  metricsFileName         [FILE_NAME_SIZE] = "",
+  exportFileName          [FILE_NAME_SIZE] = "",
+  grammarBinaryFileName   [FILE_NAME_SIZE] = "";
 
 /*              */
 /* File handles */
@@ -88,10 +102,23 @@ FILE
   *setsFilePt            = NULL,
   *lr0binaryTableFilePt  = NULL,
   *slr1binaryTableFilePt = NULL,
+  *slr1ParserCodeFilePt  = NULL,
   *textTablesFilePt      = NULL,
   *answerSheetFilePt     = NULL,
+  *metricsFilePt         = NULL,
+  *exportFilePt          = NULL,
   *outputFilePt          = NULL;
 
+/* DOT sources of the diagrams, written through nfaDotFilePt */
+/* and dfaDotFilePt, which are memory streams                 */
+
+char
+  *nfaDotText = NULL,
+  *dfaDotText = NULL;
+size_t
+  nfaDotTextSize = 0,
+  dfaDotTextSize = 0;
+
 bool
   b_one_output_file = false,
   b_output_started  = false;
@@ -163,6 +190,7 @@ static bool
   b_print_nfa_svg           = false,
   b_print_dfa_text          = false,
   b_print_dfa_svg           = false,
+  b_write_dot_files         = false,
   b_automatic_animation     = false, 
   b_set_cfg_file            = false,
   b_print_sets              = false,
@@ -171,11 +199,90 @@ static bool
   b_print_text_sLR1_table   = false,
   b_write_binary_LR0_table  = false,
   b_write_binary_sLR1_table = false,
+  b_write_slr1_parser_code  = false,
+  b_write_metrics           = false,
+  b_export                  = false,
+  b_check_subset_dfa        = false,
+  b_regex_scanner           = false,
+  b_grammar_binary          = false,
+  b_report_conflicts        = false,
+  b_reduce_grammar          = false,
+  b_renumber_states         = false,
+  b_bypass_unit_rules       = false,
+  b_serve                   = false,
+  b_watch                   = false,
   b_print_symbol_codes      = false;
 
 static int
   parse_table_symbol_width;
 
+/* Machine-readable export (set with command line -J) */
+
+#define EXPORT_FORMAT_JSON    "json"
+#define EXPORT_FORMAT_BINARY  "binary"
+
+static t_exportFormat
+  exportFormat = t_export_json;
+
+/* In server mode: the socket to listen on, and the configuration file */
+/* whose SVG attributes the server has already read for every request, */
+/* with its modification time and size then, to notice later edits    */
+
+static char
+  serverSocketName    [FILE_NAME_SIZE] = "",
+  loadedConfigFileName[FILE_NAME_SIZE] = "";
+static struct stat
+  loadedConfigStat;
+
+/* In watch mode: the command line, which each new build parses again */
+
+static int
+  watchArgc = 0;
+static char
+  **watchArgv = NULL;
+
+/*                                                      */
+/* Pipeline phase profiling (set with command line -p)  */
+/*                                                      */
+
+#define MAX_PROFILE_PHASES       40
+#define PROFILE_FORMAT_TABLE     "table"
+#define PROFILE_FORMAT_JSON      "json"
+
+/* Runs a statement as a named phase, timing it when profiling is on */
+
+#define PROFILE_PHASE(phaseName, statement) \
+  do { profile_start_phase (); statement; profile_stop_phase (phaseName); } while (0)
+
+typedef enum {
+  t_profile_none = 0,
+  t_profile_table,
+  t_profile_json
+}
+  t_profile_format;
+
+typedef struct {
+  const char
+    *name;
+  TIME_t_seconds
+    wall,
+    cpu;
+}
+  t_profile_phase;
+
+static t_profile_format
+  profileFormat = t_profile_none;
+
+static TIME_t_stopwatch
+  profilePhaseWatch,
+  profileTotalWatch;
+
+static t_profile_phase
+  profilePhases [MAX_PROFILE_PHASES];
+
+static int
+  totProfilePhases = 0;
+
 /*
 *---------------------------------------------------------------------
 * Function prototypes
@@ -183,7 +290,21 @@ static int
 */
 
 int       main                                 (int argc, char *argv[]);
+int       run_geraLR                           (int argc, char *argv[]);
+void      run_request                          (int argc, char *argv[]);
+void      build_automata                       (int argc, char *argv[]);
+int       write_outputs                        (int argc, char *argv[]);
+void      print_nfa_diagrams                   (void);
+void      print_dfa_diagrams                   (void);
+int       watch_geraLR                         (int argc, char *argv[]);
+void      watch_build_stage                    (void);
+void      watch_write_stage                    (void);
+void      watch_refresh_stage                  (void);
 void      process_commLine                     (int argc, char *argv[]);
+void      open_output_files                    (void);
+void      open_dot_files                       (void);
+bool      is_loaded_config_current             (void);
+void      write_dot_file                       (const char *dotFileName, const char *dotText, size_t dotTextSize);
 void      print_grammar_data                   (int argc, char *argv[]);
 void      print_grammar_symbols                (int argc, char *argv[]);
 void      print_sets                           (int argc, char *argv[]);
@@ -207,6 +328,11 @@ void write_parse_action_to_parse_table_bin_file (
   t_stateCode         stateCode,
   t_symbolCode        symbolCode,
   t_parseAction       parseAction );
+void      profile_start                        (void);
+void      profile_start_phase                  (void);
+void      profile_stop_phase                   (const char *phaseName);
+void      print_profile                        (void);
+void      write_metrics_file                   (void);
 
 /*
 *---------------------------------------------------------------------
@@ -232,13 +358,27 @@ typedef enum {
   commLineOpt_slrtxt,
   commLineOpt_lrbin,
   commLineOpt_slrbin,
+  commLineOpt_slrcode,
   commLineOpt_codes,
-  commLineOpt_symbolwidth
+  commLineOpt_symbolwidth,
+  commLineOpt_profile,
+  commLineOpt_metrics,
+  commLineOpt_subsetdfa,
+  commLineOpt_regexscan,
+  commLineOpt_grb,
+  commLineOpt_conflicts,
+  commLineOpt_reduce,
+  commLineOpt_renumber,
+  commLineOpt_unitrules,
+  commLineOpt_serve,
+  commLineOpt_watch,
+  commLineOpt_export,
+  commLineOpt_dotfile
 }
 t_commLineOpts;
 
 int
-  commLine_totOptions = (int) commLineOpt_symbolwidth + 1;
+  commLine_totOptions = (int) commLineOpt_dotfile + 1;
 
 void process_commLine (int argc, char *argv[])
 {
@@ -274,8 +414,22 @@ void process_commLine (int argc, char *argv[])
       commLineOpt_slrtxt,      's', "slrtxt",      COMMLINE_opt_arg_none,     0, 1,            0,
       commLineOpt_lrbin,       'L', "lrbin",       COMMLINE_opt_arg_none,     0, 1,            0,
       commLineOpt_slrbin,      'S', "slrbin",      COMMLINE_opt_arg_none,     0, 1,            0,
+      commLineOpt_slrcode,     'P', "slrcode",     COMMLINE_opt_arg_none,     0, 1,            0,
       commLineOpt_codes,       'c', "codes",       COMMLINE_opt_arg_none,     0, 1,            0,
       commLineOpt_symbolwidth, 'w', "symbolwidth", COMMLINE_opt_arg_long_int, 0, 1,            0,
+      commLineOpt_profile,     'p', "profile",     COMMLINE_opt_arg_string,   0, 1,            0,
+      commLineOpt_metrics,     'm', "metrics",     COMMLINE_opt_arg_none,     0, 1,            0,
+      commLineOpt_subsetdfa,   'X', "subsetdfa",   COMMLINE_opt_arg_none,     0, 1,            0,
+      commLineOpt_regexscan,   'g', "regexscan",   COMMLINE_opt_arg_none,     0, 1,            0,
+      commLineOpt_grb,         'b', "grb",         COMMLINE_opt_arg_none,     0, 1,            0,
+      commLineOpt_conflicts,   'K', "conflicts",   COMMLINE_opt_arg_none,     0, 1,            0,
+      commLineOpt_reduce,      'r', "reduce",      COMMLINE_opt_arg_none,     0, 1,            0,
+      commLineOpt_renumber,    'R', "renumber",    COMMLINE_opt_arg_none,     0, 1,            0,
+      commLineOpt_unitrules,   'U', "unitrules",   COMMLINE_opt_arg_none,     0, 1,            0,
+      commLineOpt_serve,       'Q', "serve",       COMMLINE_opt_arg_none,     0, 1,            0,
+      commLineOpt_watch,       'W', "watch",       COMMLINE_opt_arg_none,     0, 1,            0,
+      commLineOpt_export,      'J', "export",      COMMLINE_opt_arg_string,   0, 1,            0,
+      commLineOpt_dotfile,     'G', "dotfile",     COMMLINE_opt_arg_none,     0, 1,            0,
    1,
       COMMLINE_opt_arg_string );
 
@@ -306,6 +460,7 @@ void process_commLine (int argc, char *argv[])
    printf("| -N         Print NFA in DOT, convert to SVG format, and generate .lda  No |\n");
    printf("| -d         Print DFA states with LR(0) items in plain text format      No |\n");
    printf("| -D         Print DFA in DOT, convert to SVG format, and generate .lda  No |\n");
+   printf("| -G         Also write the DOT source of the -N and -D diagrams         No |\n");
    printf("| -A         Generate LiDAS files for SVG animation move by itself       No |\n");
    printf("|              - Standard animation is by keyboard                          |\n");
    printf("| -C <file>  Set configuration file to SVG and animation attributes      No |\n");
@@ -315,6 +470,7 @@ void process_commLine (int argc, char *argv[])
    printf("| -s         Generate sLR(1) parse tables in text format                 No |\n");
    printf("| -L         Generate LR(0) parse tables in binary format                No |\n");
    printf("| -S         Generate sLR(1) parse tables in binary format               No |\n");
+   printf("| -P         Generate direct-coded sLR(1) parser in C source format      No |\n");
    printf("| -o         Send all output to a single file                            No |\n");
    printf("| -x         Strip off quotes from terminal symbol strings               No |\n");
    printf("| -c         Print symbol codes in parse tables, not strings             No |\n");
@@ -324,6 +480,23 @@ void process_commLine (int argc, char *argv[])
    printf("|                    and no extra blanks on either margin                   |\n");
    printf("|              N=-1: auto column width, set to longest symbol string        |\n");
    printf("|                    plus ABS(N) blanks inside each margin                  |\n");
+   printf("| -p <fmt>   Print wall and CPU time of each phase, fmt is table or json  No |\n");
+   printf("| -m         Write work counters and automaton sizes in JSON format      No |\n");
+   printf("| -J <fmt>   Export automata, sets and tables, fmt is json or binary     No |\n");
+   printf("| -X         Cross-check the DFA against a subset-construction DFA       No |\n");
+   printf("| -g         Read the grammar with the regex-based scanner (LEXAN)       No |\n");
+   printf("| -b         Load the grammar from its .grb file, written if out of date No |\n");
+   printf("| -K         Only report LR(0) and sLR(1) conflicts, to standard output  No |\n");
+   printf("| -r         Remove unproductive and unreachable rules before building   No |\n");
+   printf("|              the automata, and report them to standard output             |\n");
+   printf("| -R         Renumber DFA states depth-first, following shifts first     No |\n");
+   printf("|              so parse table rows used together are kept together         |\n");
+   printf("| -U         Bypass unit rules (A -> B) in the parser generated by -P    No |\n");
+   printf("| -Q         Serve requests on a Unix socket named by grammar_file       No |\n");
+   printf("|              - Each request is a command line, run in a child process    |\n");
+   printf("|              - SVG attributes read with -C by the server are kept        |\n");
+   printf("| -W         Watch grammar_file and the -C file, regenerating on saves   No |\n");
+   printf("|              - A change to the -C file only redraws the SVG diagrams     |\n");
    printf("+---------------------------------------------------------------------------+\n");
    printf(" \n");
    exit (EXIT_SUCCESS);
@@ -373,6 +546,12 @@ void process_commLine (int argc, char *argv[])
  if (! COMMLINE_optId2optUses (commLineOpt_dfasvg, &optUses))
    ERROR_short_fatal_error (COMMLINE_get_commLine_error());
  b_print_dfa_svg = (optUses > 0);
+
+ /* Does the user want the DOT source of the diagrams written to .dot files? */
+
+ if (! COMMLINE_optId2optUses (commLineOpt_dotfile, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ b_write_dot_files = (optUses > 0);
  
  /* Has the user asked for LiDAS files to animate the SVG automatically? */
  
@@ -434,6 +613,12 @@ void process_commLine (int argc, char *argv[])
    ERROR_short_fatal_error (COMMLINE_get_commLine_error());
  b_write_binary_sLR1_table = (optUses > 0);
 
+ /* Has the user asked for generation of a direct-coded SLR(1) parser in C? */
+
+ if (! COMMLINE_optId2optUses (commLineOpt_slrcode, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ b_write_slr1_parser_code = (optUses > 0);
+
  /* Print symbol codes in parse tables instead of symbol strings? */
 
  if (! COMMLINE_optId2optUses (commLineOpt_codes, &optUses))
@@ -452,6 +637,129 @@ void process_commLine (int argc, char *argv[])
    parse_table_symbol_width = (int) argLongInt;
  }
 
+ /* Has the user asked for the work counters in a JSON metrics file? */
+
+ if (! COMMLINE_optId2optUses (commLineOpt_metrics, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ b_write_metrics = (optUses > 0);
+
+ /* Has the user asked for a machine-readable export, and in which format? */
+
+ if (! COMMLINE_optId2optUses (commLineOpt_export, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ b_export = (optUses > 0);
+ if (b_export) {
+   if (! COMMLINE_optUse2optArg (commLineOpt_export, 1, &argStr))
+     ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+   if (strcmp (argStr, EXPORT_FORMAT_JSON) == 0)
+     exportFormat = t_export_json;
+   else if (strcmp (argStr, EXPORT_FORMAT_BINARY) == 0)
+     exportFormat = t_export_binary;
+   else {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Invalid export format \"%s\" (use %s or %s)", argStr, EXPORT_FORMAT_JSON, EXPORT_FORMAT_BINARY);
+     ERROR_short_fatal_error (ERROR_auxErrorMsg);
+   }
+   free (argStr);
+   argStr = NULL;
+ }
+
+ /* Has the user asked for the DFA to be cross-checked by subset construction? */
+
+ if (! COMMLINE_optId2optUses (commLineOpt_subsetdfa, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ b_check_subset_dfa = (optUses > 0);
+
+ /* Does the user want the grammar read by LEXAN instead of the hand-written scanner? */
+
+ if (! COMMLINE_optId2optUses (commLineOpt_regexscan, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ b_regex_scanner = (optUses > 0);
+
+ /* Does the user want the grammar cached in binary format? */
+
+ if (! COMMLINE_optId2optUses (commLineOpt_grb, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ b_grammar_binary = (optUses > 0);
+
+ /* Does the user only want to know about parse table conflicts? */
+
+ if (! COMMLINE_optId2optUses (commLineOpt_conflicts, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ b_report_conflicts = (optUses > 0);
+
+ /* Should useless rules and symbols be removed from the grammar first? */
+
+ if (! COMMLINE_optId2optUses (commLineOpt_reduce, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ b_reduce_grammar = (optUses > 0);
+
+ /* Should DFA states be renumbered for locality once the DFA is built? */
+
+ if (! COMMLINE_optId2optUses (commLineOpt_renumber, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ b_renumber_states = (optUses > 0);
+
+ /* Should the generated parser bypass unit rules? */
+
+ if (! COMMLINE_optId2optUses (commLineOpt_unitrules, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ b_bypass_unit_rules = (optUses > 0);
+
+ /* Should requests be served on a socket instead? */
+
+ if (! COMMLINE_optId2optUses (commLineOpt_serve, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ b_serve = (optUses > 0);
+
+ /* Should the outputs be regenerated whenever the inputs change? */
+
+ if (! COMMLINE_optId2optUses (commLineOpt_watch, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ b_watch = (optUses > 0);
+ if (b_watch && b_serve)
+   ERROR_short_fatal_error ("Options -W and -Q cannot be used together");
+
+ /* Has the user asked for the time taken by each phase? */
+
+ if (! COMMLINE_optId2optUses (commLineOpt_profile, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ if (optUses != 0) {
+   if (! COMMLINE_optUse2optArg (commLineOpt_profile, 1, &argStr))
+     ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+   if (strcmp (argStr, PROFILE_FORMAT_TABLE) == 0)
+     profileFormat = t_profile_table;
+   else if (strcmp (argStr, PROFILE_FORMAT_JSON) == 0)
+     profileFormat = t_profile_json;
+   else {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Invalid profile format \"%s\" (use %s or %s)", argStr, PROFILE_FORMAT_TABLE, PROFILE_FORMAT_JSON);
+     ERROR_short_fatal_error (ERROR_auxErrorMsg);
+   }
+   free (argStr);
+   argStr = NULL;
+ }
+
+ /* In server mode the argument names the socket; each request brings its own outputs */
+
+ if (b_serve) {
+   if (! COMMLINE_argPos2argVal (1, &argStr))
+     ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+   if (strlen (argStr) >= FILE_NAME_SIZE) {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Socket name \"%s\" is too long", argStr);
+     ERROR_short_fatal_error (ERROR_auxErrorMsg);
+   }
+   strcpy (serverSocketName, argStr);
+   free (argStr);
+   argStr = NULL;
+   if (b_set_cfg_file) {
+     if (! COMMLINE_optUse2optArg (commLineOpt_config, 1, &argStr))
+       ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+     strncpy (configFileName, argStr, FILE_NAME_SIZE - 1);
+     free (argStr);
+     argStr = NULL;
+   }
+   return;
+ }
+
  /* At least one type of output must be selected */
 
  if (! (b_print_symbols          ||
@@ -464,11 +772,46 @@ void process_commLine (int argc, char *argv[])
         b_print_text_sLR1_table  ||
         b_print_text_LR0_table   ||
         b_write_binary_LR0_table ||
-        b_write_binary_sLR1_table  )) {
+        b_write_binary_sLR1_table ||
+        b_write_slr1_parser_code ||
+        b_write_metrics          ||
+        b_export                 ||
+        b_check_subset_dfa       ||
+        b_report_conflicts         )) {
    printf ("\nNo valid output selected.\n\n");
    exit(0);
  }
 
+ /* The conflicts report is a mode of its own: no other output goes with it */
+
+ if (b_report_conflicts &&
+     (b_print_symbols          ||
+      b_print_nfa_text         ||
+      b_print_nfa_svg          ||
+      b_print_dfa_text         ||
+      b_print_dfa_svg          ||
+      b_print_sets             ||
+      b_print_answer_sheet     ||
+      b_print_text_sLR1_table  ||
+      b_print_text_LR0_table   ||
+      b_write_binary_LR0_table ||
+      b_write_binary_sLR1_table ||
+      b_write_slr1_parser_code ||
+      b_write_metrics          ||
+      b_export                 ||
+      b_check_subset_dfa         ))
+   ERROR_short_fatal_error ("Option -K cannot be combined with other outputs");
+
+ /* Unit rules are only bypassed in the generated parser */
+
+ if (b_bypass_unit_rules && ! b_write_slr1_parser_code)
+   ERROR_short_fatal_error ("Option -U needs option -P");
+
+ /* The .dot files are the source of the SVG diagrams */
+
+ if (b_write_dot_files && ! (b_print_nfa_svg || b_print_dfa_svg))
+   ERROR_short_fatal_error ("Option -G needs option -N or -D");
+
  /* Check the input file name */
 {
  if (! COMMLINE_argPos2argVal (1, &argStr))
@@ -487,6 +830,50 @@ void process_commLine (int argc, char *argv[])
  }
 }
 
+ if (b_grammar_binary) {
+   errno = 0;
+   if ((strcpy (grammarBinaryFileName, grammarFileName)) == NULL) {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "strcpy (grammarBinaryFileName ,\"%s\") failed", grammarFileName);
+     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
+   }
+   errno = 0;
+   if ((strcat(grammarBinaryFileName, FILE_EXTENSION_GRAMMAR_BINARY)) == NULL) {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "strcat(grammarBinaryFileName ,\"%s\") failed", FILE_EXTENSION_GRAMMAR_BINARY);
+     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
+   }
+ }
+
+ if (b_set_cfg_file) {
+   if (! COMMLINE_optUse2optArg (commLineOpt_config, 1, &argStr))
+     ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+   errno = 0;
+   if ((strcpy (configFileName, argStr)) == NULL) {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "strcpy (configFileName, %s) failed", argStr);
+     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
+   }
+   free (argStr);
+   argStr = NULL;
+   /*if ((configFilePt = fopen (configFileName, "r")) == NULL) {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Cannot open file \"%s\" for reading", configFileName);
+     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
+   }
+   fclose(configFilePt);
+   */
+ }
+ 
+ COMMLINE_free_commLine_data();
+}
+
+/*
+*---------------------------------------------------------------------
+* Build the output file names and open them. Called once the automata
+* have been built, so that in watch mode a grammar saved with errors
+* leaves the outputs of the previous build as they were.
+*---------------------------------------------------------------------
+*/
+
+void open_output_files (void)
+{
  /* Build output file names and file handles */
 
  if (b_one_output_file) {
@@ -563,23 +950,7 @@ void process_commLine (int argc, char *argv[])
    }
  }
 
- if (b_print_nfa_svg) {
-   errno = 0;
-   if ((strcpy (nfaDotFileName, grammarFileName)) == NULL) {
-     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "strcpy (nfaDotFileName ,\"%s\") failed", grammarFileName);
-     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
-   }
-   errno = 0;
-   if ((strcat(nfaDotFileName, FILE_EXTENSION_NFA_DOT)) == NULL) {
-     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "strcat(nfaDotFileName ,\"%s\") failed", FILE_EXTENSION_NFA_DOT);
-     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
-   }
-   errno = 0;
-   if ((nfaDotFilePt = fopen (nfaDotFileName, "w")) == NULL) {
-     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Cannot open \"%s\" for writing", nfaDotFileName);
-     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
-   }
- }
+ open_dot_files ();
 
  if (b_print_dfa_text) {
    if (b_one_output_file) {
@@ -609,42 +980,6 @@ void process_commLine (int argc, char *argv[])
    }
  }
 
- if (b_print_dfa_svg) {
-   errno = 0;
-   if ((strcpy (dfaDotFileName, grammarFileName)) == NULL) {
-     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "strcpy (dfaDotFileName ,\"%s\") failed", grammarFileName);
-     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
-   }
-   errno = 0;
-   if ((strcat(dfaDotFileName, FILE_EXTENSION_DFA_DOT)) == NULL) {
-     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "strcat(dfaDotFileName ,\"%s\") failed", FILE_EXTENSION_DFA_DOT);
-     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
-   }
-   errno = 0;
-   if ((dfaDotFilePt = fopen (dfaDotFileName, "w")) == NULL) {
-     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Cannot open \"%s\" for writing", dfaDotFileName);
-     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
-   }
- }
-
- if (b_set_cfg_file) {
-   if (! COMMLINE_optUse2optArg (commLineOpt_config, 1, &argStr))
-     ERROR_short_fatal_error (COMMLINE_get_commLine_error());
-   errno = 0;
-   if ((strcpy (configFileName, argStr)) == NULL) {
-     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "strcpy (configFileName, %s) failed", argStr);
-     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
-   }
-   free (argStr);
-   argStr = NULL;
-   /*if ((configFilePt = fopen (configFileName, "r")) == NULL) {
-     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Cannot open file \"%s\" for reading", configFileName);
-     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
-   }
-   fclose(configFilePt);
-   */
- }
- 
  if (b_print_sets) {
    if (b_one_output_file) {
      errno = 0;
@@ -765,7 +1100,131 @@ void process_commLine (int argc, char *argv[])
    }
  }
 
- COMMLINE_free_commLine_data();
+ if (b_write_slr1_parser_code) {
+   errno = 0;
+   if ((strcpy (slr1ParserCodeFileName, grammarFileName)) == NULL) {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "strcpy (slr1ParserCodeFileName ,\"%s\") failed", grammarFileName);
+     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
+   }
+   errno = 0;
+   if ((strcat(slr1ParserCodeFileName, FILE_EXTENSION_SLR1_PARSER_CODE)) == NULL) {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "strcat(slr1ParserCodeFileName ,\"%s\") failed", FILE_EXTENSION_SLR1_PARSER_CODE);
+     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
+   }
+   errno = 0;
+   if ((slr1ParserCodeFilePt = fopen (slr1ParserCodeFileName, "w")) == NULL) {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Cannot open \"%s\" for writing", slr1ParserCodeFileName);
+     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
+   }
+ }
+
+ if (b_write_metrics) {
+   errno = 0;
+   if ((strcpy (metricsFileName, grammarFileName)) == NULL) {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "strcpy (metricsFileName ,\"%s\") failed", grammarFileName);
+     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
+   }
+   errno = 0;
+   if ((strcat(metricsFileName, FILE_EXTENSION_METRICS)) == NULL) {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "strcat(metricsFileName ,\"%s\") failed", FILE_EXTENSION_METRICS);
+     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
+   }
+   errno = 0;
+   if ((metricsFilePt = fopen (metricsFileName, "w")) == NULL) {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Cannot open \"%s\" for writing", metricsFileName);
+     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
+   }
+ }
+
+ if (b_export) {
+   errno = 0;
+   if ((strcpy (exportFileName, grammarFileName)) == NULL) {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "strcpy (exportFileName ,\"%s\") failed", grammarFileName);
+     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
+   }
+   errno = 0;
+   if ((strcat(exportFileName, (exportFormat == t_export_json) ? FILE_EXTENSION_EXPORT_JSON : FILE_EXTENSION_EXPORT_BINARY)) == NULL) {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "strcat(exportFileName ,\"%s\") failed", (exportFormat == t_export_json) ? FILE_EXTENSION_EXPORT_JSON : FILE_EXTENSION_EXPORT_BINARY);
+     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
+   }
+   errno = 0;
+   if ((exportFilePt = fopen (exportFileName, "wb")) == NULL) {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Cannot open \"%s\" for writing", exportFileName);
+     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
+   }
+ }
+}
+
+/*
+*---------------------------------------------------------------------
+* Open the DOT sources of the SVG diagrams. They are written to memory
+* and Graphviz reads them from there, so the .dot files are only
+* written when asked for with -G. Watch mode calls it again to redraw
+* the diagrams without touching the other outputs.
+*---------------------------------------------------------------------
+*/
+
+void open_dot_files (void)
+{
+ if (b_print_nfa_svg) {
+   errno = 0;
+   if ((strcpy (nfaDotFileName, grammarFileName)) == NULL) {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "strcpy (nfaDotFileName ,\"%s\") failed", grammarFileName);
+     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
+   }
+   errno = 0;
+   if ((strcat(nfaDotFileName, FILE_EXTENSION_NFA_DOT)) == NULL) {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "strcat(nfaDotFileName ,\"%s\") failed", FILE_EXTENSION_NFA_DOT);
+     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
+   }
+   errno = 0;
+   if ((nfaDotFilePt = open_memstream (&nfaDotText, &nfaDotTextSize)) == NULL) {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Cannot open a memory stream for \"%s\"", nfaDotFileName);
+     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
+   }
+ }
+
+ if (b_print_dfa_svg) {
+   errno = 0;
+   if ((strcpy (dfaDotFileName, grammarFileName)) == NULL) {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "strcpy (dfaDotFileName ,\"%s\") failed", grammarFileName);
+     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
+   }
+   errno = 0;
+   if ((strcat(dfaDotFileName, FILE_EXTENSION_DFA_DOT)) == NULL) {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "strcat(dfaDotFileName ,\"%s\") failed", FILE_EXTENSION_DFA_DOT);
+     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
+   }
+   errno = 0;
+   if ((dfaDotFilePt = open_memstream (&dfaDotText, &dfaDotTextSize)) == NULL) {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Cannot open a memory stream for \"%s\"", dfaDotFileName);
+     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
+   }
+ }
+}
+
+/*
+*---------------------------------------------------------------------
+* Write the DOT source of a diagram, once complete in memory, to its
+* .dot file
+*---------------------------------------------------------------------
+*/
+
+void write_dot_file (const char *dotFileName, const char *dotText, size_t dotTextSize)
+{
+ FILE
+   *dotFilePt;
+
+ errno = 0;
+ if ((dotFilePt = fopen (dotFileName, "w")) == NULL) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Cannot open \"%s\" for writing", dotFileName);
+   ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
+ }
+ errno = 0;
+ if ((fwrite (dotText, 1, dotTextSize, dotFilePt) != dotTextSize) || (fclose (dotFilePt) != 0)) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Cannot write \"%s\"", dotFileName);
+   ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
+ }
 }
 
 /*
@@ -1965,75 +2424,327 @@ int
 
 /*
 *---------------------------------------------------------------------
-* Main body of the program
+* Start the stopwatches used to profile the pipeline phases
+*---------------------------------------------------------------------
+*/
+
+void profile_start (void)
+{
+ if (profileFormat == t_profile_none)
+   return;
+ TIME_init_stopwatches();
+ profilePhaseWatch = TIME_setup_stopwatch();
+ profileTotalWatch = TIME_setup_stopwatch();
+ totProfilePhases  = 0;
+ (void) TIME_start_stopwatch (profileTotalWatch);
+}
+
+/*
+*---------------------------------------------------------------------
+* Restart the phase stopwatch from zero
+*---------------------------------------------------------------------
+*/
+
+void profile_start_phase (void)
+{
+ if (profileFormat == t_profile_none)
+   return;
+ (void) TIME_reset_stopwatch (profilePhaseWatch);
+}
+
+/*
+*---------------------------------------------------------------------
+* Stop the phase stopwatch and record its readings under phaseName
+*---------------------------------------------------------------------
+*/
+
+void profile_stop_phase (const char *phaseName)
+{
+ t_profile_phase
+   *phase;
+
+ if (profileFormat == t_profile_none)
+   return;
+ (void) TIME_stop_stopwatch (profilePhaseWatch);
+ if (totProfilePhases >= MAX_PROFILE_PHASES) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Unable to profile phase \"%s\": array overflow", phaseName);
+   ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+ }
+ phase = &profilePhases[totProfilePhases++];
+ phase->name = phaseName;
+ phase->wall = TIME_read_wall_stopwatch (profilePhaseWatch);
+ phase->cpu  = TIME_read_stopwatch (profilePhaseWatch);
+}
+
+/*
+*---------------------------------------------------------------------
+* Print wall and CPU time of each phase, as a table or in JSON
+*---------------------------------------------------------------------
+*/
+
+void print_profile (void)
+{
+ int
+   iPhase;
+ TIME_t_seconds
+   totalWall,
+   totalCpu;
+
+ if (profileFormat == t_profile_none)
+   return;
+ (void) TIME_stop_stopwatch (profileTotalWatch);
+ totalWall = TIME_read_wall_stopwatch (profileTotalWatch);
+ totalCpu  = TIME_read_stopwatch (profileTotalWatch);
+ if (profileFormat == t_profile_table) {
+   printf ("\nProfile of %s %s\n\n", progName, grammarFileName);
+   printf ("%-48s %12s %12s\n", "Phase", "Wall (s)", "CPU (s)");
+   printf ("%-48s %12s %12s\n", "-----", "--------", "-------");
+   for (iPhase = 0; iPhase < totProfilePhases; iPhase++)
+     printf ("%-48s %12.6f %12.6f\n", profilePhases[iPhase].name, profilePhases[iPhase].wall, profilePhases[iPhase].cpu);
+   printf ("%-48s %12s %12s\n", "", "--------", "-------");
+   printf ("%-48s %12.6f %12.6f\n\n", "total", totalWall, totalCpu);
+ }
+ else {
+   printf ("{\n  \"grammar\": ");
+   print_json_string (stdout, grammarFileName);
+   printf (",\n  \"phases\": [\n");
+   for (iPhase = 0; iPhase < totProfilePhases; iPhase++)
+     printf ("    { \"name\": \"%s\", \"wall\": %.6f, \"cpu\": %.6f }%s\n",
+             profilePhases[iPhase].name, profilePhases[iPhase].wall, profilePhases[iPhase].cpu,
+             (iPhase < totProfilePhases - 1) ? "," : "");
+   printf ("  ],\n  \"total\": { \"wall\": %.6f, \"cpu\": %.6f }\n}\n", totalWall, totalCpu);
+ }
+ fflush (stdout);
+}
+
+/*
+*---------------------------------------------------------------------
+* Write grammar and automaton sizes, and the counters of work done
+* building them, as a JSON object to the metrics file
+*---------------------------------------------------------------------
+*/
+
+void write_metrics_file (void)
+{
+ fprintf (metricsFilePt, "{\n");
+ fprintf (metricsFilePt, "  \"grammar\": ");
+ print_json_string (metricsFilePt, grammarFileName);
+ fprintf (metricsFilePt, ",\n");
+ fprintf (metricsFilePt, "  \"sizes\": {\n");
+ fprintf (metricsFilePt, "    \"terminals\": %u,\n",         totTerminals);
+ fprintf (metricsFilePt, "    \"nonTerminals\": %u,\n",      totNonTerminals);
+ fprintf (metricsFilePt, "    \"rules\": %u,\n",             totRules);
+ fprintf (metricsFilePt, "    \"LR0items\": %u,\n",          totLR0items);
+ fprintf (metricsFilePt, "    \"NFAstates\": %u,\n",         totNFAstates);
+ fprintf (metricsFilePt, "    \"NFAtransitions\": %u,\n",    totNFAtransitions);
+ fprintf (metricsFilePt, "    \"DFAstates\": %u,\n",         totDFAstates);
+ fprintf (metricsFilePt, "    \"DFAitems\": %u,\n",          totDFAitems);
+ fprintf (metricsFilePt, "    \"DFAtransitions\": %u\n",     totDFAtransitions);
+ fprintf (metricsFilePt, "  },\n");
+ fprintf (metricsFilePt, "  \"layout\": {\n");
+ fprintf (metricsFilePt, "    \"statesRenumbered\": %s,\n",    b_renumber_states ? "true" : "false");
+ fprintf (metricsFilePt, "    \"meanTransitionSpan\": %.2f,\n", dfa_meanTransitionSpan());
+ fprintf (metricsFilePt, "    \"nextStateIndex\": \"%s\"\n",   dfa_isNextStateIndexDense() ? "dense" : "sparse");
+ fprintf (metricsFilePt, "  },\n");
+ fprintf (metricsFilePt, "  \"counters\": {\n");
+ fprintf (metricsFilePt, "    \"grammarTokens\": %lu,\n",           cnt_grammarTokens);
+ fprintf (metricsFilePt, "    \"closureCalls\": %lu,\n",            cnt_closureCalls);
+ fprintf (metricsFilePt, "    \"closureSweeps\": %lu,\n",           cnt_closureSweeps);
+ fprintf (metricsFilePt, "    \"closureItemsAdded\": %lu,\n",       cnt_closureItemsAdded);
+ fprintf (metricsFilePt, "    \"gotoCalls\": %lu,\n",               cnt_gotoCalls);
+ fprintf (metricsFilePt, "    \"gotoEmptyResults\": %lu,\n",        cnt_gotoEmptyResults);
+ fprintf (metricsFilePt, "    \"gotoDuplicateStates\": %lu,\n",     cnt_gotoDuplicateStates);
+ fprintf (metricsFilePt, "    \"itemLookups\": %lu,\n",             cnt_itemLookups);
+ fprintf (metricsFilePt, "    \"itemCreations\": %lu,\n",           cnt_itemCreations);
+ fprintf (metricsFilePt, "    \"nfaDuplicateTransitions\": %lu,\n", cnt_nfaDuplicateTransitions);
+ fprintf (metricsFilePt, "    \"dfaDuplicateTransitions\": %lu,\n", cnt_dfaDuplicateTransitions);
+ fprintf (metricsFilePt, "    \"firstSetIterations\": %lu,\n",      cnt_firstSetIterations);
+ fprintf (metricsFilePt, "    \"followSetIterations\": %lu\n",      cnt_followSetIterations);
+ fprintf (metricsFilePt, "  }\n");
+ fprintf (metricsFilePt, "}\n");
+ fflush (metricsFilePt);
+}
+
+/*
+*---------------------------------------------------------------------
+* Main body of the program: one run, or a server running requests
 *---------------------------------------------------------------------
 */
 
 int main (int argc, char *argv[]) {
  process_commLine (argc, argv);
- read_grammar (grammarFileName, progName, b_stripoff_quotes);
+ if (b_watch)
+   return (watch_geraLR (argc, argv));
+ if (! b_serve)
+   return (run_geraLR (argc, argv));
 
- if (b_print_symbols)
-   print_grammar_data (argc, argv);
- build_LR0_items_NFA_and_DFA();
- 
- if (b_set_cfg_file)
+ /* Do the start-up work once, so every request finds it done */
+
+ if (b_set_cfg_file && (stat (configFileName, &loadedConfigStat) == 0)) {
    initialize_svg_attributes();
- 
+   strcpy (loadedConfigFileName, configFileName);
+ }
+ open_graphviz_context();
+ serve_requests (serverSocketName, progName, run_request);
+ close_graphviz_context();
+ if (b_set_cfg_file)
+   free_svg_diagrams_data ();
+ return (EXIT_SUCCESS);
+}
+
+/*
+*---------------------------------------------------------------------
+* In server mode, whether the SVG attributes the server read at start-up
+* are those of the -C file of this request: same name, and the file has
+* not been modified since
+*---------------------------------------------------------------------
+*/
+
+bool is_loaded_config_current (void) {
+ struct stat
+   configStat;
+
+ if ((loadedConfigFileName[0] == '\0') || (strcmp (configFileName, loadedConfigFileName) != 0))
+   return (false);
+ if (stat (configFileName, &configStat) != 0)
+   return (false);
+ return ((configStat.st_mtim.tv_sec  == loadedConfigStat.st_mtim.tv_sec)  &&
+         (configStat.st_mtim.tv_nsec == loadedConfigStat.st_mtim.tv_nsec) &&
+         (configStat.st_size         == loadedConfigStat.st_size));
+}
+
+/*
+*---------------------------------------------------------------------
+* Run one request of the server, in a child process of its own
+*---------------------------------------------------------------------
+*/
+
+void run_request (int argc, char *argv[]) {
+ process_commLine (argc, argv);
+ if (b_serve)
+   ERROR_short_fatal_error ("Option -Q cannot be used in a request");
+ exit (run_geraLR (argc, argv));
+}
+
+/*
+*---------------------------------------------------------------------
+* Read the grammar, build everything asked for in the command line
+* and write it out
+*---------------------------------------------------------------------
+*/
+
+int run_geraLR (int argc, char *argv[]) {
+ profile_start();
+ build_automata (argc, argv);
+ return (write_outputs (argc, argv));
+}
+
+/*
+*---------------------------------------------------------------------
+* Read the grammar and build its NFA and DFA
+*---------------------------------------------------------------------
+*/
+
+void build_automata (int argc, char *argv[]) {
+ bool
+   b_grammar_loaded;
+
+ /* With -b, a .grb file that is up to date with the grammar file saves reading it; */
+ /* otherwise the grammar is read as usual and the .grb file is written afresh      */
+
+ b_grammar_loaded = false;
+ if (b_grammar_binary)
+   PROFILE_PHASE ("load_grammar_binary", b_grammar_loaded = load_grammar_binary (grammarBinaryFileName, grammarFileName, b_stripoff_quotes));
+ if (! b_grammar_loaded) {
+   PROFILE_PHASE ("read_grammar", read_grammar (grammarFileName, progName, b_stripoff_quotes, b_regex_scanner));
+   if (b_grammar_binary)
+     PROFILE_PHASE ("write_grammar_binary", write_grammar_binary (grammarBinaryFileName, grammarFileName, b_stripoff_quotes));
+ }
+ if (b_reduce_grammar)
+   PROFILE_PHASE ("reduce_grammar", (void) reduce_grammar (stdout));
+
+ PROFILE_PHASE ("build_LR0_items_NFA_and_DFA", build_LR0_items_NFA_and_DFA());
+
+ if (b_check_subset_dfa) {
+   PROFILE_PHASE ("build_subset_DFA", build_subset_DFA());
+   PROFILE_PHASE ("check_subset_DFA", check_subset_DFA());
+   free_subset_DFA();
+ }
+ if (b_renumber_states)
+   PROFILE_PHASE ("dfa_renumberStates", dfa_renumberStates());
+}
+
+/*
+*---------------------------------------------------------------------
+* Write every output asked for in the command line, once the automata
+* have been built, and free everything
+*---------------------------------------------------------------------
+*/
+
+int write_outputs (int argc, char *argv[]) {
+ /* A server may have read SVG attributes that do not apply to this run */
+
+ if (b_set_cfg_file) {
+   if (! is_loaded_config_current()) {
+     reset_svg_attributes();
+     PROFILE_PHASE ("initialize_svg_attributes", initialize_svg_attributes());
+   }
+ }
+ else if (loadedConfigFileName[0] != '\0')
+   reset_svg_attributes();
+
+ open_output_files();
+ if (b_print_symbols)
+   PROFILE_PHASE ("print_grammar_data", print_grammar_data (argc, argv));
  if (b_print_nfa_text)
-   print_nfa_txt (argc, argv);
+   PROFILE_PHASE ("print_nfa_txt", print_nfa_txt (argc, argv));
  
- if (b_print_nfa_svg) {
-   print_nfa_dot();
-   fclose (nfaDotFilePt);
-   print_nfa_svg();
-   if (! b_automatic_animation)
-     print_nfa_lda();
-   else
-     print_nfa_lda2();
-     /* compile_lda(nfaLdaFileName, nfaSvgFileName);*/
- }
+ if (b_print_nfa_svg)
+   print_nfa_diagrams();
  if (b_print_dfa_text)
-   print_dfa_txt (argc, argv);
- if (b_print_dfa_svg) {
-   print_dfa_dot ();
-   fclose (dfaDotFilePt);
-   print_dfa_svg ();
-   if (!b_automatic_animation)
-	   print_dfa_lda();
-   else
-     print_dfa_lda2();
-    /* compile_lda(dfaLdaFileName, dfaSvgFileName);*/
- }
+   PROFILE_PHASE ("print_dfa_txt", print_dfa_txt (argc, argv));
+ if (b_print_dfa_svg)
+   print_dfa_diagrams();
    
- build_first_sets();
- build_follow_sets();
+ PROFILE_PHASE ("build_first_sets", build_first_sets());
+ PROFILE_PHASE ("build_follow_sets", build_follow_sets());
  if (b_print_sets)
-   print_sets (argc, argv);
+   PROFILE_PHASE ("print_sets", print_sets (argc, argv));
+ if (b_report_conflicts) {
+   PROFILE_PHASE ("report_conflicts (LR0)", (void) report_conflicts (t_LR0_parse_table));
+   PROFILE_PHASE ("report_conflicts (sLR1)", (void) report_conflicts (t_sLR1_parse_table));
+ }
 
- if (b_print_text_LR0_table || b_write_binary_LR0_table)
-   build_LR0_parse_table();
- if (b_print_text_sLR1_table || b_write_binary_sLR1_table)
-   build_sLR1_parse_table();
+ if (b_print_text_LR0_table || b_write_binary_LR0_table || b_export)
+   PROFILE_PHASE ("build_LR0_parse_table", build_LR0_parse_table());
+ if (b_print_text_sLR1_table || b_write_binary_sLR1_table || b_write_slr1_parser_code || b_export)
+   PROFILE_PHASE ("build_sLR1_parse_table", build_sLR1_parse_table());
  if (b_print_text_LR0_table || b_print_text_sLR1_table)
-   print_text_parse_table_report_header (argc, argv);
+   PROFILE_PHASE ("print_text_parse_table_report_header", print_text_parse_table_report_header (argc, argv));
  if (b_print_text_LR0_table)
-   print_text_parse_table (t_LR0_parse_table);
+   PROFILE_PHASE ("print_text_parse_table (LR0)", print_text_parse_table (t_LR0_parse_table));
  if (b_print_text_sLR1_table)
-   print_text_parse_table(t_sLR1_parse_table);
+   PROFILE_PHASE ("print_text_parse_table (sLR1)", print_text_parse_table(t_sLR1_parse_table));
  if (b_print_text_LR0_table && b_print_text_sLR1_table) {
-   build_diff_parse_table();
-   print_text_parse_table (t_diff_parse_table);
+   PROFILE_PHASE ("build_diff_parse_table", build_diff_parse_table());
+   PROFILE_PHASE ("print_text_parse_table (diff)", print_text_parse_table (t_diff_parse_table));
  }
  if (b_print_answer_sheet)
-   print_answer_sheet (argc, argv);
+   PROFILE_PHASE ("print_answer_sheet", print_answer_sheet (argc, argv));
  if (b_write_binary_LR0_table)
-   write_parse_table_binary_file(t_LR0_parse_table);
+   PROFILE_PHASE ("write_parse_table_binary_file (LR0)", write_parse_table_binary_file(t_LR0_parse_table));
  if (b_write_binary_sLR1_table)
-   write_parse_table_binary_file(t_sLR1_parse_table);
+   PROFILE_PHASE ("write_parse_table_binary_file (sLR1)", write_parse_table_binary_file(t_sLR1_parse_table));
+ if (b_write_slr1_parser_code)
+   PROFILE_PHASE ("print_slr1_parser_code", print_slr1_parser_code (argc, argv, b_bypass_unit_rules));
+ if (b_write_metrics)
+   PROFILE_PHASE ("write_metrics_file", write_metrics_file());
+ if (b_export)
+   PROFILE_PHASE ("export_automata", export_automata (exportFilePt, exportFormat, grammarFileName));
 
  /* That's all */
 
+ profile_start_phase();
  if (DATA_is_module_initialized())
    DATA_destroy_all();
  free_LR0_parse_table_memory();
@@ -2042,6 +2753,8 @@ int main (int argc, char *argv[]) {
  
  if (b_set_cfg_file)
    free_svg_diagrams_data ();
+ close_graphviz_context();
+ profile_stop_phase ("free_memory");
  
  if (grammarFilePt)
    fclose (grammarFilePt);
@@ -2065,5 +2778,111 @@ int main (int argc, char *argv[]) {
    fclose (lr0binaryTableFilePt);
  if (slr1binaryTableFilePt)
    fclose (slr1binaryTableFilePt);
+ if (slr1ParserCodeFilePt)
+   fclose (slr1ParserCodeFilePt);
+ if (metricsFilePt)
+   fclose (metricsFilePt);
+ if (exportFilePt)
+   fclose (exportFilePt);
+ print_profile();
+ return (EXIT_SUCCESS);
+}
+
+/*
+*---------------------------------------------------------------------
+* Write the NFA diagram: DOT source, SVG file and animation
+*---------------------------------------------------------------------
+*/
+
+void print_nfa_diagrams (void) {
+ PROFILE_PHASE ("print_nfa_dot", print_nfa_dot());
+ fclose (nfaDotFilePt);
+ if (b_write_dot_files)
+   PROFILE_PHASE ("write_dot_file (NFA)", write_dot_file (nfaDotFileName, nfaDotText, nfaDotTextSize));
+ PROFILE_PHASE ("print_nfa_svg", print_nfa_svg());
+ free (nfaDotText);
+ nfaDotText = NULL;
+ if (! b_automatic_animation)
+   PROFILE_PHASE ("print_nfa_lda", print_nfa_lda());
+ else
+   PROFILE_PHASE ("print_nfa_lda2", print_nfa_lda2());
+   /* compile_lda(nfaLdaFileName, nfaSvgFileName);*/
+}
+
+/*
+*---------------------------------------------------------------------
+* Write the DFA diagram: DOT source, SVG file and animation
+*---------------------------------------------------------------------
+*/
+
+void print_dfa_diagrams (void) {
+ PROFILE_PHASE ("print_dfa_dot", print_dfa_dot ());
+ fclose (dfaDotFilePt);
+ if (b_write_dot_files)
+   PROFILE_PHASE ("write_dot_file (DFA)", write_dot_file (dfaDotFileName, dfaDotText, dfaDotTextSize));
+ PROFILE_PHASE ("print_dfa_svg", print_dfa_svg ());
+ free (dfaDotText);
+ dfaDotText = NULL;
+ if (! b_automatic_animation)
+   PROFILE_PHASE ("print_dfa_lda", print_dfa_lda());
+ else
+   PROFILE_PHASE ("print_dfa_lda2", print_dfa_lda2());
+   /* compile_lda(dfaLdaFileName, dfaSvgFileName);*/
+}
+
+/*
+*---------------------------------------------------------------------
+* Watch mode: a grammar change rebuilds the automata and writes every
+* output again; a change to the -C file only redraws the diagrams
+* from the automata already built. The -C file is only watched when
+* there are diagrams to draw.
+*---------------------------------------------------------------------
+*/
+
+int watch_geraLR (int argc, char *argv[]) {
+ char
+   *fileNames [2];
+ bool
+   b_rebuildOnChange [2] = { true, false };
+ int
+   totFiles = 0;
+
+ watchArgc = argc;
+ watchArgv = argv;
+ fileNames[totFiles++] = grammarFileName;
+ if (b_set_cfg_file && (b_print_nfa_svg || b_print_dfa_svg))
+   fileNames[totFiles++] = configFileName;
+ watch_files (progName, totFiles, fileNames, b_rebuildOnChange, watch_build_stage, watch_write_stage, watch_refresh_stage);
  return (EXIT_SUCCESS);
 }
+
+/*
+*---------------------------------------------------------------------
+* Watch mode stages (see "watch.h"). The build stage parses the
+* command line again; the output files are only opened afresh by
+* the write stage, once the build has succeeded.
+*---------------------------------------------------------------------
+*/
+
+void watch_build_stage (void) {
+ process_commLine (watchArgc, watchArgv);
+ profile_start();
+ build_automata (watchArgc, watchArgv);
+}
+
+void watch_write_stage (void) {
+ exit (write_outputs (watchArgc, watchArgv));
+}
+
+void watch_refresh_stage (void) {
+ open_dot_files();
+ if (b_set_cfg_file)
+   initialize_svg_attributes();
+ if (b_print_nfa_svg)
+   print_nfa_diagrams();
+ if (b_print_dfa_svg)
+   print_dfa_diagrams();
+ if (b_set_cfg_file)
+   free_svg_diagrams_data ();
+ close_graphviz_context();
+}
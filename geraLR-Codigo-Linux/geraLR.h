@@ -74,8 +74,13 @@
 #define FILE_EXTENSION_ANSWER_SHEET       ".gab"
 #define FILE_EXTENSION_BINARY_LR0_TABLE   "-LR0.tbl"
 #define FILE_EXTENSION_BINARY_SLR1_TABLE  "-sLR1.tbl"
+#define FILE_EXTENSION_SLR1_PARSER_CODE   "-sLR1.c"
 #define FILE_EXTENSION_TEXT_TABLES        "-TXT.tbl"
 #define FILE_EXTENSION_ONE_OUTPUT         ".out"
+#define FILE_EXTENSION_METRICS            "-metrics.json"
+#define FILE_EXTENSION_EXPORT_JSON        "-export.json"
+#define FILE_EXTENSION_EXPORT_BINARY      "-export.bin"
+#define FILE_EXTENSION_GRAMMAR_BINARY     ".grb"
 
 /*                        */
 /* Program and file names */
@@ -97,9 +102,11 @@ extern char
   setsFileName            [FILE_NAME_SIZE],
   lr0binaryTableFileName  [FILE_NAME_SIZE],
   slr1binaryTableFileName [FILE_NAME_SIZE],
+  slr1ParserCodeFileName  [FILE_NAME_SIZE],
   textTablesFileName      [FILE_NAME_SIZE],
   answerSheetFileName     [FILE_NAME_SIZE],
-  oneOutputFileName       [FILE_NAME_SIZE];
+  oneOutputFileName       [FILE_NAME_SIZE],
+  metricsFileName         [FILE_NAME_SIZE];
 
 /*              */
 /* File handles */
@@ -120,9 +127,18 @@ extern FILE
   *answerSheetFilePt,
   *lr0binaryTableFilePt,
   *slr1binaryTableFilePt,
+  *slr1ParserCodeFilePt,
   *textTablesFilePt,
+  *metricsFilePt,
   *outputFilePt;
 
+extern char
+  *nfaDotText,
+  *dfaDotText;
+extern size_t
+  nfaDotTextSize,
+  dfaDotTextSize;
+
 extern bool
   b_one_output_file,
   b_output_started;
@@ -0,0 +1,357 @@
+/*
+*-----------------------------------------------------------------------
+*
+*   File         : geraLoad.c
+*   Created      : 2026-10-19
+*   Last Modified: 2026-10-19
+*
+*   DESCRIPTION:
+*
+*   This program is a load test for geraLR in server mode (geraLR -Q).
+*   It sends the same request to the server over and over, one
+*   connection per request as the server expects, and reports the
+*   throughput in requests per second and the latency of the requests
+*   (mean, median, 99th percentile and maximum). A request fails if
+*   its reply does not end with a "#status 0" line.
+*
+*   USAGE:
+*   geraLoad -h for help
+*
+*-----------------------------------------------------------------------
+*/
+
+/*
+*-----------------------------------------------------------------------
+* INCLUDE FILES
+*-----------------------------------------------------------------------
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "error.h"
+#include "commline.h"
+
+/*
+*-----------------------------------------------------------------------
+* IMPLEMENTATION (invisible from other modules)
+*-----------------------------------------------------------------------
+*/
+
+#define VERSION  "1.0"
+
+#define DEFAULT_TOT_REQUESTS  100
+#define MAX_REPLY_TAIL        64   /* Enough for the "#status N" line */
+
+static char
+  *progName   = NULL,
+  *socketName = NULL,
+  *request    = NULL;
+
+static unsigned long int
+  totRequests = DEFAULT_TOT_REQUESTS;
+
+/* Latency of each request, in milliseconds */
+
+static double
+  *latencies = NULL;
+
+/*
+*---------------------------------------------------------------------
+* Function prototypes
+*---------------------------------------------------------------------
+*/
+
+int  main (int argc, char *argv[]);
+
+static void    process_commLine  (int argc, char *argv[]);
+static double  elapsed_ms        (const struct timespec *p_start, const struct timespec *p_stop);
+static bool    send_request      (int *p_exitStatus);
+static int     compare_latencies (const void *p_a, const void *p_b);
+static double  percentile        (double fraction);
+
+/* To prevent "implicit declaration" warnings */
+
+int snprintf (char *str, size_t size, const char *format, ...);
+
+/*
+*---------------------------------------------------------------------
+* Process options and arguments in the command line
+*---------------------------------------------------------------------
+*/
+
+typedef enum {
+  commLineOpt_help = 0,
+  commLineOpt_usage,
+  commLineOpt_requests,
+  commLineOpt_request
+}
+t_commLineOpts;
+
+int
+  commLine_totOptions = (int) commLineOpt_request + 1;
+
+static void process_commLine (int argc, char *argv[])
+{
+ bool
+   commLineOK;
+ int
+   optUses;
+
+ /* If there was an error in the command line */
+ /* then display program usage info and abort */
+
+ progName = COMMLINE_get_program_short_name (argv[0]);
+ commLineOK = COMMLINE_parse_commLine (argc, argv,
+   commLine_totOptions,
+      commLineOpt_help,     'h', "help",     COMMLINE_opt_arg_none,      0, COMMLINE_OPT_FREE_USE, 0,
+      commLineOpt_usage,    'u', "usage",    COMMLINE_opt_arg_none,      0, COMMLINE_OPT_FREE_USE, 0,
+      commLineOpt_requests, 'n', "requests", COMMLINE_opt_arg_ulong_int, 0, 1,            0,
+      commLineOpt_request,  'r', "request",  COMMLINE_opt_arg_string,    1, 1,            0,
+   1,
+      COMMLINE_opt_arg_string );
+
+ if (! commLineOK) {
+   COMMLINE_display_usage();
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ }
+
+ /* If the user asked for help then provide it and exit */
+
+ if (! COMMLINE_optId2optUses (commLineOpt_help, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ if (optUses > 0) {
+   printf("\n");
+   printf("This program sends the same request many times to geraLR in\n");
+   printf("server mode (geraLR socket_name -Q) and measures its throughput\n");
+   printf("and latency.\n");
+   printf("Usage:\n");
+   printf("\n");
+   printf("%s socket_name -r \"request\" [options]\n", progName);
+   printf("\n");
+   printf("The request is a geraLR command line without the program name,\n");
+   printf("e.g. -r \"-w 0 -sL gram03.grm\", with file names relative to the\n");
+   printf("working directory of the server.\n");
+   printf("\n");
+   printf("+---------------------------------------------------------------------------+\n");
+   printf("| Option     Purpose                                                Default |\n");
+   printf("+---------------------------------------------------------------------------+\n");
+   printf("| -h         Display this help message                                      |\n");
+   printf("| -u         Display details on command line options                        |\n");
+   printf("| -r STRING  Request to send (required)                                     |\n");
+   printf("| -n N       Number of requests                                         100 |\n");
+   printf("+---------------------------------------------------------------------------+\n");
+   printf(" \n");
+   exit (EXIT_SUCCESS);
+ }
+
+ /* If the user asked for program usage info then provide it and exit */
+
+ if (! COMMLINE_optId2optUses (commLineOpt_usage, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ if (optUses > 0) {
+   COMMLINE_display_usage();
+   exit (EXIT_SUCCESS);
+ }
+
+ /* Number of requests */
+
+ if (! COMMLINE_optId2optUses (commLineOpt_requests, &optUses))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ if ((optUses > 0) && ! COMMLINE_optUse2optArg (commLineOpt_requests, 1, &totRequests))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ if (totRequests < 1)
+   ERROR_short_fatal_error ("Number of requests must be at least 1");
+
+ /* Socket and request */
+
+ if (! COMMLINE_argPos2argVal (1, &socketName))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ if (! COMMLINE_optUse2optArg (commLineOpt_request, 1, &request))
+   ERROR_short_fatal_error (COMMLINE_get_commLine_error());
+ if (strchr (request, '\n') != NULL)
+   ERROR_short_fatal_error ("The request must be a single line");
+
+ COMMLINE_free_commLine_data();
+}
+
+/*
+*---------------------------------------------------------------------
+* Milliseconds between two readings of the monotonic clock
+*---------------------------------------------------------------------
+*/
+
+static double elapsed_ms (const struct timespec *p_start, const struct timespec *p_stop)
+{
+ return ((double) (p_stop->tv_sec - p_start->tv_sec) * 1e3 + (double) (p_stop->tv_nsec - p_start->tv_nsec) / 1e6);
+}
+
+/*
+*---------------------------------------------------------------------
+* Connect, send the request and read the whole reply, keeping only its
+* tail to find the exit status. Returns false if the server could not
+* be reached or the reply has no status line.
+*---------------------------------------------------------------------
+*/
+
+static bool send_request (int *p_exitStatus)
+{
+ int
+   connection;
+ struct sockaddr_un
+   address;
+ char
+   buffer [4096],
+   tail [2 * MAX_REPLY_TAIL + 1],
+   *statusLine;
+ size_t
+   tailSize = 0,
+   requestSize;
+ ssize_t
+   bytes;
+
+ memset (&address, 0, sizeof (address));
+ address.sun_family = AF_UNIX;
+ strncpy (address.sun_path, socketName, sizeof (address.sun_path) - 1);
+
+ if ((connection = socket (AF_UNIX, SOCK_STREAM, 0)) < 0)
+   return (false);
+ if (connect (connection, (struct sockaddr *) &address, sizeof (address)) < 0) {
+   close (connection);
+   return (false);
+ }
+
+ requestSize = strlen (request);
+ request[requestSize] = '\n';   /* The terminating '\0' becomes the newline, for a single write */
+ bytes = write (connection, request, requestSize + 1);
+ request[requestSize] = '\0';
+ if (bytes != (ssize_t) (requestSize + 1)) {
+   close (connection);
+   return (false);
+ }
+
+ while ((bytes = read (connection, buffer, sizeof (buffer))) != 0) {
+   if (bytes < 0) {
+     if (errno == EINTR)
+       continue;
+     close (connection);
+     return (false);
+   }
+   if ((size_t) bytes >= MAX_REPLY_TAIL) {
+     memcpy (tail, buffer + bytes - MAX_REPLY_TAIL, MAX_REPLY_TAIL);
+     tailSize = MAX_REPLY_TAIL;
+   }
+   else {
+     if (tailSize + (size_t) bytes > 2 * MAX_REPLY_TAIL) {
+       memmove (tail, tail + tailSize - MAX_REPLY_TAIL, MAX_REPLY_TAIL);
+       tailSize = MAX_REPLY_TAIL;
+     }
+     memcpy (tail + tailSize, buffer, (size_t) bytes);
+     tailSize += (size_t) bytes;
+   }
+ }
+ close (connection);
+
+ tail[tailSize] = '\0';
+ if ((statusLine = strstr (tail, "#status ")) == NULL)
+   return (false);
+ *p_exitStatus = atoi (statusLine + strlen ("#status "));
+ return (true);
+}
+
+/*
+*---------------------------------------------------------------------
+* Order latencies for qsort()
+*---------------------------------------------------------------------
+*/
+
+static int compare_latencies (const void *p_a, const void *p_b)
+{
+ double
+   a = *(const double *) p_a,
+   b = *(const double *) p_b;
+
+ return ((a > b) - (a < b));
+}
+
+/*
+*---------------------------------------------------------------------
+* Latency below which a fraction of the requests fall (nearest rank),
+* once the latencies are sorted
+*---------------------------------------------------------------------
+*/
+
+static double percentile (double fraction)
+{
+ unsigned long int
+   rank;
+
+ rank = (unsigned long int) (fraction * (double) totRequests + 0.999999);
+ if (rank < 1)
+   rank = 1;
+ return (latencies[rank - 1]);
+}
+
+/*
+*---------------------------------------------------------------------
+* Main body of the program
+*---------------------------------------------------------------------
+*/
+
+int main (int argc, char *argv[])
+{
+ unsigned long int
+   iRequest,
+   totFailures = 0;
+ int
+   exitStatus;
+ double
+   totalMs,
+   sumMs = 0.0;
+ struct timespec
+   start,
+   stop,
+   requestStart,
+   requestStop;
+
+ process_commLine (argc, argv);
+ if ((latencies = malloc (totRequests * sizeof (double))) == NULL)
+   ERROR_no_memory (errno, progName, __func__, "latencies");
+
+ clock_gettime (CLOCK_MONOTONIC, &start);
+ for (iRequest = 0; iRequest < totRequests; iRequest++) {
+   clock_gettime (CLOCK_MONOTONIC, &requestStart);
+   if (! send_request (&exitStatus)) {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "No reply from a server on \"%s\"", socketName);
+     ERROR_fatal_error (errno, progName, __func__, ERROR_auxErrorMsg);
+   }
+   clock_gettime (CLOCK_MONOTONIC, &requestStop);
+   if (exitStatus != 0)
+     totFailures++;
+   latencies[iRequest] = elapsed_ms (&requestStart, &requestStop);
+   sumMs += latencies[iRequest];
+ }
+ clock_gettime (CLOCK_MONOTONIC, &stop);
+ totalMs = elapsed_ms (&start, &stop);
+
+ qsort (latencies, totRequests, sizeof (double), compare_latencies);
+ printf ("Requests      : %lu (%lu failed)\n", totRequests, totFailures);
+ printf ("Throughput    : %.1f requests/s\n", (double) totRequests * 1e3 / totalMs);
+ printf ("Latency (ms)  : mean %.3f, p50 %.3f, p99 %.3f, max %.3f\n",
+         sumMs / (double) totRequests, percentile (0.50), percentile (0.99), latencies[totRequests - 1]);
+
+ free (latencies);
+ free (socketName);
+ free (request);
+ return ((totFailures == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
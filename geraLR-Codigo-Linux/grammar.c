@@ -12,6 +12,8 @@
 *-----------------------------------------------------------------------
 */
 
+#define _POSIX_C_SOURCE 200112L
+
 /*
 *-----------------------------------------------------------------------
 * INCLUDE FILES
@@ -21,10 +23,16 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include "common.h"
 #include "error.h"
 #include "lexan.h"
+#include "gramscan.h"
 #include "datastructs.h"
 #include "grammar.h"
 
@@ -90,13 +98,31 @@ unsigned int
   totDFAitems       = 0,  /* Total number of DFA items, probably greater than the number of LR(0) items     */
   totDFAtransitions = 0;  /* Total number of DFA state transitions                                          */
 
+unsigned long int
+  cnt_grammarTokens           = 0,  /* Tokens read from the grammar file                               */
+  cnt_closureCalls            = 0,  /* Calls to dfa_closure()                                          */
+  cnt_closureSweeps           = 0,  /* Passes made by dfa_closure() over the items of a state          */
+  cnt_closureItemsAdded       = 0,  /* Items added to states by dfa_closure()                          */
+  cnt_gotoCalls               = 0,  /* Calls to dfa_gotoState()                                        */
+  cnt_gotoEmptyResults        = 0,  /* goto() states left with no items                                */
+  cnt_gotoDuplicateStates     = 0,  /* goto() states found to be duplicates of existing states         */
+  cnt_itemLookups             = 0,  /* Calls to newItem() that found an existing LR(0) item            */
+  cnt_itemCreations           = 0,  /* Calls to newItem() that created a new LR(0) item                */
+  cnt_nfaDuplicateTransitions = 0,  /* NFA transitions rejected by nfa_newTransition() as duplicates   */
+  cnt_dfaDuplicateTransitions = 0,  /* DFA transitions rejected by dfa_newTransition() as duplicates   */
+  cnt_firstSetIterations      = 0,  /* Iterations of the FIRST sets fixpoint                           */
+  cnt_followSetIterations     = 0;  /* Iterations of the FOLLOW sets fixpoint                          */
+
 /*
 *---------------------------------------------------------------------
 * Function prototypes
 *---------------------------------------------------------------------
 */
 
-void read_grammar (char *grammarFileName, char *progName, bool b_stripoff_quotes);
+void read_grammar         (char *grammarFileName, char *progName, bool b_stripoff_quotes, bool b_regex_scanner);
+void write_grammar_binary (const char *binaryFileName, const char *grammarFileName, bool b_stripoff_quotes);
+bool load_grammar_binary  (const char *binaryFileName, const char *grammarFileName, bool b_stripoff_quotes);
+unsigned int reduce_grammar (FILE *reportFilePt);
 
 /* Methods for grammar symbols and rules */
 
@@ -138,8 +164,9 @@ unsigned int  dfa_stateCode2totReductions (t_stateCode stateCode);
 t_ruleNumber  dfa_stateCode2reductionRule (t_stateCode stateCode, unsigned int reductionNumber);
 bool          dfa_isReductionState        (t_stateCode stateCode);
 t_stateCode   dfa_lookupNextState         (t_stateCode currStateCode, t_symbolCode transitionSymbol);
+bool          dfa_isNextStateIndexDense   (void);
 
-void          nfa_sortTransitions                     (t_transitionSortKey sortKey);
+unsigned int  nfa_sortedTransition2transitionNumber   (t_transitionSortKey sortKey, unsigned int position);
 t_stateCode   nfa_transitionNumber2originState        (unsigned int transitionNumber);
 t_symbolCode  nfa_transitionNumber2symbol             (unsigned int transitionNumber);
 t_stateCode   nfa_transitionNumber2destState          (unsigned int transitionNumber);
@@ -148,7 +175,7 @@ unsigned int  nfa_stateCode2totTransitionsFromState   (t_stateCode stateCode);
 unsigned int  nfa_stateCode2totTransitionsToState     (t_stateCode stateCode);
 t_symbolCode  nfa_stateCode2transitionSymbol          (t_stateCode stateCode, unsigned int transitionNumber);
 
-void          dfa_sortTransitions                            (t_transitionSortKey sortKey);
+unsigned int  dfa_sortedTransition2transitionNumber          (t_transitionSortKey sortKey, unsigned int position);
 t_stateCode   dfa_transitionNumber2originState               (unsigned int transitionNumber);
 t_symbolCode  dfa_transitionNumber2symbol                    (unsigned int transitionNumber);
 t_stateCode   dfa_transitionNumber2destState                 (unsigned int transitionNumber);
@@ -157,7 +184,9 @@ unsigned int  dfa_stateCode2totTransitionsFromStateFromState (t_stateCode stateC
 unsigned int  dfa_stateCode2totTransitionsFromStateToState   (t_stateCode stateCode);
 t_symbolCode  dfa_stateCode2transitionSymbol                 (t_stateCode stateCode, unsigned int transitionNumber);
 
-void build_LR0_items_NFA_and_DFA (void);
+void   build_LR0_items_NFA_and_DFA (void);
+void   dfa_renumberStates          (void);
+double dfa_meanTransitionSpan      (void);
 
 /* Methods for FIRST and FOLLOW sets */
 
@@ -214,10 +243,49 @@ int snprintf (char *str, size_t size, const char *format, ...);
 */
 
 #define MAX_CHARS_EACH_SYMBOL       50
-#define MAX_CHARS_ALL_SYMBOLS       20000
-#define MAX_SYMBOL_LEFTHAND_USES    100
-#define MAX_SYMBOL_RIGHTHAND_USES   MAX_RULES
+#define INITIAL_CHARS_ALL_SYMBOLS   4096
+#define SYMBOL_HASH_TABLE_SIZE      512   /* Power of two, at least twice MAX_TERMINALS + MAX_NON_TERMINALS */
 #define MAX_SYMBOLS_ALL_RIGHTHANDS  ((MAX_RULES)*(MAX_SYMBOLS_EACH_RIGHTHAND))
+#define MAX_RIGHTHAND_USES          ((MAX_SYMBOLS_ALL_RIGHTHANDS)+(MAX_RULES))  /* Epsilon rules count as one use each */
+
+#if SYMBOL_HASH_TABLE_SIZE < 2 * (MAX_TERMINALS + MAX_NON_TERMINALS)
+#error SYMBOL_HASH_TABLE_SIZE must be at least twice MAX_TERMINALS + MAX_NON_TERMINALS
+#endif
+
+/* Binary grammar files (.grb) */
+
+#define GRB_MAGIC                "geraLRgb"
+#define GRB_FORMAT_VERSION       2
+#define GRB_BYTE_ORDER           0x01020304
+#define GRB_FLAG_STRIPOFF_QUOTES 0x01
+#define GRB_FNV_OFFSET_BASIS     UINT64_C(14695981039346656037)
+#define GRB_FNV_PRIME            UINT64_C(1099511628211)
+#define GRB_MAX_NAME_IN_MESSAGE  900   /* Leaves room in ERROR_auxErrorMsg for the rest */
+
+typedef struct {                    /* How .grb files start:                        */
+  char     magic [8];               /*   GRB_MAGIC, without the '\0'                */
+  uint64_t sourceSize;              /*   size of the grammar file...                */
+  uint64_t sourceHash;              /*   ...and FNV-1a hash of its contents         */
+  uint64_t payloadSize;             /*   size of everything after the header...     */
+  uint64_t payloadHash;             /*   ...and its FNV-1a hash                     */
+  uint32_t version;                 /*   GRB_FORMAT_VERSION                         */
+  uint32_t byteOrder;               /*   GRB_BYTE_ORDER as written by this machine  */
+  uint32_t headerSize;              /*   sizeof (t_grbHeader)                       */
+  uint32_t flags;                   /*   options that change the grammar read in    */
+  uint32_t maxTerminals;            /*   compile-time limits of the program         */
+  uint32_t maxNonTerminals;         /*                                              */
+  uint32_t maxRules;                /*                                              */
+  uint32_t maxSymbolsEachRighthand; /*                                              */
+  uint32_t maxCharsEachSymbol;      /*                                              */
+  uint32_t totTerminals;            /*   sizes of the arrays in the payload         */
+  uint32_t totNonTerminals;         /*                                              */
+  uint32_t totRules;                /*                                              */
+  uint32_t totRighthandSymbols;     /*                                              */
+  uint32_t totSymbolChars;          /*                                              */
+  int32_t  initialSymbolCode;       /*   codes of the augmented grammar's symbols   */
+  int32_t  endOfInputCode;          /*                                              */
+}
+  t_grbHeader;
 
 /* Some pre-defined symbol codes */
 
@@ -252,9 +320,9 @@ typedef struct {
   t_symbolCode symbolCode;
   unsigned int posFirstChar;                               /* Position in array symbolNames of symbol's 1st char        */
   unsigned int totLefthandUses;                            /* Number of rules with this symbol in the lefthand side...  */
-  unsigned int lefthandUses [MAX_SYMBOL_LEFTHAND_USES];    /* ...and these are the rules above                          */
+  unsigned int firstLefthandUse;                           /* ...and where they start in array lefthandUses             */
   unsigned int totRighthandUses;                           /* Number of rules with this symbol in the righthand side... */
-  unsigned int righthandUses [MAX_SYMBOL_RIGHTHAND_USES];  /* ...and these are the rules above                          */
+  unsigned int firstRighthandUse;                          /* ...and where they start in array righthandUses            */
   DATA_t_set_code   firstSet;                              /* Numeric code of the FIRST set                             */
   DATA_t_set_code   followSet;                             /* Numeric code of the FOLLOW set                            */
   unsigned int totNFAtransitionsWithSymbol;                /* Number of NFA and DFA transitions...                      */
@@ -272,13 +340,31 @@ static t_symbolCode                             /* Righthand sides of all  */
   righthandSides [MAX_SYMBOLS_ALL_RIGHTHANDS],  /* rules appended together */
   initialSymbolCode;
 
+/* Rules where each symbol is used, as built by build_rule_use_index(): */
+/* the rules of each symbol are a run of these arrays, in rule order,   */
+/* with every rule appearing once per symbol however many times the    */
+/* symbol occurs in it. Rules are numbered from 0.                      */
+
+static unsigned int
+  lefthandUses  [MAX_RULES],
+  righthandUses [MAX_RIGHTHAND_USES];
+
 static char                              /* Strings of all terminals and    */
-  symbolNames [MAX_CHARS_ALL_SYMBOLS];   /* non-terminals appended together */
+  *symbolNames = NULL;                   /* non-terminals appended together */
+
+static size_t
+  maxSymbolChars   = 0;   /* Current size of array symbolNames, grown as needed */
 
 static unsigned int
   nextSymbolChar   = 0,   /* Next available position in array symbolNames */
   nextRighthandPos = 0;   /* Total number of terminals                    */
 
+/* Open-addressing hash table of the terminals and non-terminals read so */
+/* far, indexed by a hash of their strings; free slots hold EPSILON_CODE */
+
+static t_symbolCode
+  symbolHashTable [SYMBOL_HASH_TABLE_SIZE];
+
 static char
   epsilonString       [MAX_CHARS_EACH_SYMBOL],
   endOfInputString    [MAX_CHARS_EACH_SYMBOL],
@@ -303,8 +389,7 @@ static size_t
 #define MAX_TRANSITIONS_PER_NFA_STATE  (MAX_RULES)
 
 #define MAX_DFA_TRANSITIONS            (MAX_LR0_ITEMS)
-#define MAX_ITEMS_PER_DFA_STATE        (MAX_RULES)    /* This is an estimate */
-#define MAX_TRANSITIONS_PER_DFA_STATE  (MAX_ITEMS_PER_DFA_STATE)
+#define INITIAL_DFA_POOL_SIZE          4096
 
 #define UNKNOWN_TRANSITION_INDEX      -2
 #define UNKNOWN_ITEM_INDEX            -1
@@ -344,15 +429,24 @@ static char
 /* Each LR(0) item is stored exactly once, though it may */
 /* occur in several states both in the NFA and the DFA   */
 
-typedef struct {              /* How LR(0) items are stored: */
-  t_ruleNumber  ruleNumber;   /*   the rule number and       */
-  t_dotPosition dotPosition;  /*   the position of the dot   */
+typedef struct {                 /* How LR(0) items are stored:                          */
+  t_ruleNumber  ruleNumber;      /*   the rule number and                                */
+  t_dotPosition dotPosition;     /*   the position of the dot, plus what follows from    */
+  t_symbolCode  transitionSymbol;/*   them: the symbol after the dot (EPSILON_CODE for   */
+                                 /*   an empty rule, UNKNOWN_SYMBOL_CODE if at the end)  */
+  bool          isReduction;     /*   and whether the dot is at the end                  */
 }
   t_LR0item;
 
 static t_LR0item
   LR0items [MAX_LR0_ITEMS];
 
+/* Numeric codes of the LR(0) items created so far, indexed by rule number  */
+/* (minus one) and dot position, or UNKNOWN_ITEM_CODE if not created yet    */
+
+static t_itemCode
+  ruleDot2itemCode [MAX_RULES][MAX_SYMBOLS_EACH_RIGHTHAND+1];
+
 /* In a NFA each state contains exactly one item, but possibly several transitions     */
 /* (at most one with a terminal or non-terminal and maybe several epsilon transitions) */
 
@@ -361,27 +455,51 @@ typedef struct {                       /* How NFA states are stored:
   int          itemIndex;              /*   position of item in LR0items[]        */
   unsigned int totInwardTransitions;   /*   number of transitions into this state */
   unsigned int totOutwardTransitions;  /*   number of transitions from this state */
+  unsigned int firstOrderedTransition; /*   position of its first transition in   */
+                                       /*   NFAorderedTransitions[]               */
 }
   t_NFAstate;
 
 static t_NFAstate
   NFAstates [MAX_NFA_STATES];
 
-/* In a DFA each state may contain several items, so    */
-/* the automaton requires a more complex data structure */
+/* Numeric code of the NFA state holding each LR(0) item, indexed by item position in LR0items[] */
 
-typedef struct {                                            /* How DFA states are stored:                             */
-  t_stateType  stateType;                                   /*   shift, reduce, shift_reduce or reduce_reduce         */
-  unsigned int itemsInState;                                /*   number of LR(0) items                                */
-  int          itemIndex [MAX_ITEMS_PER_DFA_STATE];         /*   positions of items in LR0items[]                     */
-  unsigned int totInwardTransitions;                        /*   number of transitions into this state                */
-  unsigned int totTransitionSymbols;                        /*   number of distinct symbols immediately after the dot */
-  t_symbolCode transitionSymbols [MAX_ITEMS_PER_DFA_STATE]; /*   list of symbol codes, as above                       */
-}
-  t_DFAstate;
+static t_stateCode
+  itemIndex2nfaStateCode [MAX_LR0_ITEMS];
 
-static t_DFAstate
-  DFAstates [MAX_DFA_STATES];
+/* In a DFA each state may contain several items. The data of each state is   */
+/* kept in parallel arrays indexed by state code minus DFA_STATE_START_CODE,    */
+/* while its items and its transition symbols are runs of two pools shared by   */
+/* all states. Items are only ever added to the state created last, and only    */
+/* that state is ever removed, so both pools always end with its runs.          */
+/*                                                                              */
+/* DFAitems[] keeps the items of a state in the order they were added, which   */
+/* is the order reports list them in. DFAsortedItems[] holds the same run in    */
+/* ascending order, so two states are equal exactly when their sorted runs are  */
+/* equal, and a fingerprint of the item set tells most states apart at once.    */
+
+static t_stateType
+  DFAstateType [MAX_DFA_STATES];             /* shift, reduce, shift_reduce or reduce_reduce              */
+static unsigned int
+  DFAstateTotItems [MAX_DFA_STATES],         /* number of LR(0) items                                     */
+  DFAstateFirstItem [MAX_DFA_STATES],        /* position of its first item in DFAitems[]                  */
+  DFAstateTotInward [MAX_DFA_STATES],        /* number of transitions into this state                     */
+  DFAstateTotSymbols [MAX_DFA_STATES],       /* number of distinct symbols immediately after the dot      */
+  DFAstateFirstSymbol [MAX_DFA_STATES];      /* position of the first of them in DFAtransitionSymbols[]   */
+static uint64_t
+  DFAstateFingerprint [MAX_DFA_STATES];      /* sum of the mixed item positions; order-independent        */
+
+static int
+  *DFAitems = NULL,                          /* positions of items in LR0items[], state after state        */
+  *DFAsortedItems = NULL;                    /* the same runs, each sorted in ascending order              */
+static t_symbolCode
+  *DFAtransitionSymbols = NULL;              /* transition symbols, sorted within each state               */
+static unsigned int
+  nextDFAitem           = 0,                 /* Next available position in DFAitems[]                      */
+  maxDFAitems           = 0,
+  nextDFAsymbol         = 0,                 /* Next available position in DFAtransitionSymbols[]          */
+  maxDFAsymbols         = 0;
 
 /* State transitions are represented in the same way in both types of automata */
 
@@ -396,6 +514,45 @@ static t_stateTransition
   NFAtransitions [MAX_NFA_TRANSITIONS],
   DFAtransitions [MAX_DFA_TRANSITIONS];
 
+/* Numbers (1 onwards) of the transitions from each NFA state, grouped by state of  */
+/* origin: the transition with a terminal or non-terminal first, then the epsilon   */
+/* transitions sorted by the rule number of their destination states. They must be */
+/* worked out again by nfa_orderTransitions() whenever NFAtransitions[] changes.    */
+
+static unsigned int
+  NFAorderedTransitions [MAX_NFA_TRANSITIONS];
+
+/* Transition numbers (1 onwards) in the order of each sort key, so that    */
+/* NFAtransitions[] and DFAtransitions[] never have to be reordered and a   */
+/* transition number always means the same transition. Each set of views is */
+/* built on first use and dropped whenever a transition is added.           */
+
+static unsigned int
+  NFAtransitionViews [t_transitionSortKey_total][MAX_NFA_TRANSITIONS],
+  DFAtransitionViews [t_transitionSortKey_total][MAX_DFA_TRANSITIONS];
+static bool
+  b_NFAtransitionViewsBuilt = false,
+  b_DFAtransitionViewsBuilt = false;
+
+/* Next state of each DFA state on each symbol, for dfa_lookupNextState(). The */
+/* dense form is a matrix with one row per state and one column per parse      */
+/* table column. When that would take more than MAX_DENSE_NEXT_STATE_CELLS     */
+/* cells, the sparse form keeps the transitions of each state together instead */
+/* and a lookup scans the state's own transitions. Built on first use and      */
+/* dropped whenever a transition is added or the states are renumbered.        */
+
+#define MAX_DENSE_NEXT_STATE_CELLS  (1U << 20)
+
+static t_stateCode
+  *DFAnextStateMatrix = NULL;        /* dense form, row after row                       */
+static unsigned int
+  *DFAnextStateFirst  = NULL,        /* sparse form: first position of each state's run */
+  *DFAnextStateRuns   = NULL,        /* sparse form: transition numbers, state by state */
+  DFAnextStateCols    = 0;
+static bool
+  b_DFAnextStateIndexBuilt = false,
+  b_DFAnextStateIndexDense = false;
+
 static unsigned int
   nextLR0item       = 0,   /* Next available position in array LR0items       */
   nfa_nextState     = 0,   /* Next available position in array NFAstates      */
@@ -429,23 +586,55 @@ size_t
 *-----------------------------------------------------------------------
 */
 
-struct t_parseActionList {
-  t_parseAction parseAction;
-  struct t_parseActionList *p_nextParseAction;
-};
+/* The parse actions of each table live in a single array. While the */
+/* table is being built, the actions of a cell are chained through    */
+/* nextParseAction, newest first; once it is built they are packed   */
+/* so that those of a cell sit together, starting at posFirstAction. */
 
 struct t_parseTableEntry {
   unsigned int totParseActions;
-  struct t_parseActionList *p_parseActionList;
+  unsigned int posFirstAction;
 };
 
-#define MAX_TABLE_SYMBOLS   ((MAX_TERMINALS) + (MAX_NON_TERMINALS) + 1)
-#define MAX_TABLE_STATES    MAX_DFA_STATES
+typedef struct {
+  t_parseAction *parseActions;
+  unsigned int  *nextParseAction;
+  unsigned int   totParseActions;
+  unsigned int   maxParseActions;
+}
+  t_parseActionArena;
 
-struct t_parseTableEntry
-   LR0parseTable [MAX_TABLE_STATES][MAX_TABLE_SYMBOLS],
-  sLR1parseTable [MAX_TABLE_STATES][MAX_TABLE_SYMBOLS],
-  diffParseTable [MAX_TABLE_STATES][MAX_TABLE_SYMBOLS];
+#define MAX_TABLE_SYMBOLS      ((MAX_TERMINALS) + (MAX_NON_TERMINALS) + 1)
+#define MAX_TABLE_STATES       MAX_DFA_STATES
+#define INITIAL_PARSE_ACTIONS  1024
+
+typedef struct t_parseTableEntry
+  t_parseTableRow [MAX_TABLE_SYMBOLS];
+
+t_parseTableRow
+   LR0parseTable [MAX_TABLE_STATES],
+  sLR1parseTable [MAX_TABLE_STATES];
+
+static t_parseActionArena
+   LR0parseActions,
+  sLR1parseActions;
+
+/* The differences table is sparse: it only holds the actions of the   */
+/* LR(0) table that the sLR(1) table lacks, row after row, each row    */
+/* starting at diffParseRowStart and each cell's actions kept together */
+
+typedef struct {
+  unsigned int  tableCol;
+  t_parseAction parseAction;
+}
+  t_diffParseAction;
+
+static t_diffParseAction
+  *diffParseActions = NULL;
+static unsigned int
+  totDiffParseActions = 0,
+  maxDiffParseActions = 0,
+  diffParseRowStart [MAX_TABLE_STATES + 1];
 
 /*
 *-----------------------------------------------------------------------
@@ -474,7 +663,16 @@ t_parseTableSummary
 *---------------------------------------------------------------------
 */
 
-static void set_string_lengths (void);
+static void set_string_lengths   (void);
+static void init_grammar_data    (void);
+static void build_rule_use_index (void);
+static void print_rule           (FILE *filePt, unsigned int ruleIndex);
+static void rebuild_grammar      (const bool b_liveRule []);
+
+static uint64_t      fnv1a_hash     (const void *data, size_t dataSize, uint64_t hash);
+static void         *map_file       (const char *fileName, size_t *p_fileSize);
+static bool          grb_set_header (t_grbHeader *p_header, const char *grammarFileName, bool b_stripoff_quotes);
+static t_symbolData *grb_symbolData (unsigned int recordNumber);
 
 static void validateToken (
  LEXAN_t_tokenType tokenExpected,
@@ -486,17 +684,17 @@ static void validateToken (
 
 static int          symbolCode2symbolNumber (t_symbolCode symbolCode);
 static t_symbolCode symbolStr2Code          (char *symbolStr);
+static unsigned int symbolStr2hashSlot      (const char *symbolStr);
+static unsigned int add_symbol_name         (const char *symbolStr, t_symbolCode symbolCode);
 
 static t_symbolCode add_terminal (
  LEXAN_t_tokenVal    tokenVal,
  t_whereInRule whereInRule,
- unsigned int  ruleNumber,
  bool          b_stripoff_quotes );
 
 static t_symbolCode add_nonTerminal (
  char         *symbolStr,
- t_whereInRule whereInRule,
- unsigned int  ruleNumber );
+ t_whereInRule whereInRule );
 
 static void add_rule (
  unsigned int ruleNumber,
@@ -514,24 +712,24 @@ static t_stateCode  nfa_newEmptyState                (void);
 static void         nfa_newTransition                (t_stateCode fromState, t_symbolCode withSymbol, t_stateCode toState);
 static bool         nfa_addItemToState               (t_itemCode itemCode, t_stateCode stateCode);
 static bool         nfa_isEmptyState                 (t_stateCode stateCode);
+static void         nfa_orderTransitions             (void);
+static void         build_transition_views           (const t_stateTransition *transitions, unsigned int totTransitions, unsigned int *views, unsigned int maxTransitions);
 
 static t_stateCode  dfa_newEmptyState                (void);
 static void         dfa_newTransition                (t_stateCode fromState, t_symbolCode withSymbol, t_stateCode toState);
 static bool         dfa_addItemToState               (t_itemCode itemCode, t_stateCode stateCode);
 static bool         dfa_isEmptyState                 (t_stateCode stateCode);
-static bool         dfa_isDuplicateState             (t_stateCode stateCode);
+static uint64_t     dfa_itemFingerprint              (int itemIndex);
+static bool         dfa_areSameState                 (unsigned int stateIndex1, unsigned int stateIndex2);
 static t_stateCode  dfa_stateCode2duplicateStateCode (t_stateCode stateCode);
 static void         dfa_removeState                  (t_stateCode stateCode);
 static t_stateCode  dfa_gotoState                    (t_stateCode currStateCode, t_symbolCode transitionSymbol);
 static void         dfa_closure                      (t_stateCode stateCode);
+static void         dfa_buildNextStateIndex          (void);
+static void         permute_array                    (void *array, size_t elementSize, unsigned int totElements, const unsigned int *oldIndexAt);
 
 static int compare_symbolCodes                 (const void *p1, const void *p2);
-/*
-static int compare_LR0items                    (const void *p1, const void *p2);
-*/
-static int compare_transitions_key_origin      (const void *p1, const void *p2);
-static int compare_transitions_key_symbol      (const void *p1, const void *p2);
-static int compare_transitions_key_destination (const void *p1, const void *p2);
+static int compare_transitions_dest_rule       (const void *p1, const void *p2);
 
 /* Methods for FIRST and FOLLOW sets */
 
@@ -552,6 +750,15 @@ static void clear_SET       (t_extSetType setType,        t_symbolCode symbolCod
 static unsigned int stateCode2parseTableRow  (t_stateCode stateCode);
 static unsigned int symbolCode2parseTableCol (t_symbolCode symbolCode);
 
+static t_parseTableRow    *parseTableType2parseTable   (t_parse_table_type parse_table_type);
+static t_parseActionArena *parseTableType2parseActions (t_parse_table_type parse_table_type);
+static void init_parse_table (t_parse_table_type parse_table_type);
+static void pack_parse_table (t_parse_table_type parse_table_type);
+static void free_parse_table (t_parse_table_type parse_table_type);
+
+static unsigned int diffParseTablePos     (unsigned int tableRow, unsigned int tableCol, unsigned int *p_posFirstAction);
+static void         add_diff_parse_action (unsigned int tableRow, unsigned int tableCol, t_parseAction parseAction);
+
 static void addParseAction (
   t_parse_table_type parse_table_type,
   t_stateCode        stateCode,
@@ -575,37 +782,18 @@ static int compare_symbolCodes (const void *p1, const void *p2)
  return (*(t_symbolCode *) p1 - *(t_symbolCode *) p2);
 }
 
-/*
-static int compare_LR0items (const void *p1, const void *p2)
-{
- t_LR0item
-   item1,
-   item2;
- int
-   result;
-
- item1 = LR0items[*(int *) p1];
- item2 = LR0items[*(int *) p2];
- result = (int) item1.ruleNumber - item2.ruleNumber;
- if (result == 0)
-   result = (int) item1.dotPosition - item2.dotPosition;
- return (result);
-}
-*/
-
-static int compare_transitions_key_origin (const void *p1, const void *p2)
-{
- return (((t_stateTransition *) p1)->fromState - ((t_stateTransition *) p2)->fromState);
-}
+/* Compares NFA transition numbers by the rule in their destination states */
 
-static int compare_transitions_key_symbol (const void *p1, const void *p2)
+static int compare_transitions_dest_rule (const void *p1, const void *p2)
 {
- return (((t_stateTransition *) p1)->withSymbol - ((t_stateTransition *) p2)->withSymbol);
-}
+ t_stateCode
+   toState1,
+   toState2;
 
-static int compare_transitions_key_destination (const void *p1, const void *p2)
-{
- return (((t_stateTransition *) p1)->toState - ((t_stateTransition *) p2)->toState);
+ toState1 = NFAtransitions[*(unsigned int *) p1 - 1].toState;
+ toState2 = NFAtransitions[*(unsigned int *) p2 - 1].toState;
+ return ((int) LR0items[NFAstates[toState1 - NFA_STATE_START_CODE].itemIndex].ruleNumber -
+         (int) LR0items[NFAstates[toState2 - NFA_STATE_START_CODE].itemIndex].ruleNumber);
 }
 
 /*
@@ -710,13 +898,60 @@ static void validateToken (
  ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
 }
 
+/*
+*---------------------------------------------------------------------
+* Clear the grammar data structures before a grammar is read or loaded
+*---------------------------------------------------------------------
+*/
+
+static void init_grammar_data (void)
+{
+ memset (&grammarRules,         0, sizeof (grammarRules));
+ memset (&terminals,            0, sizeof (terminals));
+ memset (&nonTerminals,         0, sizeof (nonTerminals));
+ memset (&endOfInputUsage,      0, sizeof (endOfInputUsage));
+ memset (&epsilonUsage,         0, sizeof (epsilonUsage));
+ memset (&righthandSides,       0, sizeof (righthandSides));
+ memset (&symbolHashTable,      0, sizeof (symbolHashTable));
+ memset (&LR0items,             0, sizeof (LR0items));
+ memset (&DFAstateType,         0, sizeof (DFAstateType));
+ memset (&DFAstateTotItems,     0, sizeof (DFAstateTotItems));
+ memset (&DFAstateFirstItem,    0, sizeof (DFAstateFirstItem));
+ memset (&DFAstateTotInward,    0, sizeof (DFAstateTotInward));
+ memset (&DFAstateTotSymbols,   0, sizeof (DFAstateTotSymbols));
+ memset (&DFAstateFirstSymbol,  0, sizeof (DFAstateFirstSymbol));
+ memset (&DFAstateFingerprint,  0, sizeof (DFAstateFingerprint));
+ nextDFAitem = nextDFAsymbol = 0;
+ memset (&DFAtransitions,       0, sizeof (DFAtransitions));
+ b_NFAtransitionViewsBuilt = b_DFAtransitionViewsBuilt = false;
+ b_DFAnextStateIndexBuilt = false;
+ totRules = totTerminals = totNonTerminals = 0;
+ nextSymbolChar = nextRighthandPos = 0;
+
+ if ((strcpy (epsilonString, EPSILON_STR)) == NULL) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "strcpy (epsilonString ,\"%s\") failed", EPSILON_STR);
+   ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+ }
+ if ((strcpy (endOfInputString, ENDOFINPUT_STR)) == NULL) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "strcpy (endOfInputString ,\"%s\") failed", ENDOFINPUT_STR);
+   ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+ }
+
+ epsilon_code        = EPSILON_CODE;
+ rule_arrow_code     = RULE_ARROW_CODE;
+ item_dot_code       = DOT_CODE;
+ unknown_symbol_code = UNKNOWN_SYMBOL_CODE;
+ end_of_input_code   = UNKNOWN_SYMBOL_CODE;
+ initialSymbolCode   = UNKNOWN_SYMBOL_CODE;
+}
+
 /*
 *---------------------------------------------------------------------
 * Read the grammar file and populate various data structures
 *---------------------------------------------------------------------
 */
 
-void read_grammar (char *grammarFileName, char *progName, bool b_stripoff_quotes)
+void read_grammar (char *grammarFileName, char *progName, bool b_stripoff_quotes, bool b_regex_scanner)
 {
  #define REGEX_ARROW_1     "\\(->\\)"
  #define REGEX_ARROW_2     "\\(:=\\)"
@@ -752,9 +987,10 @@ void read_grammar (char *grammarFileName, char *progName, bool b_stripoff_quotes
  t_symbolCode
    currLefthandSymbol = UNKNOWN_SYMBOL_CODE;
  bool
-   tokenOK;
+   tokenOK,
+   b_gramscan;
  LEXAN_t_lexJobId
-   jobId;
+   jobId = 0;
  LEXAN_t_tokenType
    token;
  unsigned int
@@ -765,16 +1001,7 @@ void read_grammar (char *grammarFileName, char *progName, bool b_stripoff_quotes
 
  /* Some initializations */
 
- memset (&grammarRules,         0, sizeof (grammarRules));
- memset (&terminals,            0, sizeof (terminals));
- memset (&nonTerminals,         0, sizeof (nonTerminals));
- memset (&endOfInputUsage,      0, sizeof (endOfInputUsage));
- memset (&epsilonUsage,         0, sizeof (epsilonUsage));
- memset (&righthandSides,       0, sizeof (righthandSides));
- memset (&symbolNames,          0, sizeof (symbolNames));
- memset (&LR0items,             0, sizeof (LR0items));
- memset (&DFAstates,            0, sizeof (DFAstates));
- memset (&DFAtransitions,       0, sizeof (DFAtransitions));
+ init_grammar_data();
 
  memset (&tokenVal,             0, sizeof (LEXAN_t_tokenVal));
  tokenVal.tokenStr = NULL;
@@ -791,22 +1018,6 @@ void read_grammar (char *grammarFileName, char *progName, bool b_stripoff_quotes
  memset ( currLefthandTokenStr, 0, MAX_CHARS_EACH_SYMBOL);
  currLefthandTokenVal.tokenStr = currLefthandTokenStr;
 
- if ((strcpy (epsilonString, EPSILON_STR)) == NULL) {
-   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "strcpy (epsilonString ,\"%s\") failed", EPSILON_STR);
-   ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
- }
- if ((strcpy (endOfInputString, ENDOFINPUT_STR)) == NULL) {
-   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "strcpy (endOfInputString ,\"%s\") failed", ENDOFINPUT_STR);
-   ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
- }
-
- epsilon_code        = EPSILON_CODE;
- rule_arrow_code     = RULE_ARROW_CODE;
- item_dot_code       = DOT_CODE;
- unknown_symbol_code = UNKNOWN_SYMBOL_CODE;
- end_of_input_code   = UNKNOWN_SYMBOL_CODE;
- initialSymbolCode   = UNKNOWN_SYMBOL_CODE;
-
  /* AUGMENTING THE GRAMMAR:                                               */
  /*                                                                       */
  /* Reserve position 0 in the rules array for the initial rule _E_ -> E $ */
@@ -817,14 +1028,18 @@ void read_grammar (char *grammarFileName, char *progName, bool b_stripoff_quotes
  totRules = 1;
  token = LEXAN_token_EOF;
 
- /* Get the lexical analyser started */
+ /* Get the lexical analyser started: the hand-written scanner in gramscan.c */
+ /* unless the user asked for LEXAN or the file cannot be mapped into memory */
 
- jobId = LEXAN_start_job (
-   (char *)         grammarFileName,
-   (reg_syntax_t)   LEXAN_REGEX_SYNTAX,
-   (LEXAN_t_tokenCase)    LEXAN_t_keepCase,
-   (int)            totTokenSpecs,
-   (LEXAN_t_tokenSpecs *) tokenSpecs );
+ cnt_grammarTokens = 0;
+ b_gramscan = (! b_regex_scanner) && GRAMSCAN_start_job (grammarFileName);
+ if (! b_gramscan)
+   jobId = LEXAN_start_job (
+     (char *)         grammarFileName,
+     (reg_syntax_t)   LEXAN_REGEX_SYNTAX,
+     (LEXAN_t_tokenCase)    LEXAN_t_keepCase,
+     (int)            totTokenSpecs,
+     (LEXAN_t_tokenSpecs *) tokenSpecs );
 
  while (true) {
 
@@ -834,27 +1049,37 @@ void read_grammar (char *grammarFileName, char *progName, bool b_stripoff_quotes
    totGrammarSymbols = totTerminals + totNonTerminals;
    totFSAsymbols = totGrammarSymbols + 3;
 
-   switch (token) {
-     case (LEXAN_token_single_str):
-     case (LEXAN_token_double_str):
-     case (LEXAN_token_iden)      :
-     case (LEXAN_token_resWord)   :
-       if (tokenVal.tokenStr) {
-         free (tokenVal.tokenStr);
-         tokenVal.tokenStr = NULL;
-       }
-     default:
-       break;
+   if (b_gramscan)
+     tokenOK = GRAMSCAN_get_token ((LEXAN_t_tokenType *) &token, (LEXAN_t_tokenVal *) &tokenVal);
+   else {
+     switch (token) {
+       case (LEXAN_token_single_str):
+       case (LEXAN_token_double_str):
+       case (LEXAN_token_iden)      :
+       case (LEXAN_token_resWord)   :
+         if (tokenVal.tokenStr) {
+           free (tokenVal.tokenStr);
+           tokenVal.tokenStr = NULL;
+         }
+       default:
+         break;
+     }
+     tokenOK = LEXAN_get_token ((LEXAN_t_lexJobId) jobId, (LEXAN_t_tokenType *) &token, (LEXAN_t_tokenVal *) &tokenVal);
    }
-   tokenOK = LEXAN_get_token ((LEXAN_t_lexJobId) jobId, (LEXAN_t_tokenType *) &token, (LEXAN_t_tokenVal *) &tokenVal);
    if (! tokenOK) {
-     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "%s\n", LEXAN_get_error_descr (jobId));
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "%s\n", b_gramscan ? GRAMSCAN_get_error_descr() : LEXAN_get_error_descr (jobId));
      ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
    }
+   if (token != LEXAN_token_EOF)
+     cnt_grammarTokens++;
    if (currState == 0) {   /* Acceptable values are: non-terminal or end of file */
      switch (token) {
        case (LEXAN_token_EOF):
-         (void) LEXAN_terminate_job (jobId);
+         if (b_gramscan)
+           GRAMSCAN_terminate_job();
+         else
+           (void) LEXAN_terminate_job (jobId);
+         build_rule_use_index();
          set_string_lengths();
          return;
        case (LEXAN_token_iden):   /* It is a non-terminal */
@@ -886,11 +1111,11 @@ void read_grammar (char *grammarFileName, char *progName, bool b_stripoff_quotes
 
            /* STEP 2: Add the non-terminal _E_ to the lefthand side of rule 0 */
 
-           initialSymbolCode = add_nonTerminal (initialSymbolString, t_lefthand, 0);
+           initialSymbolCode = add_nonTerminal (initialSymbolString, t_lefthand);
 
            /* STEP 3: Add the non-terminal E to the righthand side of rule 0 */
 
-           (void) add_nonTerminal (tokenVal.tokenStr, t_righthand, 0);
+           (void) add_nonTerminal (tokenVal.tokenStr, t_righthand);
 
            /* STEP 4: Add the terminal $ to the righthand side of rule 0 */
 
@@ -898,7 +1123,7 @@ void read_grammar (char *grammarFileName, char *progName, bool b_stripoff_quotes
              snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "strcpy (endOfInputTokenVal.tokenStr ,\"%s\") failed", endOfInputString);
              ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
            }
-           end_of_input_code = add_terminal (endOfInputTokenVal, t_righthand, 0, b_stripoff_quotes);
+           end_of_input_code = add_terminal (endOfInputTokenVal, t_righthand, b_stripoff_quotes);
 
            /*   STEP 5: Add the rule  _E_ -> E $ */
 
@@ -907,7 +1132,7 @@ void read_grammar (char *grammarFileName, char *progName, bool b_stripoff_quotes
 
          /* Add the non-terminal to the lefthand side of the next rule */
 
-         currLefthandSymbol = add_nonTerminal (tokenVal.tokenStr, t_lefthand, totRules);
+         currLefthandSymbol = add_nonTerminal (tokenVal.tokenStr, t_lefthand);
          startCurrRighthand = nextRighthandPos;
          currLefthandTokenVal = tokenVal;
          currLefthandTokenVal.tokenStr = currLefthandTokenStr;
@@ -939,12 +1164,12 @@ void read_grammar (char *grammarFileName, char *progName, bool b_stripoff_quotes
    else if (currState == 2) {   /* Acceptable values are: terminal, non-terminal, "|" or ";" */
      switch (token) {
        case (LEXAN_token_iden):
-         (void) add_nonTerminal (tokenVal.tokenStr, t_righthand, totRules);
+         (void) add_nonTerminal (tokenVal.tokenStr, t_righthand);
          sizeCurrRule++;
          break;
        case (LEXAN_token_single_str):
        case (LEXAN_token_double_str):
-         (void) add_terminal (tokenVal, t_righthand, totRules, b_stripoff_quotes);
+         (void) add_terminal (tokenVal, t_righthand, b_stripoff_quotes);
          sizeCurrRule++;
          break;
        case (LEXAN_token_delim):   /* Either "|" or ";" */
@@ -962,7 +1187,7 @@ void read_grammar (char *grammarFileName, char *progName, bool b_stripoff_quotes
            currState = 0;
          }
          else if (tokenVal.delimChar == '|') {
-           (void) add_nonTerminal (currLefthandTokenVal.tokenStr, t_lefthand, totRules);
+           (void) add_nonTerminal (currLefthandTokenVal.tokenStr, t_lefthand);
          }
          else {
            snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "State %u, rule %u: Invalid token %d while processing symbol %u", currState, totRules+1, token, sizeCurrRule);
@@ -1036,6 +1261,674 @@ static void set_string_lengths (void)
  avgGrammarSymbolLength = (float) totGrammarSymbolLength / (totTerminals+totNonTerminals+1);
 }
 
+/*
+*---------------------------------------------------------------------
+* Binary grammar files (.grb)
+*
+* A .grb file holds a grammar exactly as read_grammar() leaves it,
+* so that it can be loaded again with a single mmap. It starts with
+* a t_grbHeader, followed by arrays of 32-bit values, all of them as
+* long as the header says:
+*
+*   rules          totRules x {lefthand symbol, righthand size, position}
+*   righthands     totRighthandSymbols symbol codes
+*   symbols        totTerminals + totNonTerminals + 2 records of
+*                  {code, position of string}, for terminals,
+*                  non-terminals, end-of-input and epsilon
+*
+* and then the characters of all symbol strings and the initial symbol.
+* The header records the size and hash of the grammar file it was
+* built from, and the compile-time limits, so stale or incompatible
+* files are detected and rebuilt rather than loaded. The rules where
+* each symbol is used are not stored: they are worked out again from
+* the rules on loading.
+*---------------------------------------------------------------------
+*/
+
+static uint64_t fnv1a_hash (const void *data, size_t dataSize, uint64_t hash)
+{
+ const unsigned char
+   *p_byte;
+
+ for (p_byte = (const unsigned char *) data; dataSize > 0; p_byte++, dataSize--) {
+   hash ^= *p_byte;
+   hash *= GRB_FNV_PRIME;
+ }
+ return (hash);
+}
+
+/*
+*---------------------------------------------------------------------
+* Map a whole file into memory for reading; return NULL if impossible
+*---------------------------------------------------------------------
+*/
+
+static void *map_file (const char *fileName, size_t *p_fileSize)
+{
+ int
+   fileDescr;
+ struct stat
+   fileStat;
+ void
+   *p_mapped;
+
+ if ((fileDescr = open (fileName, O_RDONLY)) < 0)
+   return (NULL);
+ if ((fstat (fileDescr, &fileStat) != 0) || (! S_ISREG (fileStat.st_mode)) || (fileStat.st_size == 0)) {
+   (void) close (fileDescr);
+   return (NULL);
+ }
+ p_mapped = mmap (NULL, (size_t) fileStat.st_size, PROT_READ, MAP_PRIVATE, fileDescr, 0);
+ (void) close (fileDescr);
+ if (p_mapped == MAP_FAILED)
+   return (NULL);
+ *p_fileSize = (size_t) fileStat.st_size;
+ return (p_mapped);
+}
+
+/*
+*---------------------------------------------------------------------
+* Fill in the fields of a .grb header that do not depend on the
+* grammar itself: format, limits and the grammar file it comes from
+*---------------------------------------------------------------------
+*/
+
+static bool grb_set_header (t_grbHeader *p_header, const char *grammarFileName, bool b_stripoff_quotes)
+{
+ void
+   *p_source;
+ size_t
+   sourceSize;
+
+ memset (p_header, 0, sizeof (t_grbHeader));
+ if ((p_source = map_file (grammarFileName, &sourceSize)) == NULL)
+   return (false);
+ memcpy (p_header->magic, GRB_MAGIC, sizeof (p_header->magic));
+ p_header->sourceSize              = (uint64_t) sourceSize;
+ p_header->sourceHash              = fnv1a_hash (p_source, sourceSize, GRB_FNV_OFFSET_BASIS);
+ (void) munmap (p_source, sourceSize);
+ p_header->version                 = GRB_FORMAT_VERSION;
+ p_header->byteOrder               = GRB_BYTE_ORDER;
+ p_header->headerSize              = (uint32_t) sizeof (t_grbHeader);
+ p_header->flags                   = b_stripoff_quotes ? GRB_FLAG_STRIPOFF_QUOTES : 0;
+ p_header->maxTerminals            = MAX_TERMINALS;
+ p_header->maxNonTerminals         = MAX_NON_TERMINALS;
+ p_header->maxRules                = MAX_RULES;
+ p_header->maxSymbolsEachRighthand = MAX_SYMBOLS_EACH_RIGHTHAND;
+ p_header->maxCharsEachSymbol      = MAX_CHARS_EACH_SYMBOL;
+ return (true);
+}
+
+/*
+*---------------------------------------------------------------------
+* Take a symbol record number in a .grb file (terminals first, then
+* non-terminals, end-of-input and epsilon) and return its data
+*---------------------------------------------------------------------
+*/
+
+static t_symbolData *grb_symbolData (unsigned int recordNumber)
+{
+ if (recordNumber < totTerminals)
+   return (&terminals[recordNumber]);
+ if (recordNumber < totTerminals + totNonTerminals)
+   return (&nonTerminals[recordNumber - totTerminals]);
+ if (recordNumber == totTerminals + totNonTerminals)
+   return (&endOfInputUsage);
+ return (&epsilonUsage);
+}
+
+/*
+*---------------------------------------------------------------------
+* Write the grammar just read by read_grammar() to a .grb file
+*---------------------------------------------------------------------
+*/
+
+void write_grammar_binary (const char *binaryFileName, const char *grammarFileName, bool b_stripoff_quotes)
+{
+ t_grbHeader
+   header;
+ uint32_t
+   *payload,
+   *p_word;
+ unsigned int
+   iRule,
+   iRecord,
+   iUse,
+   totRecords;
+ size_t
+   payloadSize;
+ t_symbolData
+   *p_symbolData;
+ FILE
+   *binaryFilePt;
+ char
+   tempFileName [FILENAME_MAX];
+ int
+   nameSize;
+
+ if (! grb_set_header (&header, grammarFileName, b_stripoff_quotes)) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Cannot map \"%s\" into memory to work out its hash", grammarFileName);
+   ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+ }
+ totRecords = totTerminals + totNonTerminals + 2;
+ header.totTerminals        = totTerminals;
+ header.totNonTerminals     = totNonTerminals;
+ header.totRules            = totRules;
+ header.totRighthandSymbols = nextRighthandPos;
+ header.totSymbolChars      = nextSymbolChar;
+ header.initialSymbolCode   = initialSymbolCode;
+ header.endOfInputCode      = end_of_input_code;
+
+ /* Lay out the payload in memory so it can be hashed and written in one go */
+
+ payloadSize = sizeof (uint32_t) * (3 * totRules + nextRighthandPos + 2 * totRecords) +
+               nextSymbolChar + MAX_CHARS_EACH_SYMBOL;
+ if ((payload = (uint32_t *) malloc (payloadSize)) == NULL)
+   ERROR_no_memory (0, __FILE__, __func__, "payload");
+ p_word = payload;
+ for (iRule = 0; iRule < totRules; iRule++) {
+   *p_word++ = (uint32_t) grammarRules[iRule].lefthandSymbol;
+   *p_word++ = (uint32_t) grammarRules[iRule].righthandSize;
+   *p_word++ = (uint32_t) grammarRules[iRule].posFirstSymbol;
+ }
+ for (iUse = 0; iUse < nextRighthandPos; iUse++)
+   *p_word++ = (uint32_t) righthandSides[iUse];
+ for (iRecord = 0; iRecord < totRecords; iRecord++) {
+   p_symbolData = grb_symbolData (iRecord);
+   *p_word++ = (uint32_t) p_symbolData->symbolCode;
+   *p_word++ = (uint32_t) p_symbolData->posFirstChar;
+ }
+ memcpy ((char *) p_word, symbolNames, nextSymbolChar);
+ memcpy ((char *) p_word + nextSymbolChar, initialSymbolString, MAX_CHARS_EACH_SYMBOL);
+ header.payloadSize = (uint64_t) payloadSize;
+ header.payloadHash = fnv1a_hash (payload, payloadSize, GRB_FNV_OFFSET_BASIS);
+
+ /* Write to a temporary file first, so a run that is interrupted */
+ /* never leaves a truncated .grb behind                          */
+
+ nameSize = snprintf (tempFileName, sizeof (tempFileName), "%s.tmp", binaryFileName);
+ if ((nameSize < 0) || ((size_t) nameSize >= sizeof (tempFileName))) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "File name \"%.*s\" is too long",
+             GRB_MAX_NAME_IN_MESSAGE, binaryFileName);
+   ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+ }
+ errno = 0;
+ if ((binaryFilePt = fopen (tempFileName, "wb")) == NULL) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Cannot open \"%.*s.tmp\" for writing",
+             GRB_MAX_NAME_IN_MESSAGE, binaryFileName);
+   ERROR_fatal_error (errno, __FILE__, __func__, ERROR_auxErrorMsg);
+ }
+ errno = 0;
+ if ((fwrite (&header, sizeof (header), 1, binaryFilePt) != 1) ||
+     (fwrite (payload, payloadSize, 1, binaryFilePt) != 1)     ||
+     (fclose (binaryFilePt) != 0)                              ||
+     (rename (tempFileName, binaryFileName) != 0)) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Cannot write \"%.*s\"",
+             GRB_MAX_NAME_IN_MESSAGE, binaryFileName);
+   ERROR_fatal_error (errno, __FILE__, __func__, ERROR_auxErrorMsg);
+ }
+ free (payload);
+}
+
+/*
+*---------------------------------------------------------------------
+* Load a grammar from a .grb file instead of calling read_grammar().
+* Return false, leaving the grammar untouched, if the file does not
+* exist, is damaged, was built by an incompatible version of the
+* program or with other options, or is out of date: the size and the
+* FNV-1a hash of the grammar file recorded in it no longer match
+*---------------------------------------------------------------------
+*/
+
+bool load_grammar_binary (const char *binaryFileName, const char *grammarFileName, bool b_stripoff_quotes)
+{
+ t_grbHeader
+   expectedHeader;
+ const t_grbHeader
+   *p_header;
+ const uint32_t
+   *p_word;
+ const char
+   *p_chars;
+ void
+   *p_mapped;
+ size_t
+   fileSize,
+   payloadSize;
+ size_t
+   totSymbolChars;
+ unsigned int
+   iRule,
+   iRecord,
+   iUse,
+   totRecords = 0;
+ t_symbolData
+   *p_symbolData;
+ char
+   *p_newSymbolNames;
+ bool
+   isValid;
+
+ if ((p_mapped = map_file (binaryFileName, &fileSize)) == NULL)
+   return (false);
+ if (! grb_set_header (&expectedHeader, grammarFileName, b_stripoff_quotes)) {
+   (void) munmap (p_mapped, fileSize);
+   return (false);
+ }
+
+ /* Check the header against what this program and grammar file expect */
+
+ p_header = (const t_grbHeader *) p_mapped;
+ isValid = (fileSize >= sizeof (t_grbHeader)) &&
+   (memcmp (p_header->magic, expectedHeader.magic, sizeof (p_header->magic)) == 0) &&
+   (p_header->version                 == expectedHeader.version)                 &&
+   (p_header->byteOrder               == expectedHeader.byteOrder)               &&
+   (p_header->headerSize              == expectedHeader.headerSize)              &&
+   (p_header->flags                   == expectedHeader.flags)                   &&
+   (p_header->maxTerminals            == expectedHeader.maxTerminals)            &&
+   (p_header->maxNonTerminals         == expectedHeader.maxNonTerminals)         &&
+   (p_header->maxRules                == expectedHeader.maxRules)                &&
+   (p_header->maxSymbolsEachRighthand == expectedHeader.maxSymbolsEachRighthand) &&
+   (p_header->maxCharsEachSymbol      == expectedHeader.maxCharsEachSymbol)      &&
+   (p_header->sourceSize              == expectedHeader.sourceSize)              &&
+   (p_header->sourceHash              == expectedHeader.sourceHash);
+ if (isValid) {
+   totRecords = p_header->totTerminals + p_header->totNonTerminals + 2;
+   isValid = (p_header->totTerminals        <= MAX_TERMINALS)              &&
+             (p_header->totNonTerminals     <= MAX_NON_TERMINALS)          &&
+             (p_header->totRules            <= MAX_RULES)                  &&
+             (p_header->totRighthandSymbols <= MAX_SYMBOLS_ALL_RIGHTHANDS);
+ }
+ if (isValid) {
+   payloadSize = sizeof (uint32_t) * (3 * p_header->totRules + p_header->totRighthandSymbols +
+                                      2 * totRecords) +
+                 p_header->totSymbolChars + MAX_CHARS_EACH_SYMBOL;
+   isValid = (p_header->payloadSize == (uint64_t) payloadSize)          &&
+             (fileSize == sizeof (t_grbHeader) + payloadSize)           &&
+             (p_header->payloadHash == fnv1a_hash ((const char *) p_mapped + sizeof (t_grbHeader), payloadSize, GRB_FNV_OFFSET_BASIS));
+ }
+ if (! isValid) {
+   (void) munmap (p_mapped, fileSize);
+   return (false);
+ }
+
+ /* The file is sound: copy the grammar straight from the mapping */
+
+ init_grammar_data();
+ totTerminals      = p_header->totTerminals;
+ totNonTerminals   = p_header->totNonTerminals;
+ totRules          = p_header->totRules;
+ nextRighthandPos  = p_header->totRighthandSymbols;
+ initialSymbolCode = p_header->initialSymbolCode;
+ end_of_input_code = p_header->endOfInputCode;
+ p_word = (const uint32_t *) ((const char *) p_mapped + sizeof (t_grbHeader));
+ for (iRule = 0; iRule < totRules; iRule++) {
+   grammarRules[iRule].lefthandSymbol = (t_symbolCode) *p_word++;
+   grammarRules[iRule].righthandSize  = (unsigned int) *p_word++;
+   grammarRules[iRule].posFirstSymbol = (unsigned int) *p_word++;
+ }
+ for (iUse = 0; iUse < nextRighthandPos; iUse++)
+   righthandSides[iUse] = (t_symbolCode) *p_word++;
+ for (iRecord = 0; iRecord < totRecords; iRecord++) {
+   p_symbolData = grb_symbolData (iRecord);
+   p_symbolData->symbolCode       = (t_symbolCode) *p_word++;
+   p_symbolData->posFirstChar     = (unsigned int) *p_word++;
+   isValid = isValid && (p_symbolData->posFirstChar < p_header->totSymbolChars || iRecord >= totTerminals + totNonTerminals);
+ }
+ if (! isValid) {
+   (void) munmap (p_mapped, fileSize);
+   init_grammar_data();
+   return (false);
+ }
+ /* Symbol strings: copy them and enter every symbol in the hash table again */
+
+ totSymbolChars = p_header->totSymbolChars;
+ if (totSymbolChars > maxSymbolChars) {
+   if ((p_newSymbolNames = (char *) realloc (symbolNames, totSymbolChars)) == NULL)
+     ERROR_no_memory (0, __FILE__, __func__, "symbolNames");
+   symbolNames = p_newSymbolNames;
+   maxSymbolChars = totSymbolChars;
+ }
+ p_chars = (const char *) p_word;
+ memcpy (symbolNames, p_chars, totSymbolChars);
+ nextSymbolChar = (unsigned int) totSymbolChars;
+ memcpy (initialSymbolString, p_chars + totSymbolChars, MAX_CHARS_EACH_SYMBOL);
+ initialSymbolString[MAX_CHARS_EACH_SYMBOL - 1] = '\0';
+ (void) munmap (p_mapped, fileSize);
+
+ for (iRecord = 0; iRecord < totTerminals + totNonTerminals; iRecord++) {
+   p_symbolData = grb_symbolData (iRecord);
+   symbolHashTable[symbolStr2hashSlot (&symbolNames[p_symbolData->posFirstChar])] = p_symbolData->symbolCode;
+ }
+ totGrammarSymbols = totTerminals + totNonTerminals;
+ totFSAsymbols = totGrammarSymbols + 3;
+ cnt_grammarTokens = 0;
+ build_rule_use_index();
+ set_string_lengths();
+ return (true);
+}
+
+/*
+*---------------------------------------------------------------------
+* Grammar reduction
+*
+* A non-terminal is productive if some rule of it has only terminals
+* and productive non-terminals on its righthand side, and reachable if
+* the start symbol derives a sentential form containing it through
+* rules that are themselves productive. Only rules whose symbols are
+* all productive and whose lefthand symbol is reachable can ever be
+* used to parse a sentence; the others are dropped before any LR(0)
+* item is built. Nullable non-terminals are found along the way and
+* reported, as they are what makes epsilon moves in the automaton.
+*
+* All three sets are worked out with worklists: each rule keeps a count
+* of the non-terminals on its righthand side still missing a property,
+* and the rule fires when the count gets to zero, so every symbol and
+* every rule is looked at a fixed number of times.
+*---------------------------------------------------------------------
+*/
+
+/*
+*---------------------------------------------------------------------
+* Print a rule the way the symbols report does, numbering rules from 1
+*---------------------------------------------------------------------
+*/
+
+static void print_rule (FILE *filePt, unsigned int ruleIndex)
+{
+ unsigned int
+   iSymbol;
+ t_ruleData
+   *p_ruleData;
+
+ p_ruleData = &grammarRules[ruleIndex];
+ fprintf (filePt, "  %u: %s ->", ruleIndex + 1, symbolCode2symbolString (p_ruleData->lefthandSymbol));
+ for (iSymbol = 0; iSymbol < p_ruleData->righthandSize; iSymbol++)
+   fprintf (filePt, " %s", symbolCode2symbolString (righthandSides[p_ruleData->posFirstSymbol + iSymbol]));
+ fprintf (filePt, "\n");
+}
+
+/*
+*---------------------------------------------------------------------
+* Build the grammar again from the rules still alive, in their order.
+* Symbols are added exactly as read_grammar() adds them, so they get
+* the codes they would have had if the dead rules were never there.
+*---------------------------------------------------------------------
+*/
+
+static void rebuild_grammar (const bool b_liveRule [])
+{
+ unsigned int
+   iRule,
+   iSymbol,
+   newRule,
+   oldTotRules,
+   oldTotTerminals,
+   oldTotNonTerminals,
+   sizeNewRule,
+   startNewRighthand,
+   oldTerminalNamePos    [MAX_TERMINALS],
+   oldNonTerminalNamePos [MAX_NON_TERMINALS];
+ t_ruleData
+   *oldRules;
+ t_symbolCode
+   symbolCode,
+   lefthandSymbol,
+   *oldRighthandSides;
+ char
+   *oldSymbolNames,
+   symbolStr [MAX_CHARS_EACH_SYMBOL];
+ LEXAN_t_tokenVal
+   tokenVal;
+
+ /* Keep a copy of the grammar as it is, as the symbol tables are about to be cleared */
+
+ oldTotRules        = totRules;
+ oldTotTerminals    = totTerminals;
+ oldTotNonTerminals = totNonTerminals;
+ if ((oldRules = (t_ruleData *) malloc (oldTotRules * sizeof (t_ruleData))) == NULL)
+   ERROR_no_memory (0, __FILE__, __func__, "oldRules");
+ memcpy (oldRules, grammarRules, oldTotRules * sizeof (t_ruleData));
+ if ((oldRighthandSides = (t_symbolCode *) malloc ((nextRighthandPos + 1) * sizeof (t_symbolCode))) == NULL)
+   ERROR_no_memory (0, __FILE__, __func__, "oldRighthandSides");
+ memcpy (oldRighthandSides, righthandSides, nextRighthandPos * sizeof (t_symbolCode));
+ if ((oldSymbolNames = (char *) malloc (nextSymbolChar)) == NULL)
+   ERROR_no_memory (0, __FILE__, __func__, "oldSymbolNames");
+ memcpy (oldSymbolNames, symbolNames, nextSymbolChar);
+ for (iSymbol = 0; iSymbol < oldTotTerminals; iSymbol++)
+   oldTerminalNamePos[iSymbol] = terminals[iSymbol].posFirstChar;
+ for (iSymbol = 0; iSymbol < oldTotNonTerminals; iSymbol++)
+   oldNonTerminalNamePos[iSymbol] = nonTerminals[iSymbol].posFirstChar;
+
+ /* Add the live rules again: lefthand side, righthand side, then the rule itself */
+
+ init_grammar_data();
+ memset (&tokenVal, 0, sizeof (LEXAN_t_tokenVal));
+ tokenVal.tokenStr = symbolStr;
+ for (iRule = 0, newRule = 0; iRule < oldTotRules; iRule++) {
+   if (! b_liveRule[iRule])
+     continue;
+   lefthandSymbol = add_nonTerminal (&oldSymbolNames[oldNonTerminalNamePos[oldRules[iRule].lefthandSymbol - NON_TERMINAL_START_CODE]], t_lefthand);
+   if (iRule == 0)
+     initialSymbolCode = lefthandSymbol;
+   startNewRighthand = nextRighthandPos;
+   sizeNewRule = oldRules[iRule].righthandSize;
+   for (iSymbol = 0; iSymbol < sizeNewRule; iSymbol++) {
+     symbolCode = oldRighthandSides[oldRules[iRule].posFirstSymbol + iSymbol];
+     if (symbolCode >= NON_TERMINAL_START_CODE)
+       (void) add_nonTerminal (&oldSymbolNames[oldNonTerminalNamePos[symbolCode - NON_TERMINAL_START_CODE]], t_righthand);
+     else {
+       strncpy (symbolStr, &oldSymbolNames[oldTerminalNamePos[symbolCode - TERMINAL_START_CODE]], MAX_CHARS_EACH_SYMBOL - 1);
+       symbolStr[MAX_CHARS_EACH_SYMBOL - 1] = '\0';
+       symbolCode = add_terminal (tokenVal, t_righthand, false);
+       if ((iRule == 0) && (iSymbol == 1))
+         end_of_input_code = symbolCode;
+     }
+   }
+   add_rule (newRule++, lefthandSymbol, sizeNewRule, startNewRighthand);
+ }
+ totRules = newRule;
+ totGrammarSymbols = totTerminals + totNonTerminals;
+ totFSAsymbols = totGrammarSymbols + 3;
+ build_rule_use_index();
+ set_string_lengths();
+
+ free (oldRules);
+ free (oldRighthandSides);
+ free (oldSymbolNames);
+}
+
+/*
+*---------------------------------------------------------------------
+* Remove unproductive and unreachable rules and symbols from the
+* grammar just read, report them and return how many rules went
+*---------------------------------------------------------------------
+*/
+
+unsigned int reduce_grammar (FILE *reportFilePt)
+{
+ unsigned int
+   iRule,
+   iSymbol,
+   iUse,
+   totDeadRules,
+   totListed,
+   queueStart,
+   queueEnd,
+   queue                 [MAX_NON_TERMINALS],
+   totUnproductive       [MAX_RULES],
+   totNotNullable        [MAX_RULES];
+ bool
+   b_productive          [MAX_NON_TERMINALS],
+   b_nullable            [MAX_NON_TERMINALS],
+   b_reachable           [MAX_NON_TERMINALS],
+   b_terminalUsed        [MAX_TERMINALS],
+   b_liveRule            [MAX_RULES];
+ t_symbolData
+   *p_symbolData;
+ t_ruleData
+   *p_ruleData;
+ t_symbolCode
+   symbolCode;
+
+ memset (b_productive,   0, sizeof (b_productive));
+ memset (b_nullable,     0, sizeof (b_nullable));
+ memset (b_reachable,    0, sizeof (b_reachable));
+ memset (b_terminalUsed, 0, sizeof (b_terminalUsed));
+
+ /* Each rule starts off missing as many non-terminals as it has distinct ones */
+ /* on its righthand side. A terminal means the rule can never be nullable.    */
+
+ for (iRule = 0; iRule < totRules; iRule++)
+   totUnproductive[iRule] = totNotNullable[iRule] = 0;
+ for (iSymbol = 0; iSymbol < totNonTerminals; iSymbol++) {
+   p_symbolData = &nonTerminals[iSymbol];
+   for (iUse = 0; iUse < p_symbolData->totRighthandUses; iUse++) {
+     totUnproductive[righthandUses[p_symbolData->firstRighthandUse + iUse]]++;
+     totNotNullable[righthandUses[p_symbolData->firstRighthandUse + iUse]]++;
+   }
+ }
+ for (iSymbol = 0; iSymbol < totTerminals; iSymbol++) {
+   p_symbolData = &terminals[iSymbol];
+   for (iUse = 0; iUse < p_symbolData->totRighthandUses; iUse++)
+     totNotNullable[righthandUses[p_symbolData->firstRighthandUse + iUse]] = MAX_NON_TERMINALS + 1;
+ }
+
+ /* Productive non-terminals: start from the rules with no non-terminals at all */
+
+ queueStart = queueEnd = 0;
+ for (iRule = 0; iRule < totRules; iRule++) {
+   iSymbol = (unsigned int) (grammarRules[iRule].lefthandSymbol - NON_TERMINAL_START_CODE);
+   if ((totUnproductive[iRule] == 0) && ! b_productive[iSymbol]) {
+     b_productive[iSymbol] = true;
+     queue[queueEnd++] = iSymbol;
+   }
+ }
+ while (queueStart < queueEnd) {
+   p_symbolData = &nonTerminals[queue[queueStart++]];
+   for (iUse = 0; iUse < p_symbolData->totRighthandUses; iUse++) {
+     iRule = righthandUses[p_symbolData->firstRighthandUse + iUse];
+     iSymbol = (unsigned int) (grammarRules[iRule].lefthandSymbol - NON_TERMINAL_START_CODE);
+     if ((--totUnproductive[iRule] == 0) && ! b_productive[iSymbol]) {
+       b_productive[iSymbol] = true;
+       queue[queueEnd++] = iSymbol;
+     }
+   }
+ }
+
+ /* Nullable non-terminals: start from the epsilon rules */
+
+ queueStart = queueEnd = 0;
+ for (iRule = 0; iRule < totRules; iRule++) {
+   iSymbol = (unsigned int) (grammarRules[iRule].lefthandSymbol - NON_TERMINAL_START_CODE);
+   if ((grammarRules[iRule].righthandSize == 0) && ! b_nullable[iSymbol]) {
+     b_nullable[iSymbol] = true;
+     queue[queueEnd++] = iSymbol;
+   }
+ }
+ while (queueStart < queueEnd) {
+   p_symbolData = &nonTerminals[queue[queueStart++]];
+   for (iUse = 0; iUse < p_symbolData->totRighthandUses; iUse++) {
+     iRule = righthandUses[p_symbolData->firstRighthandUse + iUse];
+     iSymbol = (unsigned int) (grammarRules[iRule].lefthandSymbol - NON_TERMINAL_START_CODE);
+     if ((--totNotNullable[iRule] == 0) && ! b_nullable[iSymbol]) {
+       b_nullable[iSymbol] = true;
+       queue[queueEnd++] = iSymbol;
+     }
+   }
+ }
+
+ /* If the start symbol is unproductive the grammar generates no sentence at all */
+
+ if (! b_productive[initialSymbolCode - NON_TERMINAL_START_CODE]) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "The grammar generates no sentences: %s derives no string of terminals\n",
+     symbolCode2symbolString (righthandSides[grammarRules[0].posFirstSymbol]));
+   ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+ }
+
+ /* Reachable non-terminals: follow the productive rules from the start symbol */
+
+ queueStart = queueEnd = 0;
+ b_reachable[initialSymbolCode - NON_TERMINAL_START_CODE] = true;
+ queue[queueEnd++] = (unsigned int) (initialSymbolCode - NON_TERMINAL_START_CODE);
+ while (queueStart < queueEnd) {
+   p_symbolData = &nonTerminals[queue[queueStart++]];
+   for (iUse = 0; iUse < p_symbolData->totLefthandUses; iUse++) {
+     iRule = lefthandUses[p_symbolData->firstLefthandUse + iUse];
+     p_ruleData = &grammarRules[iRule];
+     if (totUnproductive[iRule] != 0)
+       continue;
+     for (iSymbol = 0; iSymbol < p_ruleData->righthandSize; iSymbol++) {
+       symbolCode = righthandSides[p_ruleData->posFirstSymbol + iSymbol];
+       if ((symbolCode >= NON_TERMINAL_START_CODE) && ! b_reachable[symbolCode - NON_TERMINAL_START_CODE]) {
+         b_reachable[symbolCode - NON_TERMINAL_START_CODE] = true;
+         queue[queueEnd++] = (unsigned int) (symbolCode - NON_TERMINAL_START_CODE);
+       }
+     }
+   }
+ }
+
+ /* A rule lives if it is productive and its lefthand symbol is reachable */
+
+ for (iRule = 0, totDeadRules = 0; iRule < totRules; iRule++) {
+   p_ruleData = &grammarRules[iRule];
+   b_liveRule[iRule] = (totUnproductive[iRule] == 0) && b_reachable[p_ruleData->lefthandSymbol - NON_TERMINAL_START_CODE];
+   if (! b_liveRule[iRule]) {
+     totDeadRules++;
+     continue;
+   }
+   for (iSymbol = 0; iSymbol < p_ruleData->righthandSize; iSymbol++) {
+     symbolCode = righthandSides[p_ruleData->posFirstSymbol + iSymbol];
+     if (symbolCode < NON_TERMINAL_START_CODE)
+       b_terminalUsed[symbolCode - TERMINAL_START_CODE] = true;
+   }
+ }
+
+ /* Report what is about to go, while the old symbol codes are still valid */
+
+ if (reportFilePt != NULL) {
+   fprintf (reportFilePt, "Grammar reduction\n");
+   fprintf (reportFilePt, "-----------------\n");
+   fprintf (reportFilePt, "Unproductive non-terminals:");
+   for (iSymbol = 0, totListed = 0; iSymbol < totNonTerminals; iSymbol++)
+     if (! b_productive[iSymbol]) {
+       fprintf (reportFilePt, " %s", symbolCode2symbolString (nonTerminals[iSymbol].symbolCode));
+       totListed++;
+     }
+   fprintf (reportFilePt, "%s\n", totListed == 0 ? " none" : "");
+   fprintf (reportFilePt, "Unreachable non-terminals:");
+   for (iSymbol = 0, totListed = 0; iSymbol < totNonTerminals; iSymbol++)
+     if (b_productive[iSymbol] && ! b_reachable[iSymbol]) {
+       fprintf (reportFilePt, " %s", symbolCode2symbolString (nonTerminals[iSymbol].symbolCode));
+       totListed++;
+     }
+   fprintf (reportFilePt, "%s\n", totListed == 0 ? " none" : "");
+   fprintf (reportFilePt, "Unused terminals:");
+   for (iSymbol = 0, totListed = 0; iSymbol < totTerminals; iSymbol++)
+     if (! b_terminalUsed[iSymbol]) {
+       fprintf (reportFilePt, " %s", symbolCode2symbolString (terminals[iSymbol].symbolCode));
+       totListed++;
+     }
+   fprintf (reportFilePt, "%s\n", totListed == 0 ? " none" : "");
+   fprintf (reportFilePt, "Nullable non-terminals:");
+   for (iSymbol = 0, totListed = 0; iSymbol < totNonTerminals; iSymbol++)
+     if (b_nullable[iSymbol] && b_reachable[iSymbol]) {
+       fprintf (reportFilePt, " %s", symbolCode2symbolString (nonTerminals[iSymbol].symbolCode));
+       totListed++;
+     }
+   fprintf (reportFilePt, "%s\n", totListed == 0 ? " none" : "");
+   fprintf (reportFilePt, "Rules removed: %u of %u\n", totDeadRules, totRules);
+   for (iRule = 0; iRule < totRules; iRule++)
+     if (! b_liveRule[iRule])
+       print_rule (reportFilePt, iRule);
+   fprintf (reportFilePt, "\n");
+ }
+
+ if (totDeadRules > 0)
+   rebuild_grammar (b_liveRule);
+ return (totDeadRules);
+}
+
 /*
 *---------------------------------------------------------------------
 * Given a grammar symbol string, obtain its numeric code
@@ -1045,22 +1938,16 @@ static void set_string_lengths (void)
 static t_symbolCode symbolStr2Code (char *symbolStr)
 {
  unsigned int
-   countSymbol;
+   hashSlot;
 
  if (symbolStr == NULL)
    return (UNKNOWN_SYMBOL_CODE);
 
- /* Is it a previously encountered terminal? */
-
- for (countSymbol = 0; countSymbol < totTerminals; countSymbol++)
-   if (! strcmp (&symbolNames[terminals[countSymbol].posFirstChar], symbolStr))
-     return (terminals[countSymbol].symbolCode);
-
- /* Is it a previously encountered non-terminal? */
+ /* Is it a previously encountered terminal or non-terminal? */
 
- for (countSymbol = 0; countSymbol < totNonTerminals; countSymbol++)
-   if (! strcmp (&symbolNames[nonTerminals[countSymbol].posFirstChar], symbolStr))
-     return (nonTerminals[countSymbol].symbolCode);
+ hashSlot = symbolStr2hashSlot (symbolStr);
+ if (symbolHashTable[hashSlot] != EPSILON_CODE)
+   return (symbolHashTable[hashSlot]);
 
  /* Is it EPSILON_STR ? */
 
@@ -1074,6 +1961,77 @@ static t_symbolCode symbolStr2Code (char *symbolStr)
  return (UNKNOWN_SYMBOL_CODE);
 }
 
+/*
+*---------------------------------------------------------------------
+* Given a grammar symbol string, return its slot in the hash table:
+* either the slot of that symbol or the free slot where it goes
+*---------------------------------------------------------------------
+*/
+
+static unsigned int symbolStr2hashSlot (const char *symbolStr)
+{
+ unsigned long
+   hash = 5381;
+ unsigned int
+   hashSlot,
+   posName;
+ const char
+   *p_char;
+ t_symbolCode
+   symbolCode;
+
+ /* djb2 string hash, then linear probing */
+
+ for (p_char = symbolStr; *p_char != '\0'; p_char++)
+   hash = hash * 33 + (unsigned char) *p_char;
+ hashSlot = (unsigned int) (hash & (SYMBOL_HASH_TABLE_SIZE - 1));
+ while ((symbolCode = symbolHashTable[hashSlot]) != EPSILON_CODE) {
+   if (symbolCode >= NON_TERMINAL_START_CODE)
+     posName = nonTerminals[symbolCode - NON_TERMINAL_START_CODE].posFirstChar;
+   else
+     posName = terminals[symbolCode - TERMINAL_START_CODE].posFirstChar;
+   if (! strcmp (&symbolNames[posName], symbolStr))
+     break;
+   hashSlot = (hashSlot + 1) & (SYMBOL_HASH_TABLE_SIZE - 1);
+ }
+ return (hashSlot);
+}
+
+/*
+*---------------------------------------------------------------------
+* Append a new symbol string to array symbolNames, growing it if
+* needed, enter the symbol in the hash table and return the position
+* of the string's first character
+*---------------------------------------------------------------------
+*/
+
+static unsigned int add_symbol_name (const char *symbolStr, t_symbolCode symbolCode)
+{
+ unsigned int
+   posName,
+   hashSlot;
+ size_t
+   nameLength;
+ char
+   *p_newSymbolNames;
+
+ hashSlot = symbolStr2hashSlot (symbolStr);
+ nameLength = strlen (symbolStr);
+ posName = nextSymbolChar;
+ if (posName + nameLength + 1 > maxSymbolChars) {
+   maxSymbolChars = (maxSymbolChars == 0) ? INITIAL_CHARS_ALL_SYMBOLS : 2 * maxSymbolChars;
+   while (posName + nameLength + 1 > maxSymbolChars)
+     maxSymbolChars *= 2;
+   if ((p_newSymbolNames = (char *) realloc (symbolNames, maxSymbolChars)) == NULL)
+     ERROR_no_memory (0, __FILE__, __func__, "symbolNames");
+   symbolNames = p_newSymbolNames;
+ }
+ memcpy (&symbolNames[posName], symbolStr, nameLength + 1);
+ nextSymbolChar += nameLength + 1;
+ symbolHashTable[hashSlot] = symbolCode;
+ return (posName);
+}
+
 /*
 *---------------------------------------------------------------------
 * Add terminal to various data structures
@@ -1083,14 +2041,10 @@ static t_symbolCode symbolStr2Code (char *symbolStr)
 static t_symbolCode add_terminal (
  LEXAN_t_tokenVal    tokenVal,
  t_whereInRule whereInRule,
- unsigned int  ruleNumber,
  bool          b_stripoff_quotes )
 {
  t_symbolCode
    symbolCode;
- unsigned int
-   index,
-   posName;
  size_t
    nameLength;
  t_symbolData
@@ -1107,35 +2061,23 @@ static t_symbolCode add_terminal (
 
  if ((symbolCode = symbolStr2Code (tokenVal.tokenStr)) == UNKNOWN_SYMBOL_CODE) {
 
-   /* First occurrence of this symbol                */
-   /* Add symbol string to array of all symbol names */
+   /* First occurrence of this symbol */
 
-   nameLength = strlen (tokenVal.tokenStr);
-   posName = nextSymbolChar;
-   if ((posName + nameLength) > MAX_CHARS_ALL_SYMBOLS) {
-     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Unable to add terminal %s: Symbol names array overflow\n", tokenVal.tokenStr);
-     ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
-   }
-   if ((strcpy (&symbolNames[posName], tokenVal.tokenStr)) == NULL) {
-     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "strcpy (symbolNames[%u],\"%s\") failed", posName, tokenVal.tokenStr);
+   if (totTerminals == MAX_TERMINALS) {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Unable to add terminal %s: more than %d terminals\n", tokenVal.tokenStr, MAX_TERMINALS);
      ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
    }
-   nextSymbolChar += nameLength + 1;
 
    /* Add symbol to array of terminals and clear relevant fields */
 
    symbolCode = (t_symbolCode) (TERMINAL_START_CODE + totTerminals);
    p_symbolData = &terminals[totTerminals];
    p_symbolData->symbolCode = symbolCode;
-   p_symbolData->posFirstChar = posName;
+   p_symbolData->posFirstChar = add_symbol_name (tokenVal.tokenStr, symbolCode);
    p_symbolData->totLefthandUses = p_symbolData->totRighthandUses = 0;
-   for (index = 0; index < MAX_SYMBOL_LEFTHAND_USES; index++)
-     p_symbolData->lefthandUses[index] = p_symbolData->righthandUses[index] = 0;
    totTerminals++;
  }
 
- p_symbolData = &terminals[symbolCode - TERMINAL_START_CODE];
-
  /* Terminals are not allowed on the lefthand side of a rule! */
 
  if (whereInRule == t_lefthand) {
@@ -1143,21 +2085,6 @@ static t_symbolCode add_terminal (
    ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
  }
 
- /* This is the righthand side of a rule. However, the terminal */
- /*   may occur several times on the same righthand side        */
- /*   so make sure it's counted in only once                    */
-
- for (index = 0; index < p_symbolData->totRighthandUses; index++)
-   if (p_symbolData->righthandUses[index] == ruleNumber)
-     break;
- if (index == p_symbolData->totRighthandUses) {
-
-   /* First occurrence in this righthand side, so make a note of it */
-
-   p_symbolData->righthandUses[index] = ruleNumber;
-   p_symbolData->totRighthandUses++;
- }
-
  /* Add symbol to array of all righthand sides */
 
  righthandSides[nextRighthandPos++] = symbolCode;
@@ -1173,47 +2100,29 @@ static t_symbolCode add_terminal (
 
 static t_symbolCode add_nonTerminal (
  char         *symbolStr,
- t_whereInRule whereInRule,
- unsigned int  ruleNumber )
+ t_whereInRule whereInRule )
 {
  t_symbolCode
    symbolCode;
- unsigned int
-   index,
-   posName;
- size_t
-   nameLength;
  t_symbolData
    *p_symbolData;
 
  if ((symbolCode = symbolStr2Code (symbolStr)) == UNKNOWN_SYMBOL_CODE) {
 
-   /* First occurrence of this symbol                */
-   /* Add symbol string to array of all symbol names */
+   /* First occurrence of this symbol */
 
-   posName = nextSymbolChar;
-   nameLength = strlen (symbolStr);
-   if ((posName + nameLength) > MAX_CHARS_ALL_SYMBOLS) {
-     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Unable to add non-terminal %s: Symbol names array overflow\n", symbolStr);
-     ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
-   }
-   if ((strcpy (&symbolNames[posName], symbolStr)) == NULL) {
-     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "strcpy (symbolNames[%u],\"%s\") failed", posName, symbolStr);
+   if (totNonTerminals == MAX_NON_TERMINALS) {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Unable to add non-terminal %s: more than %d non-terminals\n", symbolStr, MAX_NON_TERMINALS);
      ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
    }
-   nextSymbolChar += nameLength + 1;
 
    /* Add symbol to array of non-terminals and clear relevant fields */
 
    symbolCode = (t_symbolCode) (NON_TERMINAL_START_CODE + totNonTerminals);
    p_symbolData = &nonTerminals[totNonTerminals];
    p_symbolData->symbolCode = symbolCode;
-   p_symbolData->posFirstChar = posName;
+   p_symbolData->posFirstChar = add_symbol_name (symbolStr, symbolCode);
    p_symbolData->totLefthandUses = p_symbolData->totRighthandUses = 0;
-   for (index = 0; index < MAX_SYMBOL_LEFTHAND_USES; index++)
-     p_symbolData->lefthandUses[index] = 0;
-   for (index = 0; index < MAX_SYMBOL_RIGHTHAND_USES; index++)
-     p_symbolData->righthandUses[index] = 0;
    totNonTerminals++;
  }
  else {
@@ -1227,34 +2136,11 @@ static t_symbolCode add_nonTerminal (
    }
  }
 
- p_symbolData = &nonTerminals[symbolCode - NON_TERMINAL_START_CODE];
- switch (whereInRule) {
-   case (t_lefthand):
-
-     /* This is the leftthand side of a rule */
-
-     p_symbolData->lefthandUses[p_symbolData->totLefthandUses++] = ruleNumber;
-     break;
+ /* Only the righthand side of rules needs recording here: the rules */
+ /*   where each symbol is used are worked out once they are all read */
 
-   case (t_righthand):
-
-     /* This is the righthand side of a rule. The non-terminal */
-     /*   may occur several times on the same righthand side   */
-     /*   so make sure it's counted in only once               */
-
-     for (index = 0; index < p_symbolData->totRighthandUses; index++)
-       if (p_symbolData->righthandUses[index] == ruleNumber)
-         break;
-     if (index == p_symbolData->totRighthandUses)
-
-       /* First occurrence in this righthand side, so make a note of it */
-
-       p_symbolData->righthandUses[p_symbolData->totRighthandUses++] = ruleNumber;
-
-     /* Add symbol to array of all righthand sides */
-
-     righthandSides[nextRighthandPos++] = symbolCode;
- }
+ if (whereInRule == t_righthand)
+   righthandSides[nextRighthandPos++] = symbolCode;
 
  return (symbolCode);
 }
@@ -1274,12 +2160,6 @@ static void add_rule (
  t_ruleData
    *p_ruleData;
 
- /* Is this an epsilon rule?  eg. Z -> ;                         */
- /* If so, we need to take note of this epsilon usage in a rule. */
-
- if (righthandSize == 0)
-   epsilonUsage.righthandUses[epsilonUsage.totRighthandUses++] = ruleNumber;
-
  /* Epsilon rules can be added as any other rule, in which case  */
  /* posFirstSymbol is meaningless.                               */
 
@@ -1289,6 +2169,96 @@ static void add_rule (
  p_ruleData->posFirstSymbol = posFirstSymbol;
 }
 
+/*
+*---------------------------------------------------------------------
+* Work out the rules where each symbol is used, once all rules are in.
+* The first pass counts the uses of every symbol, so that each one
+* gets a run of arrays lefthandUses and righthandUses just as long as
+* it needs; the second pass fills the runs in, in rule order. Epsilon
+* rules are the righthand uses of epsilon.
+*---------------------------------------------------------------------
+*/
+
+static void build_rule_use_index (void)
+{
+ unsigned int
+   iPass,
+   iRule,
+   iSymbol,
+   iPrevSymbol,
+   nextLefthandUse,
+   nextRighthandUse;
+ t_ruleData
+   *p_ruleData;
+ t_symbolData
+   *p_symbolData;
+ t_symbolCode
+   symbolCode;
+
+ for (iSymbol = 0; iSymbol < totTerminals; iSymbol++)
+   terminals[iSymbol].totLefthandUses = terminals[iSymbol].totRighthandUses = 0;
+ for (iSymbol = 0; iSymbol < totNonTerminals; iSymbol++)
+   nonTerminals[iSymbol].totLefthandUses = nonTerminals[iSymbol].totRighthandUses = 0;
+ epsilonUsage.totLefthandUses = epsilonUsage.totRighthandUses = 0;
+ endOfInputUsage.totLefthandUses = endOfInputUsage.totRighthandUses = 0;
+
+ for (iPass = 1; iPass <= 2; iPass++) {
+
+   /* After counting, give each symbol its run and count again as the runs fill */
+
+   if (iPass == 2) {
+     nextLefthandUse = nextRighthandUse = 0;
+     for (iSymbol = 0; iSymbol < totTerminals; iSymbol++) {
+       terminals[iSymbol].firstRighthandUse = nextRighthandUse;
+       nextRighthandUse += terminals[iSymbol].totRighthandUses;
+       terminals[iSymbol].totRighthandUses = 0;
+     }
+     for (iSymbol = 0; iSymbol < totNonTerminals; iSymbol++) {
+       nonTerminals[iSymbol].firstLefthandUse = nextLefthandUse;
+       nextLefthandUse += nonTerminals[iSymbol].totLefthandUses;
+       nonTerminals[iSymbol].totLefthandUses = 0;
+       nonTerminals[iSymbol].firstRighthandUse = nextRighthandUse;
+       nextRighthandUse += nonTerminals[iSymbol].totRighthandUses;
+       nonTerminals[iSymbol].totRighthandUses = 0;
+     }
+     epsilonUsage.firstRighthandUse = nextRighthandUse;
+     epsilonUsage.totRighthandUses = 0;
+   }
+
+   for (iRule = 0; iRule < totRules; iRule++) {
+     p_ruleData = &grammarRules[iRule];
+     p_symbolData = &nonTerminals[p_ruleData->lefthandSymbol - NON_TERMINAL_START_CODE];
+     if (iPass == 2)
+       lefthandUses[p_symbolData->firstLefthandUse + p_symbolData->totLefthandUses] = iRule;
+     p_symbolData->totLefthandUses++;
+     if (p_ruleData->righthandSize == 0) {
+       if (iPass == 2)
+         righthandUses[epsilonUsage.firstRighthandUse + epsilonUsage.totRighthandUses] = iRule;
+       epsilonUsage.totRighthandUses++;
+     }
+     for (iSymbol = 0; iSymbol < p_ruleData->righthandSize; iSymbol++) {
+
+       /* A symbol may occur several times on the same righthand side */
+       /*   but the rule is one use of it all the same                */
+
+       symbolCode = righthandSides[p_ruleData->posFirstSymbol + iSymbol];
+       for (iPrevSymbol = 0; iPrevSymbol < iSymbol; iPrevSymbol++)
+         if (righthandSides[p_ruleData->posFirstSymbol + iPrevSymbol] == symbolCode)
+           break;
+       if (iPrevSymbol < iSymbol)
+         continue;
+       if (symbolCode >= NON_TERMINAL_START_CODE)
+         p_symbolData = &nonTerminals[symbolCode - NON_TERMINAL_START_CODE];
+       else
+         p_symbolData = &terminals[symbolCode - TERMINAL_START_CODE];
+       if (iPass == 2)
+         righthandUses[p_symbolData->firstRighthandUse + p_symbolData->totRighthandUses] = iRule;
+       p_symbolData->totRighthandUses++;
+     }
+   }
+ }
+}
+
 /*
 *---------------------------------------------------------------------
 * Take a symbol number (1 onwards) and type (terminal or non-terminal)
@@ -1376,28 +2346,19 @@ const char *symbolCode2symbolString (t_symbolCode symbolCode)
 {
  t_symbolType
    symbolType;
- unsigned int
-   countSymbol;
 
  if (symbolCode == end_of_input_code)
    return (endOfInputString);
  if (symbolCode == EPSILON_CODE)
    return (epsilonString);
+
+ /* Symbols are stored in code order, so index them directly */
+
  symbolType = symbolCode2symbolType (symbolCode);
- if (symbolType == t_terminal) {
-   for (countSymbol = 0; countSymbol < totTerminals; countSymbol++)
-     if (terminals[countSymbol].symbolCode == symbolCode)
-       return (&symbolNames[terminals[countSymbol].posFirstChar]);
-   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Could not find terminal string (code %d)\n", symbolCode);
-   ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
- }
- if (symbolType == t_nonTerminal) {
-   for (countSymbol = 0; countSymbol < totNonTerminals; countSymbol++)
-     if (nonTerminals[countSymbol].symbolCode == symbolCode)
-       return (&symbolNames[nonTerminals[countSymbol].posFirstChar]);
-   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Could not find non-terminal string (code %d)\n", symbolCode);
-   ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
- }
+ if (symbolType == t_terminal)
+   return (&symbolNames[terminals[symbolCode - TERMINAL_START_CODE].posFirstChar]);
+ if (symbolType == t_nonTerminal)
+   return (&symbolNames[nonTerminals[symbolCode - NON_TERMINAL_START_CODE].posFirstChar]);
  snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Unknown symbol type: %d\n", symbolType);
  ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
 }
@@ -1573,9 +2534,9 @@ t_ruleNumber symbolCode2use (t_symbolCode symbolCode, t_whereInRule whereInRule,
    ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
  }
  if (whereInRule == t_lefthand)
-   return ((t_ruleNumber) (p_symbolData->lefthandUses[useNumber-1] + 1));
+   return ((t_ruleNumber) (lefthandUses[p_symbolData->firstLefthandUse + useNumber-1] + 1));
  else
-   return ((t_ruleNumber) (p_symbolData->righthandUses[useNumber-1] + 1));
+   return ((t_ruleNumber) (righthandUses[p_symbolData->firstRighthandUse + useNumber-1] + 1));
 }
 
 /*
@@ -1588,8 +2549,8 @@ t_ruleNumber symbolCode2use (t_symbolCode symbolCode, t_whereInRule whereInRule,
 
 static t_itemCode newItem (t_ruleNumber ruleNumber, t_dotPosition dotPosition)
 {
- unsigned int
-   iItem;
+ t_itemCode
+   itemCode;
 
  if (ruleNumber > totRules) {
    snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Unable to create LR(0) item {%u,%u}: invalid rule number\n", ruleNumber, dotPosition);
@@ -1606,18 +2567,29 @@ static t_itemCode newItem (t_ruleNumber ruleNumber, t_dotPosition dotPosition)
 
  /* Check if this LR(0) item has been created before */
 
- for (iItem = 0; iItem < nextLR0item; iItem++)
-   if ( (LR0items[iItem].ruleNumber ==  ruleNumber) &&
-        (LR0items[iItem].dotPosition == dotPosition) )
-     return ((t_itemCode) (iItem + ITEM_START_CODE));
+ itemCode = ruleDot2itemCode[ruleNumber-1][dotPosition];
+ if (itemCode != UNKNOWN_ITEM_CODE) {
+   cnt_itemLookups++;
+   return (itemCode);
+ }
 
  /* This is a new item; create it and return its numeric code */
 
+ cnt_itemCreations++;
  LR0items[nextLR0item].ruleNumber  = ruleNumber;
  LR0items[nextLR0item].dotPosition = dotPosition;
+ LR0items[nextLR0item].isReduction = (dotPosition == grammarRules[ruleNumber-1].righthandSize);
+ if (grammarRules[ruleNumber-1].righthandSize == 0)
+   LR0items[nextLR0item].transitionSymbol = EPSILON_CODE;
+ else if (dotPosition < grammarRules[ruleNumber-1].righthandSize)
+   LR0items[nextLR0item].transitionSymbol = righthandSides[grammarRules[ruleNumber-1].posFirstSymbol + dotPosition];
+ else
+   LR0items[nextLR0item].transitionSymbol = UNKNOWN_SYMBOL_CODE;
  totLR0items++;
  totLR0itemSymbols += (grammarRules[ruleNumber-1].righthandSize + 3);  /* 3 = lefthand non-terminal + rule arrow + item dot */
- return ((t_itemCode) ((nextLR0item++) + ITEM_START_CODE));
+ itemCode = (t_itemCode) ((nextLR0item++) + ITEM_START_CODE);
+ ruleDot2itemCode[ruleNumber-1][dotPosition] = itemCode;
+ return (itemCode);
 }
 
 /*
@@ -1681,11 +2653,6 @@ t_dotPosition itemCode2dotPosition (t_itemCode itemCode)
 
 t_itemCode ruleNumberDotPosition2itemCode (t_ruleNumber ruleNumber, t_dotPosition dotPosition)
 {
- unsigned int
-   iItem;
- t_LR0item
-   *pItem;
-
  if ((ruleNumber < 1) || (ruleNumber > totRules)) {
    snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Invalid rule number %u\n", ruleNumber);
    ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
@@ -1694,14 +2661,7 @@ t_itemCode ruleNumberDotPosition2itemCode (t_ruleNumber ruleNumber, t_dotPositio
    snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Invalid dot position %u\n", dotPosition);
    ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
  }
- for (iItem = 0, pItem = LR0items; iItem < nextLR0item; iItem++, pItem++) {
-   if (pItem->ruleNumber != ruleNumber)
-     continue;
-   if (pItem->dotPosition != dotPosition)
-     continue;
-   return ((t_itemCode) (iItem + ITEM_START_CODE));
- }
- return ((t_itemCode) UNKNOWN_ITEM_CODE);
+ return (ruleDot2itemCode[ruleNumber-1][dotPosition]);
 }
 
 /*
@@ -1714,14 +2674,23 @@ t_itemCode ruleNumberDotPosition2itemCode (t_ruleNumber ruleNumber, t_dotPositio
 
 t_symbolCode itemCode2transitionSymbol (t_itemCode itemCode)
 {
- t_ruleNumber
-   ruleNumber;
+ int
+   itemIndex;
+ t_LR0item
+   *p_LR0item;
 
- ruleNumber = itemCode2ruleNumber (itemCode);
- if (isEpsilonRule (ruleNumber))
-   return (EPSILON_CODE);
- else
-   return (rulePos2symbolCode (ruleNumber, (unsigned int) 1 + itemCode2dotPosition (itemCode)));
+ itemIndex = itemCode - ITEM_START_CODE;
+ if ((itemIndex < 0) || (itemIndex >= (int) nextLR0item)) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Invalid LR(0) item code %d\n", itemCode);
+   ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+ }
+ p_LR0item = &LR0items[itemIndex];
+
+ /* With the dot at the end of a non-empty rule there is no symbol after it */
+
+ if (p_LR0item->transitionSymbol == UNKNOWN_SYMBOL_CODE)
+   return (rulePos2symbolCode (p_LR0item->ruleNumber, (unsigned int) 1 + p_LR0item->dotPosition));
+ return (p_LR0item->transitionSymbol);
 }
 
 /*----------------------------------------------------------------------------
@@ -1743,7 +2712,7 @@ bool isReductionItem (t_itemCode itemCode)
    ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
  }
  p_LR0item = &LR0items[itemIndex];
- return ((bool) (ruleNumber2ruleSize (p_LR0item->ruleNumber) == p_LR0item->dotPosition));
+ return (p_LR0item->isReduction);
 }
 
 /*
@@ -1797,7 +2766,7 @@ t_stateType stateCode2stateType (t_stateCode stateCode)
    return (NFAstates[stateCode - NFA_STATE_START_CODE].stateType);
  if ( ((int) stateCode >= (int)  DFA_STATE_START_CODE) &&
       ((int) stateCode <= (int) (DFA_STATE_START_CODE + totDFAstates - 1)) )
-   return (DFAstates[stateCode - DFA_STATE_START_CODE].stateType);
+   return (DFAstateType[stateCode - DFA_STATE_START_CODE]);
  snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Invalid state code: %d\n", stateCode);
  ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
 }
@@ -1847,23 +2816,16 @@ static t_stateCode nfa_newEmptyState (void)
 
 static t_stateCode dfa_newEmptyState (void)
 {
- int
-   iSymbol,
-   iItem;
- t_DFAstate
-   *p_DFAstate;
-
  if (dfa_nextState == MAX_DFA_STATES) {
    snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Unable to create new DFA state: array overflow\n");
    ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
  }
- p_DFAstate = &DFAstates[dfa_nextState];
- p_DFAstate->itemsInState = 0;
- for (iItem = 0; iItem < MAX_ITEMS_PER_DFA_STATE; iItem++)
-   p_DFAstate->itemIndex[iItem] = UNKNOWN_ITEM_INDEX;
- p_DFAstate->totInwardTransitions = p_DFAstate->totTransitionSymbols = 0;
- for (iSymbol = 0; iSymbol < MAX_TRANSITIONS_PER_DFA_STATE; iSymbol++)
-   p_DFAstate->transitionSymbols[iSymbol] = UNKNOWN_SYMBOL_CODE;
+ DFAstateTotItems[dfa_nextState]    = 0;
+ DFAstateFirstItem[dfa_nextState]   = nextDFAitem;
+ DFAstateTotInward[dfa_nextState]   = 0;
+ DFAstateTotSymbols[dfa_nextState]  = 0;
+ DFAstateFirstSymbol[dfa_nextState] = nextDFAsymbol;
+ DFAstateFingerprint[dfa_nextState] = 0;
  totDFAstates++;
  return ((t_stateCode) ((dfa_nextState++) + DFA_STATE_START_CODE));
 }
@@ -1929,76 +2891,101 @@ static bool dfa_addItemToState (t_itemCode itemCode, t_stateCode stateCode)
 {
  unsigned int
    iSymbol,
-   iItem;
+   stateIndex,
+   low,
+   high,
+   middle;
+ int
+   itemIndex,
+   *p_sortedItems;
  t_symbolCode
-   transitionSymbol;
- t_LR0item
-   *p_LR0item;
- t_DFAstate
-   *p_DFAstate;
+   transitionSymbol,
+   *p_stateSymbols;
+ void
+   *p_newPool;
 
- /* Ensure the state code provided really is a DFA state */
+ /* Ensure the state code provided really is a DFA state, */
+ /* and the last one created, as only that one can grow   */
 
  snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Attempt to add item %d to NFA state %d; DFA state expected\n", itemCode, stateCode);
  validate_state_FSA_type (stateCode, t_DFA, ERROR_auxErrorMsg);
+ stateIndex = (unsigned int) (stateCode - DFA_STATE_START_CODE);
+ if (stateIndex != dfa_nextState - 1) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Attempt to add item %d to DFA state %d; only the last state (%u) can take new items\n",
+     itemCode, stateCode, dfa_nextState - 1 + DFA_STATE_START_CODE);
+   ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+ }
+ itemIndex = itemCode - ITEM_START_CODE;
 
- p_DFAstate = &DFAstates[stateCode - DFA_STATE_START_CODE];
-
- /* This item may already be in this state */
+ /* This item may already be in this state: binary search its sorted run, */
+ /* which leaves low at the position where the item belongs if it is not  */
 
- for (iItem = 0; iItem < p_DFAstate->itemsInState; iItem++)
-   if ((int) p_DFAstate->itemIndex[iItem] == (int) itemCode - ITEM_START_CODE)
+ p_sortedItems = &DFAsortedItems[DFAstateFirstItem[stateIndex]];
+ low = 0;
+ high = DFAstateTotItems[stateIndex];
+ while (low < high) {
+   middle = (low + high) / 2;
+   if (p_sortedItems[middle] == itemIndex)
      return (false);
-
- /* This item is not in this state yet, so add it */
-
- if (p_DFAstate->itemsInState == MAX_ITEMS_PER_DFA_STATE) {
-   p_LR0item = &LR0items[itemCode - ITEM_START_CODE];
-   snprintf (
-     ERROR_auxErrorMsg,
-   ERROR_maxErrorMsgSize,
-     "Unable to add LR(0) item %d {%u,%u} to state %d: array overflow\n",
-     itemCode,
-     p_LR0item->ruleNumber,
-     p_LR0item->dotPosition,
-     stateCode );
-   ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+   if (p_sortedItems[middle] < itemIndex)
+     low = middle + 1;
+   else
+     high = middle;
  }
- p_DFAstate->itemIndex[p_DFAstate->itemsInState++] = itemCode - ITEM_START_CODE;
 
- /* Ensure that itemIndex array is always sorted */
- 
- /*
- qsort (
-   (void *)                              &p_DFAstate->itemIndex[0],
-   (size_t)                              p_DFAstate->itemsInState,
-   (size_t)                              sizeof (p_DFAstate->itemIndex[0]),
-   (int (*)(const void *, const void *)) compare_LR0items );
-*/
+ /* This item is not in this state yet, so add it at the end of the pool */
+ /* and at its place in the sorted run                                    */
+
+ if (nextDFAitem == maxDFAitems) {
+   maxDFAitems = (maxDFAitems == 0) ? INITIAL_DFA_POOL_SIZE : 2 * maxDFAitems;
+   if ((p_newPool = realloc (DFAitems, maxDFAitems * sizeof (DFAitems[0]))) == NULL)
+     ERROR_no_memory (0, __FILE__, __func__, "DFAitems");
+   DFAitems = (int *) p_newPool;
+   if ((p_newPool = realloc (DFAsortedItems, maxDFAitems * sizeof (DFAsortedItems[0]))) == NULL)
+     ERROR_no_memory (0, __FILE__, __func__, "DFAsortedItems");
+   DFAsortedItems = (int *) p_newPool;
+   p_sortedItems = &DFAsortedItems[DFAstateFirstItem[stateIndex]];
+ }
+ memmove (
+   &p_sortedItems[low + 1],
+   &p_sortedItems[low],
+   (DFAstateTotItems[stateIndex] - low) * sizeof (DFAsortedItems[0]) );
+ p_sortedItems[low] = itemIndex;
+ DFAitems[nextDFAitem++] = itemIndex;
+ DFAstateTotItems[stateIndex]++;
+ DFAstateFingerprint[stateIndex] += dfa_itemFingerprint (itemIndex);
 
  /* If this is a reduction item then do nothing else  */
  /* (no transition is possible from a reduction item) */
 
- if (isReductionItem (itemCode))
+ if (LR0items[itemIndex].isReduction)
    return (true);
 
  /* May need to update transition symbols list */
 
- transitionSymbol = itemCode2transitionSymbol (itemCode);
- for (iSymbol = 0; iSymbol < p_DFAstate->totTransitionSymbols; iSymbol++)
-   if (p_DFAstate->transitionSymbols[iSymbol] == transitionSymbol)
+ transitionSymbol = LR0items[itemIndex].transitionSymbol;
+ p_stateSymbols = &DFAtransitionSymbols[DFAstateFirstSymbol[stateIndex]];
+ for (iSymbol = 0; iSymbol < DFAstateTotSymbols[stateIndex]; iSymbol++)
+   if (p_stateSymbols[iSymbol] == transitionSymbol)
      return (true);
 
  /* Indeed a new transition symbol in this state, so add it to the list */
 
- p_DFAstate->transitionSymbols[p_DFAstate->totTransitionSymbols++] = transitionSymbol;
+ if (nextDFAsymbol == maxDFAsymbols) {
+   maxDFAsymbols = (maxDFAsymbols == 0) ? INITIAL_DFA_POOL_SIZE : 2 * maxDFAsymbols;
+   if ((p_newPool = realloc (DFAtransitionSymbols, maxDFAsymbols * sizeof (DFAtransitionSymbols[0]))) == NULL)
+     ERROR_no_memory (0, __FILE__, __func__, "DFAtransitionSymbols");
+   DFAtransitionSymbols = (t_symbolCode *) p_newPool;
+ }
+ DFAtransitionSymbols[nextDFAsymbol++] = transitionSymbol;
+ DFAstateTotSymbols[stateIndex]++;
 
- /* Ensure that transitionSymbols array is always sorted */
+ /* Ensure that the transition symbols of the state are always sorted */
 
  qsort (
-   (void *)                              &p_DFAstate->transitionSymbols[0],
-   (size_t)                              p_DFAstate->totTransitionSymbols,
-   (size_t)                              sizeof (p_DFAstate->transitionSymbols[0]),
+   (void *)                              &DFAtransitionSymbols[DFAstateFirstSymbol[stateIndex]],
+   (size_t)                              DFAstateTotSymbols[stateIndex],
+   (size_t)                              sizeof (DFAtransitionSymbols[0]),
    (int (*)(const void *, const void *)) compare_symbolCodes );
 
  return (true);
@@ -2041,14 +3028,20 @@ static void nfa_newTransition (t_stateCode fromState, t_symbolCode withSymbol, t
      ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
  }
 
- /* Make sure we don't add an existing transition twice */
+ /* Make sure we don't add an existing transition twice. The NFA is built */
+ /* state by state, so any duplicate must be among the latest transitions  */
+ /* and there is no need to look past the first one from another state     */
 
- for (iTransition = 0; iTransition < totNFAtransitions; iTransition++) {
+ for (iTransition = totNFAtransitions; iTransition-- > 0; ) {
    p_NFAtransition = &NFAtransitions[iTransition];
+   if (p_NFAtransition->fromState != fromState)
+     break;
    if ((p_NFAtransition->fromState  == fromState ) &&
        (p_NFAtransition->withSymbol == withSymbol) &&
-       (p_NFAtransition->toState    == toState   ) )
+       (p_NFAtransition->toState    == toState   ) ) {
+     cnt_nfaDuplicateTransitions++;
      return;
+   }
  }
 
  /* This is not a duplicate transition, so add it */
@@ -2066,6 +3059,7 @@ static void nfa_newTransition (t_stateCode fromState, t_symbolCode withSymbol, t
  p_symbolData->totNFAtransitionsWithSymbol++;
  NFAstates[toState - NFA_STATE_START_CODE].totInwardTransitions++;
  totNFAtransitions++;
+ b_NFAtransitionViewsBuilt = false;
 }
 
 /*
@@ -2111,8 +3105,10 @@ static void dfa_newTransition (t_stateCode fromState, t_symbolCode withSymbol, t
    p_DFAtransition = &DFAtransitions[iTransition];
    if ((p_DFAtransition->fromState  == fromState ) &&
        (p_DFAtransition->withSymbol == withSymbol) &&
-       (p_DFAtransition->toState    == toState   ) )
+       (p_DFAtransition->toState    == toState   ) ) {
+     cnt_dfaDuplicateTransitions++;
      return;
+   }
  }
 
  /* This is not a duplicate transition, so add it */
@@ -2127,80 +3123,195 @@ static void dfa_newTransition (t_stateCode fromState, t_symbolCode withSymbol, t
  p_DFAtransition->toState    = toState;
 
  p_symbolData->totDFAtransitionsWithSymbol++;
- DFAstates[toState - DFA_STATE_START_CODE].totInwardTransitions++;
+ DFAstateTotInward[toState - DFA_STATE_START_CODE]++;
  totDFAtransitions++;
+ b_DFAtransitionViewsBuilt = false;
+ b_DFAnextStateIndexBuilt = false;
 }
 
 /*
 *----------------------------------------------------------------------------
-* Sort array of NFA state transitions using sort key provided
+* Work out the order of a set of transitions under each sort key with a
+* counting sort, which is stable: transitions with the same key stay in
+* the order they were created in. views holds one row of maxTransitions
+* transition numbers per sort key.
 *----------------------------------------------------------------------------
 */
 
-void nfa_sortTransitions (t_transitionSortKey sortKey)
+static void build_transition_views (const t_stateTransition *transitions, unsigned int totTransitions, unsigned int *views, unsigned int maxTransitions)
 {
- switch (sortKey) {
-   case (t_transitionSortKey_origin):
-     qsort (
-       (void *)                              &NFAtransitions[0],
-       (size_t)                              totNFAtransitions,
-       (size_t)                              sizeof (t_stateTransition),
-       (int (*)(const void *, const void *)) compare_transitions_key_origin );
-     break;
-   case (t_transitionSortKey_symbol):
-     qsort (
-       (void *)                              &NFAtransitions[0],
-       (size_t)                              totNFAtransitions,
-       (size_t)                              sizeof (t_stateTransition),
-       (int (*)(const void *, const void *)) compare_transitions_key_symbol );
-     break;
-   case (t_transitionSortKey_destination):
-     qsort (
-       (void *)                              &NFAtransitions[0],
-       (size_t)                              totNFAtransitions,
-       (size_t)                              sizeof (t_stateTransition),
-       (int (*)(const void *, const void *)) compare_transitions_key_destination );
-    break;
-   default:
-     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Invalid transition sort key %d\n", sortKey);
-     ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+ unsigned int
+   iTransition,
+   iKey,
+   totKeys,
+   position,
+   *keyCounts;
+ int
+   key,
+   minKey,
+   maxKey;
+ t_transitionSortKey
+   sortKey;
+
+ for (sortKey = t_transitionSortKey_origin; sortKey < t_transitionSortKey_total; sortKey++) {
+   if (totTransitions == 0)
+     continue;
+
+   /* Find the range of keys and count the transitions with each key */
+
+   minKey = maxKey = 0;
+   for (iTransition = 0; iTransition < totTransitions; iTransition++) {
+     switch (sortKey) {
+       case (t_transitionSortKey_origin): key = transitions[iTransition].fromState;  break;
+       case (t_transitionSortKey_symbol): key = transitions[iTransition].withSymbol; break;
+       default:                           key = transitions[iTransition].toState;    break;
+     }
+     if ((iTransition == 0) || (key < minKey))
+       minKey = key;
+     if ((iTransition == 0) || (key > maxKey))
+       maxKey = key;
+   }
+   totKeys = (unsigned int) (maxKey - minKey) + 1;
+   if ((keyCounts = (unsigned int *) calloc (totKeys + 1, sizeof (unsigned int))) == NULL)
+     ERROR_no_memory (0, __FILE__, __func__, "keyCounts");
+   for (iTransition = 0; iTransition < totTransitions; iTransition++) {
+     switch (sortKey) {
+       case (t_transitionSortKey_origin): key = transitions[iTransition].fromState;  break;
+       case (t_transitionSortKey_symbol): key = transitions[iTransition].withSymbol; break;
+       default:                           key = transitions[iTransition].toState;    break;
+     }
+     keyCounts[key - minKey + 1]++;
+   }
+
+   /* Turn the counts into the first position of each key, then place the transitions */
+
+   for (iKey = 1; iKey < totKeys; iKey++)
+     keyCounts[iKey] += keyCounts[iKey - 1];
+   for (iTransition = 0; iTransition < totTransitions; iTransition++) {
+     switch (sortKey) {
+       case (t_transitionSortKey_origin): key = transitions[iTransition].fromState;  break;
+       case (t_transitionSortKey_symbol): key = transitions[iTransition].withSymbol; break;
+       default:                           key = transitions[iTransition].toState;    break;
+     }
+     position = keyCounts[key - minKey]++;
+     views[sortKey * maxTransitions + position] = iTransition + 1;
+   }
+   free (keyCounts);
  }
 }
 
 /*
 *----------------------------------------------------------------------------
-* Sort array of DFA state transitions using sort key provided
+* Take a sort key and a position (1 onwards) in the NFA state transitions
+* sorted by that key, and return the number of the transition found there
 *----------------------------------------------------------------------------
 */
 
-void dfa_sortTransitions (t_transitionSortKey sortKey)
+unsigned int nfa_sortedTransition2transitionNumber (t_transitionSortKey sortKey, unsigned int position)
 {
- switch (sortKey) {
-   case (t_transitionSortKey_origin):
-     qsort (
-       (void *)                              &DFAtransitions[0],
-       (size_t)                              totDFAtransitions,
-       (size_t)                              sizeof (t_stateTransition),
-       (int (*)(const void *, const void *)) compare_transitions_key_origin );
-     break;
-   case (t_transitionSortKey_symbol):
-     qsort (
-       (void *)                              &DFAtransitions[0],
-       (size_t)                              totDFAtransitions,
-       (size_t)                              sizeof (t_stateTransition),
-       (int (*)(const void *, const void *)) compare_transitions_key_symbol );
-     break;
-   case (t_transitionSortKey_destination):
+ if ((sortKey < t_transitionSortKey_origin) || (sortKey >= t_transitionSortKey_total)) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Invalid transition sort key %d\n", sortKey);
+   ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+ }
+ if ((position < 1) || (position > totNFAtransitions)) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Invalid NFA transition position %u\n", position);
+   ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+ }
+ if (! b_NFAtransitionViewsBuilt) {
+   build_transition_views (NFAtransitions, totNFAtransitions, &NFAtransitionViews[0][0], MAX_NFA_TRANSITIONS);
+   b_NFAtransitionViewsBuilt = true;
+ }
+ return (NFAtransitionViews[sortKey][position - 1]);
+}
+
+/*
+*----------------------------------------------------------------------------
+* Work out, for every NFA state, the ordered list of transition numbers
+* returned by nfa_stateCode2transitionNumber(): the transition with a
+* terminal or non-terminal first, then the epsilon transitions sorted
+* by the rule number of their destination states
+*----------------------------------------------------------------------------
+*/
+
+static void nfa_orderTransitions (void)
+{
+ unsigned int
+   iState,
+   iTransition,
+   firstTransition,
+   totEpsilonTransitions [MAX_NFA_STATES];
+ t_NFAstate
+   *p_NFAstate;
+ t_stateTransition
+   *p_NFAtransition;
+
+ /* Each state's list starts right after the previous state's list */
+
+ for (iState = 0, firstTransition = 0; iState < nfa_nextState; iState++) {
+   p_NFAstate = &NFAstates[iState];
+   p_NFAstate->firstOrderedTransition = firstTransition;
+   firstTransition += p_NFAstate->totOutwardTransitions;
+   if (p_NFAstate->totOutwardTransitions > 0)
+     NFAorderedTransitions[p_NFAstate->firstOrderedTransition] = 0;
+   totEpsilonTransitions[iState] = 0;
+ }
+
+ /* Put the transition with a terminal or non-terminal in the first  */
+ /* position of its list, and epsilon transitions after it, in order */
+
+ for (iTransition = 0; iTransition < totNFAtransitions; iTransition++) {
+   p_NFAtransition = &NFAtransitions[iTransition];
+   iState = p_NFAtransition->fromState - NFA_STATE_START_CODE;
+   p_NFAstate = &NFAstates[iState];
+   if (p_NFAtransition->withSymbol != epsilon_code) {
+     if (NFAorderedTransitions[p_NFAstate->firstOrderedTransition] != 0) {
+       snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "NFA state %d has more than one transition with a terminal or non-terminal\n", p_NFAtransition->fromState);
+       ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+     }
+     NFAorderedTransitions[p_NFAstate->firstOrderedTransition] = iTransition + 1;
+   }
+   else {
+     if (totEpsilonTransitions[iState] + 1 >= p_NFAstate->totOutwardTransitions) {
+       snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Too many epsilon transitions from NFA state %d\n", p_NFAtransition->fromState);
+       ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+     }
+     NFAorderedTransitions[p_NFAstate->firstOrderedTransition + 1 + totEpsilonTransitions[iState]++] = iTransition + 1;
+   }
+ }
+
+ /* Sort each state's epsilon transitions by destination rule number */
+
+ for (iState = 0; iState < nfa_nextState; iState++)
+   if (totEpsilonTransitions[iState] > 1)
      qsort (
-       (void *)                              &DFAtransitions[0],
-       (size_t)                              totDFAtransitions,
-       (size_t)                              sizeof (t_stateTransition),
-       (int (*)(const void *, const void *)) compare_transitions_key_destination );
-    break;
-   default:
-     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Invalid transition sort key %d\n", sortKey);
-     ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+       (void *)                              &NFAorderedTransitions[NFAstates[iState].firstOrderedTransition + 1],
+       (size_t)                              totEpsilonTransitions[iState],
+       (size_t)                              sizeof (unsigned int),
+       (int (*)(const void *, const void *)) compare_transitions_dest_rule );
+}
+
+/*
+*----------------------------------------------------------------------------
+* Take a sort key and a position (1 onwards) in the DFA state transitions
+* sorted by that key, and return the number of the transition found there
+*----------------------------------------------------------------------------
+*/
+
+unsigned int dfa_sortedTransition2transitionNumber (t_transitionSortKey sortKey, unsigned int position)
+{
+ if ((sortKey < t_transitionSortKey_origin) || (sortKey >= t_transitionSortKey_total)) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Invalid transition sort key %d\n", sortKey);
+   ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
  }
+ if ((position < 1) || (position > totDFAtransitions)) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Invalid DFA transition position %u\n", position);
+   ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+ }
+ if (! b_DFAtransitionViewsBuilt) {
+   build_transition_views (DFAtransitions, totDFAtransitions, &DFAtransitionViews[0][0], MAX_DFA_TRANSITIONS);
+   b_DFAtransitionViewsBuilt = true;
+ }
+ return (DFAtransitionViews[sortKey][position - 1]);
 }
 
 /*
@@ -2409,48 +3520,39 @@ unsigned int dfa_stateCode2stateNumber (t_stateCode stateCode)
 
 /*
 *----------------------------------------------------------------------------
-* Take a DFA state code and return a boolean indicating whether
-* it is a duplicate of an existing state
+* Mix the position of an LR(0) item into 64 bits (the splitmix64 finalizer).
+* A state's fingerprint is the sum of these over its items, so it does not
+* depend on the order the items were added in.
 *----------------------------------------------------------------------------
 */
 
-static bool dfa_isDuplicateState (t_stateCode stateCode)
+static uint64_t dfa_itemFingerprint (int itemIndex)
 {
- int
-   iState,
-   iIndex,
-   iTransition,
-   stateIndex;
- t_DFAstate
-   *p_DFAstate,
-   *p_state;
- bool
-   isDuplicate;
+ uint64_t
+   x;
 
- /* Ensure the state code provided really is a DFA state */
+ x = (uint64_t) itemIndex + UINT64_C(0x9E3779B97F4A7C15);
+ x = (x ^ (x >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+ x = (x ^ (x >> 27)) * UINT64_C(0x94D049BB133111EB);
+ return (x ^ (x >> 31));
+}
 
- snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "NFA state %d provided to %s(); expected DFA state\n", stateCode, __func__);
- validate_state_FSA_type (stateCode, t_DFA, ERROR_auxErrorMsg);
+/*
+*----------------------------------------------------------------------------
+* Check whether two DFA states hold the same LR(0) items (and therefore the
+* same transition symbols). The fingerprints and sizes tell almost all
+* states apart; the sorted runs are compared only when those match.
+*----------------------------------------------------------------------------
+*/
 
- stateIndex = stateCode - DFA_STATE_START_CODE;
- p_DFAstate = &DFAstates[stateIndex];
- for (iState = 0; iState < (int) dfa_nextState; iState++) {
-   if (iState == stateIndex)
-     break;
-   p_state = &DFAstates[iState];
-   isDuplicate = (bool) (p_state->itemsInState == p_DFAstate->itemsInState);
-   if (isDuplicate)
-     for (iIndex = 0; iIndex < (int) p_state->itemsInState; iIndex++)
-       isDuplicate &= (p_state->itemIndex[iIndex] == p_DFAstate->itemIndex[iIndex]);
-   if (isDuplicate)
-     isDuplicate &= (p_state->totTransitionSymbols == p_DFAstate->totTransitionSymbols);
-   if (isDuplicate)
-     for (iTransition = 0; iTransition < (int) p_state->totTransitionSymbols; iTransition++)
-       isDuplicate &= (p_state->transitionSymbols[iTransition] == p_DFAstate->transitionSymbols[iTransition]);
-   if (isDuplicate)
-     return (true);
- }
- return (false);
+static bool dfa_areSameState (unsigned int stateIndex1, unsigned int stateIndex2)
+{
+ if ((DFAstateFingerprint[stateIndex1] != DFAstateFingerprint[stateIndex2]) ||
+     (DFAstateTotItems[stateIndex1]    != DFAstateTotItems[stateIndex2]))
+   return (false);
+ return ((bool) (memcmp (&DFAsortedItems[DFAstateFirstItem[stateIndex1]],
+                         &DFAsortedItems[DFAstateFirstItem[stateIndex2]],
+                         DFAstateTotItems[stateIndex1] * sizeof (DFAsortedItems[0])) == 0));
 }
 
 /*
@@ -2467,7 +3569,7 @@ static bool nfa_isEmptyState (t_stateCode stateCode)
  snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "DFA state %d provided to %s(); expected NFA state\n", stateCode, __func__);
  validate_state_FSA_type (stateCode, t_NFA, ERROR_auxErrorMsg);
 
- return ((bool) (DFAstates[stateCode - DFA_STATE_START_CODE].itemsInState == 0));
+ return ((bool) (NFAstates[stateCode - NFA_STATE_START_CODE].itemIndex == UNKNOWN_ITEM_INDEX));
 }
 
 /*
@@ -2484,7 +3586,7 @@ static bool dfa_isEmptyState (t_stateCode stateCode)
  snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "NFA state %d provided to %s(); expected DFA state\n", stateCode, __func__);
  validate_state_FSA_type (stateCode, t_DFA, ERROR_auxErrorMsg);
 
- return ((bool) (DFAstates[stateCode - DFA_STATE_START_CODE].itemsInState == 0));
+ return ((bool) (DFAstateTotItems[stateCode - DFA_STATE_START_CODE] == 0));
 }
 
 /*
@@ -2497,40 +3599,19 @@ static bool dfa_isEmptyState (t_stateCode stateCode)
 
 static t_stateCode dfa_stateCode2duplicateStateCode (t_stateCode stateCode)
 {
- int
+ unsigned int
    iState,
-   iIndex,
-   iTransition,
    stateIndex;
- t_DFAstate
-   *p_DFAstate,
-   *p_state;
- bool
-   isDuplicate;
 
  /* Ensure the state code provided really is a DFA state */
 
  snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "NFA state %d provided to %s(); expected DFA state\n", stateCode, __func__);
  validate_state_FSA_type (stateCode, t_DFA, ERROR_auxErrorMsg);
 
- stateIndex = stateCode - DFA_STATE_START_CODE;
- p_DFAstate = &DFAstates[stateIndex];
- for (iState = 0; iState < (int) dfa_nextState; iState++) {
-   if (iState == stateIndex)
-     break;
-   p_state = &DFAstates[iState];
-   isDuplicate = (bool) (p_state->itemsInState == p_DFAstate->itemsInState);
-   if (isDuplicate)
-     for (iIndex = 0; iIndex < (int) p_state->itemsInState; iIndex++)
-       isDuplicate &= (p_state->itemIndex[iIndex] == p_DFAstate->itemIndex[iIndex]);
-   if (isDuplicate)
-     isDuplicate &= (p_state->totTransitionSymbols == p_DFAstate->totTransitionSymbols);
-   if (isDuplicate)
-     for (iTransition = 0; iTransition < (int) p_state->totTransitionSymbols; iTransition++)
-       isDuplicate &= (p_state->transitionSymbols[iTransition] == p_DFAstate->transitionSymbols[iTransition]);
-   if (isDuplicate)
+ stateIndex = (unsigned int) (stateCode - DFA_STATE_START_CODE);
+ for (iState = 0; iState < stateIndex; iState++)
+   if (dfa_areSameState (iState, stateIndex))
      return ((t_stateCode) (iState + DFA_STATE_START_CODE));
- }
  return ((t_stateCode) UNKNOWN_STATE_CODE);
 }
 
@@ -2547,7 +3628,7 @@ unsigned int dfa_stateCode2totItems (t_stateCode stateCode)
  snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "NFA state %d provided to %s(); expected DFA state\n", stateCode, __func__);
  validate_state_FSA_type (stateCode, t_DFA, ERROR_auxErrorMsg);
 
- return (DFAstates[stateCode - DFA_STATE_START_CODE].itemsInState);
+ return (DFAstateTotItems[stateCode - DFA_STATE_START_CODE]);
 }
 
 /*
@@ -2575,20 +3656,20 @@ t_itemCode nfa_stateCode2itemCode (t_stateCode stateCode)
 
 t_itemCode dfa_stateCode2itemCode (t_stateCode stateCode, unsigned int itemNumber)
 {
- t_DFAstate
-   *p_DFAstate;
+ unsigned int
+   stateIndex;
 
  /* Ensure the state code provided really is a DFA state */
 
  snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "NFA state %d passed to %s(); expected DFA state\n", stateCode, __func__);
  validate_state_FSA_type (stateCode, t_DFA, ERROR_auxErrorMsg);
 
- p_DFAstate = &DFAstates[stateCode - DFA_STATE_START_CODE];
- if (itemNumber > p_DFAstate->itemsInState) {
+ stateIndex = (unsigned int) (stateCode - DFA_STATE_START_CODE);
+ if ((itemNumber < 1) || (itemNumber > DFAstateTotItems[stateIndex])) {
    snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Invalid DFA item number %u in state %d\n", itemNumber, stateCode);
    ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
  }
- return (p_DFAstate->itemIndex[itemNumber-1] + ITEM_START_CODE);
+ return (DFAitems[DFAstateFirstItem[stateIndex] + itemNumber - 1] + ITEM_START_CODE);
 }
 
 /*
@@ -2622,7 +3703,7 @@ unsigned int dfa_stateCode2totTransitionsFromState (t_stateCode stateCode)
  snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "NFA state %d passed to %s(); expected DFA state\n", stateCode, __func__);
  validate_state_FSA_type (stateCode, t_DFA, ERROR_auxErrorMsg);
 
- return (DFAstates[stateCode - DFA_STATE_START_CODE].totTransitionSymbols);
+ return (DFAstateTotSymbols[stateCode - DFA_STATE_START_CODE]);
 }
 
 /*
@@ -2656,7 +3737,7 @@ unsigned int dfa_stateCode2totTransitionsToState (t_stateCode stateCode)
  snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "NFA state %d passed to %s(); expected DFA state\n", stateCode, __func__);
  validate_state_FSA_type (stateCode, t_DFA, ERROR_auxErrorMsg);
 
- return (DFAstates[stateCode - DFA_STATE_START_CODE].totInwardTransitions);
+ return (DFAstateTotInward[stateCode - DFA_STATE_START_CODE]);
 }
 
 /*
@@ -2744,6 +3825,8 @@ t_symbolCode nfa_stateCode2transitionSymbol (t_stateCode stateCode, unsigned int
 *   there will also be epsilon transitions, one for each of the transition symbol's rules.
 * IMPORTANT:
 * - For epsilon transitions, the returned values will be sorted by the destination state's rule number.
+* - These ordered lists are worked out once for all states by nfa_orderTransitions(),
+*   so this method is a simple table look up.
 *
 * Example:
 *
@@ -2764,30 +3847,10 @@ t_symbolCode nfa_stateCode2transitionSymbol (t_stateCode stateCode, unsigned int
 * - nfa_stateCode2transitionNumber (5, 4) causes an error, as there are only 3 transitions from this state
 *-------------------------------------------------------------------------------------------------------------
 */
-typedef struct {
-  unsigned int transitionNumber;
-  t_ruleNumber transitionDestRuleNumber; 
-}
-  t_epsilonTransition;
-
-static int compareRuleNumbers (const void *trans1, const void *trans2) 
-{
-  return ( ((t_epsilonTransition *) trans1)->transitionDestRuleNumber - ((t_epsilonTransition *) trans2)->transitionDestRuleNumber);
-}
-
 unsigned int nfa_stateCode2transitionNumber (t_stateCode stateCode, unsigned int whichTransition)
 {
- t_symbolCode
-   transitionSymbol;
- t_symbolType
-   transitionSymbolType;
- int
-   iTransition,
-	 epsilonTransitionsFound,
-   totTransitions,
-   totEpsilonTransitions;
- t_stateTransition
-   *p_transition;
+ t_NFAstate
+   *p_NFAstate;
 
  /* Ensure the state code provided really is a NFA state */
 
@@ -2808,64 +3871,12 @@ unsigned int nfa_stateCode2transitionNumber (t_stateCode stateCode, unsigned int
    snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Invalid transition %u in NFA state %d; must be > 0\n", whichTransition, stateCode);
    ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
  }
-
- transitionSymbol = itemCode2transitionSymbol (nfa_stateCode2itemCode (stateCode));
- transitionSymbolType = symbolCode2symbolType (transitionSymbol);
- switch (transitionSymbolType) {
-   case (t_terminal):
-	 case (t_endOfInput): {
-     for (iTransition = 0, p_transition = NFAtransitions; iTransition < totNFAtransitions; iTransition++, p_transition++) {
-       if ((p_transition->fromState == stateCode) && (p_transition->withSymbol == transitionSymbol))
-         return (iTransition + 1);
-     }
-     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Unable to find transition from NFA state %d with symbol %u\n", stateCode, transitionSymbol);
-     ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
-	 }
-   case (t_nonTerminal): {
-     totEpsilonTransitions = symbolCode2totUses (transitionSymbol, t_lefthand);
-     totTransitions = totEpsilonTransitions + 1;
-     if ((whichTransition > totTransitions)) {
-       snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Invalid transition ordinal %u; NFA state %d has only %d transitions\n", whichTransition, stateCode, totTransitions);
-       ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
-     }
-		 t_epsilonTransition
-       epsilonTransitions [totEpsilonTransitions];
-     epsilonTransitionsFound = 0;
-     for (iTransition = 0, p_transition = NFAtransitions; iTransition < totNFAtransitions; iTransition++, p_transition++) {
-       if (p_transition->fromState != stateCode)
-         continue;
-       if ((p_transition->withSymbol == transitionSymbol) && (whichTransition == 1)) {
-			   return (iTransition + 1);
-			 }
-       if (p_transition->withSymbol == epsilon_code) {
-			   epsilonTransitions[epsilonTransitionsFound].transitionNumber = iTransition + 1;
-				 epsilonTransitions[epsilonTransitionsFound].transitionDestRuleNumber = itemCode2ruleNumber (nfa_stateCode2itemCode (p_transition->toState));
-				 epsilonTransitionsFound++;
-			   continue;
-       }
-     }
-     if (epsilonTransitionsFound != totEpsilonTransitions) {
-       snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Expected %d epsilon transitions from NFA state %d, found %d\n", totEpsilonTransitions, stateCode, epsilonTransitionsFound);
-       ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
-     }
-		 /* Sort transitions by rule number */
-		 qsort (epsilonTransitions, epsilonTransitionsFound, sizeof (epsilonTransitions[0]), compareRuleNumbers);
-		 return (epsilonTransitions[whichTransition-2].transitionNumber);
-	 }
-   case (t_epsilon): {
-     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Invalid transition symbol type %d\n", transitionSymbolType);
-     ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
-     break;
-	 }
-   default: {
-     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Unknown transition symbol type %d\n", transitionSymbolType);
-     ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
-	 }
- }
- if (iTransition == totNFAtransitions) {
-   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Unable to find transition ordinal %d from NFA state %d\n", whichTransition, stateCode);
+ p_NFAstate = &NFAstates[stateCode - NFA_STATE_START_CODE];
+ if (whichTransition > p_NFAstate->totOutwardTransitions) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Invalid transition ordinal %u; NFA state %d has only %u transitions\n", whichTransition, stateCode, p_NFAstate->totOutwardTransitions);
    ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
  }
+ return (NFAorderedTransitions[p_NFAstate->firstOrderedTransition + whichTransition - 1]);
 }
 
 /*
@@ -2957,8 +3968,6 @@ t_symbolCode dfa_stateCode2transitionSymbol (t_stateCode stateCode, unsigned int
    itemCode;
  t_symbolCode
    thisTransSymbol;
- t_DFAstate
-   *p_DFAstate;
 
  /* Ensure the state code provided really is a DFA state */
 
@@ -2982,8 +3991,7 @@ t_symbolCode dfa_stateCode2transitionSymbol (t_stateCode stateCode, unsigned int
 
  /* Now we know this is not a reduction state, so there must be at least one state transition */
  
- p_DFAstate = &DFAstates[stateCode - DFA_STATE_START_CODE];
- totTransSymbolsExpected = p_DFAstate->totTransitionSymbols;
+ totTransSymbolsExpected = (int) DFAstateTotSymbols[stateCode - DFA_STATE_START_CODE];
  if (whichSymbol > totTransSymbolsExpected) {
    snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Invalid symbol ordinal %u; DFA state %d has only %d transitions\n", whichSymbol, stateCode, totTransSymbolsExpected);
    ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
@@ -3118,27 +4126,24 @@ unsigned int dfa_stateCode2totReductions (t_stateCode stateCode)
 {
  unsigned int
    iItem,
+   stateIndex,
    totReductions;
- t_DFAstate
-   *p_DFAstate;
- t_LR0item
-   *p_LR0item;
+ const int
+   *p_stateItems;
 
  /* Ensure the state code provided really is a DFA state */
 
  snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "NFA state %d passed to %s(); expected DFA state\n", stateCode, __func__);
  validate_state_FSA_type (stateCode, t_DFA, ERROR_auxErrorMsg);
 
- p_DFAstate = &DFAstates[stateCode - DFA_STATE_START_CODE];
+ stateIndex = (unsigned int) (stateCode - DFA_STATE_START_CODE);
+ p_stateItems = &DFAitems[DFAstateFirstItem[stateIndex]];
 
- for (totReductions = iItem = 0; iItem < p_DFAstate->itemsInState; iItem++) {
-
-   /* In a reduction state the dot is at the end of the rule */
+ /* In a reduction state the dot is at the end of the rule */
 
-   p_LR0item = &LR0items[p_DFAstate->itemIndex[iItem]];
-   if (p_LR0item->dotPosition == grammarRules[p_LR0item->ruleNumber-1].righthandSize)
+ for (totReductions = iItem = 0; iItem < DFAstateTotItems[stateIndex]; iItem++)
+   if (LR0items[p_stateItems[iItem]].isReduction)
      ++totReductions;
- }
  return (totReductions);
 }
 
@@ -3179,9 +4184,10 @@ t_ruleNumber dfa_stateCode2reductionRule (t_stateCode stateCode, unsigned int re
 {
  unsigned int
    iItem,
+   stateIndex,
    totReductions;
- t_DFAstate
-   *p_DFAstate;
+ const int
+   *p_stateItems;
  t_LR0item
    *p_LR0item;
 
@@ -3190,14 +4196,15 @@ t_ruleNumber dfa_stateCode2reductionRule (t_stateCode stateCode, unsigned int re
  snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "NFA state %d passed to %s(); expected DFA state\n", stateCode, __func__);
  validate_state_FSA_type (stateCode, t_DFA, ERROR_auxErrorMsg);
 
- p_DFAstate = &DFAstates[stateCode - DFA_STATE_START_CODE];
+ stateIndex = (unsigned int) (stateCode - DFA_STATE_START_CODE);
+ p_stateItems = &DFAitems[DFAstateFirstItem[stateIndex]];
 
- for (totReductions = iItem = 0; iItem < p_DFAstate->itemsInState; iItem++) {
+ for (totReductions = iItem = 0; iItem < DFAstateTotItems[stateIndex]; iItem++) {
 
    /* In a reduction state the dot is at the end of the rule */
 
-   p_LR0item = &LR0items[p_DFAstate->itemIndex[iItem]];
-   if (p_LR0item->dotPosition == grammarRules[p_LR0item->ruleNumber-1].righthandSize) {
+   p_LR0item = &LR0items[p_stateItems[iItem]];
+   if (p_LR0item->isReduction) {
      if (++totReductions == reductionNumber)
        return (p_LR0item->ruleNumber);
    }
@@ -3237,46 +4244,94 @@ bool nfa_isReductionState (t_stateCode stateCode)
 
 /*
 *----------------------------------------------------------------------------
-* Take a DFA state code and delete it
+* Take a DFA state code and delete it. Only the state created last can
+* be deleted, which is all dfa_gotoState() needs; its items and transition
+* symbols are then at the end of their pools and are simply dropped.
 *----------------------------------------------------------------------------
 */
 
 static void dfa_removeState (t_stateCode stateCode)
 {
- int
+ unsigned int
    stateIndex;
- int
-   iItem,
-   iSymbol;
- t_DFAstate
-   *p_DFAstate;
 
- /* Ensure the state code provided really is a DFA state */
+ /* Ensure the state code provided really is a DFA state, and the last one */
+
+ snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "NFA state %d passed to %s(); expected DFA state\n", stateCode, __func__);
+ validate_state_FSA_type (stateCode, t_DFA, ERROR_auxErrorMsg);
+ stateIndex = (unsigned int) (stateCode - DFA_STATE_START_CODE);
+ if (stateIndex != dfa_nextState - 1) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Attempt to remove DFA state %d; only the last state (%u) can be removed\n",
+     stateCode, dfa_nextState - 1 + DFA_STATE_START_CODE);
+   ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+ }
+
+ nextDFAitem   = DFAstateFirstItem[stateIndex];
+ nextDFAsymbol = DFAstateFirstSymbol[stateIndex];
+ DFAstateTotItems[stateIndex] = DFAstateTotInward[stateIndex] = DFAstateTotSymbols[stateIndex] = 0;
+ dfa_nextState--;
+ totDFAstates--;
+}
+
+/*
+*---------------------------------------------------------------------
+* Build the next state index of the DFA, in dense form if the matrix
+* is small enough and in sparse form otherwise
+*---------------------------------------------------------------------
+*/
+
+static void dfa_buildNextStateIndex (void)
+{
+ unsigned int
+   iState,
+   iTransition,
+   stateIndex;
+ t_stateTransition
+   *p_DFAtransition;
+
+ free (DFAnextStateMatrix);
+ free (DFAnextStateFirst);
+ free (DFAnextStateRuns);
+ DFAnextStateMatrix = NULL;
+ DFAnextStateFirst = DFAnextStateRuns = NULL;
 
- snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "NFA state %d passed to %s(); expected DFA state\n", stateCode, __func__);
- validate_state_FSA_type (stateCode, t_DFA, ERROR_auxErrorMsg);
+ DFAnextStateCols = totTerminals + totNonTerminals + 1;
+ b_DFAnextStateIndexDense = ((size_t) totDFAstates * DFAnextStateCols <= MAX_DENSE_NEXT_STATE_CELLS);
 
- stateIndex = stateCode - DFA_STATE_START_CODE;
+ if (b_DFAnextStateIndexDense) {
 
- /* If this state is not at the very end of the    */
- /* DFAstates array then shift down array contents */
+   /* UNKNOWN_STATE_CODE is 0, so calloc() leaves every cell without a next state */
 
- if (stateIndex < (int) dfa_nextState - 1)
-   memmove (
-     &DFAstates[stateIndex],
-     &DFAstates[stateIndex + 1],
-     (dfa_nextState - stateIndex - 1) * (sizeof (t_DFAstate)) );
-
- /* Now clear the element at the end of the array */
-
- p_DFAstate = &DFAstates[--dfa_nextState];
- p_DFAstate->itemsInState = 0;
- for (iItem = 0; iItem < MAX_ITEMS_PER_DFA_STATE; iItem++)
-   p_DFAstate->itemIndex[iItem] = UNKNOWN_ITEM_CODE;
- p_DFAstate->totInwardTransitions = p_DFAstate->totTransitionSymbols = 0;
- for (iSymbol = 0; iSymbol < MAX_TRANSITIONS_PER_DFA_STATE; iSymbol++)
-   p_DFAstate->transitionSymbols[iSymbol] = UNKNOWN_SYMBOL_CODE;
- totDFAstates--;
+   if ((DFAnextStateMatrix = (t_stateCode *) calloc ((size_t) totDFAstates * DFAnextStateCols + 1, sizeof (t_stateCode))) == NULL)
+     ERROR_no_memory (0, __FILE__, __func__, "DFAnextStateMatrix");
+   for (iTransition = 0; iTransition < totDFAtransitions; iTransition++) {
+     p_DFAtransition = &DFAtransitions[iTransition];
+     stateIndex = (unsigned int) (p_DFAtransition->fromState - DFA_STATE_START_CODE);
+     DFAnextStateMatrix[(size_t) stateIndex * DFAnextStateCols + symbolCode2parseTableCol (p_DFAtransition->withSymbol)] = p_DFAtransition->toState;
+   }
+ }
+ else {
+
+   /* Count the transitions from each state and place them; placing */
+   /* moves each start position on to the next run, so shift back   */
+
+   if ((DFAnextStateFirst = (unsigned int *) calloc (totDFAstates + 1, sizeof (unsigned int))) == NULL)
+     ERROR_no_memory (0, __FILE__, __func__, "DFAnextStateFirst");
+   if ((DFAnextStateRuns = (unsigned int *) malloc ((totDFAtransitions + 1) * sizeof (unsigned int))) == NULL)
+     ERROR_no_memory (0, __FILE__, __func__, "DFAnextStateRuns");
+   for (iTransition = 0; iTransition < totDFAtransitions; iTransition++)
+     DFAnextStateFirst[DFAtransitions[iTransition].fromState - DFA_STATE_START_CODE + 1]++;
+   for (iState = 1; iState <= totDFAstates; iState++)
+     DFAnextStateFirst[iState] += DFAnextStateFirst[iState - 1];
+   for (iTransition = 0; iTransition < totDFAtransitions; iTransition++) {
+     stateIndex = (unsigned int) (DFAtransitions[iTransition].fromState - DFA_STATE_START_CODE);
+     DFAnextStateRuns[DFAnextStateFirst[stateIndex]++] = iTransition;
+   }
+   for (iState = totDFAstates; iState > 0; iState--)
+     DFAnextStateFirst[iState] = DFAnextStateFirst[iState - 1];
+   DFAnextStateFirst[0] = 0;
+ }
+ b_DFAnextStateIndexBuilt = true;
 }
 
 /*
@@ -3292,7 +4347,8 @@ static void dfa_removeState (t_stateCode stateCode)
 t_stateCode dfa_lookupNextState (t_stateCode fromState, t_symbolCode withSymbol)
 {
  unsigned int
-   iTransition;
+   iRun,
+   stateIndex;
  t_stateTransition
    *p_DFAtransition;
 
@@ -3301,10 +4357,18 @@ t_stateCode dfa_lookupNextState (t_stateCode fromState, t_symbolCode withSymbol)
  snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "NFA state %d passed to %s(); expected DFA state\n", fromState, __func__);
  validate_state_FSA_type (fromState, t_DFA, ERROR_auxErrorMsg);
 
- for (iTransition = 0; iTransition < totDFAtransitions; iTransition++) {
-   p_DFAtransition = &DFAtransitions[iTransition];
-   if ((p_DFAtransition->fromState  == fromState ) &&
-       (p_DFAtransition->withSymbol == withSymbol) )
+ if (! b_DFAnextStateIndexBuilt)
+   dfa_buildNextStateIndex ();
+ stateIndex = (unsigned int) (fromState - DFA_STATE_START_CODE);
+ if (stateIndex >= totDFAstates)
+   return (UNKNOWN_STATE_CODE);
+
+ if (b_DFAnextStateIndexDense)
+   return (DFAnextStateMatrix[(size_t) stateIndex * DFAnextStateCols + symbolCode2parseTableCol (withSymbol)]);
+
+ for (iRun = DFAnextStateFirst[stateIndex]; iRun < DFAnextStateFirst[stateIndex + 1]; iRun++) {
+   p_DFAtransition = &DFAtransitions[DFAnextStateRuns[iRun]];
+   if (p_DFAtransition->withSymbol == withSymbol)
      return (p_DFAtransition->toState);
  }
 
@@ -3314,6 +4378,20 @@ t_stateCode dfa_lookupNextState (t_stateCode fromState, t_symbolCode withSymbol)
  return (UNKNOWN_STATE_CODE);
 }
 
+/*
+*---------------------------------------------------------------------
+* Tell whether dfa_lookupNextState() reads a dense next state matrix
+* (true) or scans the transitions of each state (false)
+*---------------------------------------------------------------------
+*/
+
+bool dfa_isNextStateIndexDense (void)
+{
+ if (! b_DFAnextStateIndexBuilt)
+   dfa_buildNextStateIndex ();
+ return (b_DFAnextStateIndexDense);
+}
+
 /*
 *---------------------------------------------------------------------
 * Compute the goto(S,X) operation where
@@ -3362,6 +4440,7 @@ static t_stateCode dfa_gotoState (t_stateCode currStateCode, t_symbolCode transi
 
  snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "NFA state %d passed to %s(); expected DFA state\n", currStateCode, __func__);
  validate_state_FSA_type (currStateCode, t_DFA, ERROR_auxErrorMsg);
+ cnt_gotoCalls++;
 
  /* Create a new empty state */
 
@@ -3393,6 +4472,7 @@ static t_stateCode dfa_gotoState (t_stateCode currStateCode, t_symbolCode transi
  /* then remove the newly created state and return UNKNOWN_STATE_CODE  */
 
  if (dfa_isEmptyState (newStateCode)) {
+   cnt_gotoEmptyResults++;
    dfa_removeState (newStateCode);
    return (UNKNOWN_STATE_CODE);
  }
@@ -3404,8 +4484,9 @@ static t_stateCode dfa_gotoState (t_stateCode currStateCode, t_symbolCode transi
  /* if the complete state already exists, then remove this */
  /* latest duplicate and return the code of existing state */
 
- if (dfa_isDuplicateState (newStateCode)) {
-   duplicateStateCode = dfa_stateCode2duplicateStateCode (newStateCode);
+ duplicateStateCode = dfa_stateCode2duplicateStateCode (newStateCode);
+ if (duplicateStateCode != UNKNOWN_STATE_CODE) {
+   cnt_gotoDuplicateStates++;
    dfa_removeState (newStateCode);
    newStateCode = duplicateStateCode;
  }
@@ -3437,9 +4518,11 @@ static void dfa_closure (t_stateCode stateCode)
  t_symbolType
    symbolType;
 
+ cnt_closureCalls++;
  prevTotItems = -1;
  currTotItems = (int) dfa_stateCode2totItems (stateCode);
  while (prevTotItems != currTotItems) {
+   cnt_closureSweeps++;
    for (iItem = 1; (int) iItem <= currTotItems; iItem++) {
 
      /* Ignore reduction items */
@@ -3459,7 +4542,8 @@ static void dfa_closure (t_stateCode stateCode)
 
      for (iUse = 1; iUse <= symbolCode2totUses (symbolCode, t_lefthand); iUse++) {
        newItemCode = newItem (symbolCode2use (symbolCode, t_lefthand, iUse), 0);
-       (void) dfa_addItemToState (newItemCode, stateCode);
+       if (dfa_addItemToState (newItemCode, stateCode))
+         cnt_closureItemsAdded++;
      }
    }
    prevTotItems = currTotItems;
@@ -3478,7 +4562,6 @@ void build_LR0_items_NFA_and_DFA (void)
  unsigned int
    iItem,
    iState,
-   jState,
    iSymbol,
    iUse,
    totStateItems,
@@ -3576,7 +4659,9 @@ void build_LR0_items_NFA_and_DFA (void)
 
  for (iItem = 0; iItem < nextLR0item; iItem++) {
    itemCode = (t_itemCode) (iItem + ITEM_START_CODE);
-   (void) nfa_addItemToState (itemCode, nfa_newEmptyState());
+   stateCode = nfa_newEmptyState();
+   (void) nfa_addItemToState (itemCode, stateCode);
+   itemIndex2nfaStateCode[iItem] = stateCode;
  }
 
  /* Setp 2: for each state, work out the corresponding transitions */
@@ -3596,18 +4681,10 @@ void build_LR0_items_NFA_and_DFA (void)
    ruleNumber  = itemCode2ruleNumber (fromItem);
    dotPosition = itemCode2dotPosition (fromItem);
    transitionSymbol = itemCode2transitionSymbol (fromItem);
-   for (jState = 1; jState <= totNFAstates; jState++) {
-     toState = nfa_stateNumber2stateCode (jState);
-     toItem = nfa_stateCode2itemCode (toState);
-     if ( (itemCode2ruleNumber  (toItem) == ruleNumber) &&
-          (itemCode2dotPosition (toItem) == dotPosition + 1) ) {
-
-       /* Found the state we were looking for, so add */
-       /* the transition and break out of the loop    */
-
-       nfa_newTransition (fromState, transitionSymbol, toState);
-       break;
-     }
+   toItem = ruleDot2itemCode[ruleNumber-1][dotPosition+1];
+   if (toItem != UNKNOWN_ITEM_CODE) {
+     toState = itemIndex2nfaStateCode[toItem - ITEM_START_CODE];
+     nfa_newTransition (fromState, transitionSymbol, toState);
    }
 
    /* If the transition symbol is a non terminal, we must    */
@@ -3617,22 +4694,18 @@ void build_LR0_items_NFA_and_DFA (void)
      continue;
    for (iUse = 1; iUse <= symbolCode2totUses (transitionSymbol, t_lefthand); iUse++) {
      ruleNumber = symbolCode2use (transitionSymbol, t_lefthand, iUse);
-     for (jState = 1; jState <= totNFAstates; jState++) {
-       toState = nfa_stateNumber2stateCode (jState);
-       toItem  = nfa_stateCode2itemCode (toState);
-       if ( (itemCode2ruleNumber (toItem) == ruleNumber) &&
-            (itemCode2dotPosition (toItem) == 0) ) {
-
-         /* Found the state we were looking for, so add the */
-         /* epsilon transition and break out of the loop    */
-
-         nfa_newTransition (fromState, EPSILON_CODE, toState);
-         break;
-       }
+     toItem = ruleDot2itemCode[ruleNumber-1][0];
+     if (toItem != UNKNOWN_ITEM_CODE) {
+       toState = itemIndex2nfaStateCode[toItem - ITEM_START_CODE];
+       nfa_newTransition (fromState, EPSILON_CODE, toState);
      }
    }
  }
 
+ /* Work out the ordered list of transitions from each NFA state */
+
+ nfa_orderTransitions();
+
  /* Work out the number of NFA and DFA items */
 
  totNFAitems = totLR0items;
@@ -3697,8 +4770,208 @@ void build_LR0_items_NFA_and_DFA (void)
      stateType = t_DFA_shift_N_reduce_state;
      tot_DFA_shift_N_reduce_states++;
    }
-   DFAstates[stateCode - DFA_STATE_START_CODE].stateType = stateType;
+   DFAstateType[stateCode - DFA_STATE_START_CODE] = stateType;
+ }
+}
+
+/*
+*---------------------------------------------------------------------
+* Reorder the elements of an array so that element i of the result is
+* element oldIndexAt[i] of the original
+*---------------------------------------------------------------------
+*/
+
+static void permute_array (void *array, size_t elementSize, unsigned int totElements, const unsigned int *oldIndexAt)
+{
+ unsigned int
+   iElement;
+ char
+   *original;
+
+ if ((original = (char *) malloc (totElements * elementSize + 1)) == NULL)
+   ERROR_no_memory (0, __FILE__, __func__, "original");
+ memcpy (original, array, totElements * elementSize);
+ for (iElement = 0; iElement < totElements; iElement++)
+   memcpy ((char *) array + iElement * elementSize, original + oldIndexAt[iElement] * elementSize, elementSize);
+ free (original);
+}
+
+/*
+*---------------------------------------------------------------------
+* Renumber the DFA states in depth-first order from the start state,
+* following shifts on terminals before gotos on non-terminals, so that
+* the states a parser goes through while shifting the symbols of a
+* rule get neighbouring numbers and neighbouring rows in the parse
+* tables. build_LR0_items_NFA_and_DFA() numbers them breadth-first,
+* which scatters those chains across the whole table.
+*
+* The start state keeps number 1. The item and symbol pools are laid
+* out again in the new order, and the transitions are rewritten and
+* grouped by their new state of origin, so everything built from the
+* DFA afterwards (reports, diagrams and parse tables) agrees with it.
+* It must be called before any of those is built.
+*---------------------------------------------------------------------
+*/
+
+void dfa_renumberStates (void)
+{
+ unsigned int
+   iState,
+   iTransition,
+   iOutward,
+   iPass,
+   oldIndex,
+   stackTop,
+   totNumbered,
+   *newIndexOf,
+   *oldIndexAt,
+   *firstOutward,
+   *outwardTransitions,
+   *stack;
+ int
+   *newItems,
+   *newSortedItems;
+ t_symbolCode
+   *newTransitionSymbols;
+ t_stateTransition
+   *p_DFAtransition,
+   *oldTransitions;
+ bool
+   b_terminal;
+
+ if (totDFAstates == 0)
+   return;
+ newIndexOf         = (unsigned int *) malloc (totDFAstates * sizeof (unsigned int));
+ oldIndexAt         = (unsigned int *) malloc (totDFAstates * sizeof (unsigned int));
+ firstOutward       = (unsigned int *) calloc (totDFAstates + 1, sizeof (unsigned int));
+ outwardTransitions = (unsigned int *) malloc ((totDFAtransitions + 1) * sizeof (unsigned int));
+ stack              = (unsigned int *) malloc ((totDFAtransitions + 1) * sizeof (unsigned int));
+ if ((newIndexOf == NULL) || (oldIndexAt == NULL) || (firstOutward == NULL) || (outwardTransitions == NULL) || (stack == NULL))
+   ERROR_no_memory (0, __FILE__, __func__, "newIndexOf");
+
+ /* Transitions out of each state, in the order they were made */
+
+ for (iTransition = 0; iTransition < totDFAtransitions; iTransition++)
+   firstOutward[DFAtransitions[iTransition].fromState - DFA_STATE_START_CODE + 1]++;
+ for (iState = 0; iState < totDFAstates; iState++)
+   firstOutward[iState + 1] += firstOutward[iState];
+ for (iTransition = 0; iTransition < totDFAtransitions; iTransition++)
+   outwardTransitions[firstOutward[DFAtransitions[iTransition].fromState - DFA_STATE_START_CODE]++] = iTransition;
+ for (iState = totDFAstates; iState > 0; iState--)
+   firstOutward[iState] = firstOutward[iState - 1];
+ firstOutward[0] = 0;
+
+ /* Depth-first walk: a state is numbered when it leaves the stack. Gotos are */
+ /* pushed before shifts, each group backwards, so shifts are followed first  */
+ /* and in the order of their symbols.                                        */
+
+ for (iState = 0; iState < totDFAstates; iState++)
+   newIndexOf[iState] = totDFAstates;
+ totNumbered = 0;
+ stackTop = 0;
+ stack[stackTop++] = 0;
+ while (stackTop > 0) {
+   oldIndex = stack[--stackTop];
+   if (newIndexOf[oldIndex] != totDFAstates)
+     continue;
+   newIndexOf[oldIndex] = totNumbered;
+   oldIndexAt[totNumbered++] = oldIndex;
+   for (iPass = 1; iPass <= 2; iPass++)
+     for (iTransition = firstOutward[oldIndex + 1]; iTransition > firstOutward[oldIndex]; iTransition--) {
+       p_DFAtransition = &DFAtransitions[outwardTransitions[iTransition - 1]];
+       b_terminal = (p_DFAtransition->withSymbol < NON_TERMINAL_START_CODE);
+       if ((b_terminal == (iPass == 2)) && (newIndexOf[p_DFAtransition->toState - DFA_STATE_START_CODE] == totDFAstates))
+         stack[stackTop++] = (unsigned int) (p_DFAtransition->toState - DFA_STATE_START_CODE);
+     }
+ }
+
+ /* States the start state cannot reach, if any, keep their relative order at the end */
+
+ for (iState = 0; iState < totDFAstates; iState++)
+   if (newIndexOf[iState] == totDFAstates) {
+     newIndexOf[iState] = totNumbered;
+     oldIndexAt[totNumbered++] = iState;
+   }
+
+ /* Move the data of every state to its new position */
+
+ permute_array (DFAstateType,        sizeof (DFAstateType[0]),        totDFAstates, oldIndexAt);
+ permute_array (DFAstateTotItems,    sizeof (DFAstateTotItems[0]),    totDFAstates, oldIndexAt);
+ permute_array (DFAstateFirstItem,   sizeof (DFAstateFirstItem[0]),   totDFAstates, oldIndexAt);
+ permute_array (DFAstateTotInward,   sizeof (DFAstateTotInward[0]),   totDFAstates, oldIndexAt);
+ permute_array (DFAstateTotSymbols,  sizeof (DFAstateTotSymbols[0]),  totDFAstates, oldIndexAt);
+ permute_array (DFAstateFirstSymbol, sizeof (DFAstateFirstSymbol[0]), totDFAstates, oldIndexAt);
+ permute_array (DFAstateFingerprint, sizeof (DFAstateFingerprint[0]), totDFAstates, oldIndexAt);
+
+ /* Lay the pools out again in the new order, so the runs of the last state still end them */
+
+ newItems             = (int *) malloc (maxDFAitems * sizeof (int));
+ newSortedItems       = (int *) malloc (maxDFAitems * sizeof (int));
+ newTransitionSymbols = (t_symbolCode *) malloc (maxDFAsymbols * sizeof (t_symbolCode) + 1);
+ if ((newItems == NULL) || (newSortedItems == NULL) || (newTransitionSymbols == NULL))
+   ERROR_no_memory (0, __FILE__, __func__, "newItems");
+ nextDFAitem = nextDFAsymbol = 0;
+ for (iState = 0; iState < totDFAstates; iState++) {
+   memcpy (&newItems[nextDFAitem],       &DFAitems[DFAstateFirstItem[iState]],       DFAstateTotItems[iState] * sizeof (int));
+   memcpy (&newSortedItems[nextDFAitem], &DFAsortedItems[DFAstateFirstItem[iState]], DFAstateTotItems[iState] * sizeof (int));
+   DFAstateFirstItem[iState] = nextDFAitem;
+   nextDFAitem += DFAstateTotItems[iState];
+   memcpy (&newTransitionSymbols[nextDFAsymbol], &DFAtransitionSymbols[DFAstateFirstSymbol[iState]], DFAstateTotSymbols[iState] * sizeof (t_symbolCode));
+   DFAstateFirstSymbol[iState] = nextDFAsymbol;
+   nextDFAsymbol += DFAstateTotSymbols[iState];
+ }
+ free (DFAitems);
+ free (DFAsortedItems);
+ free (DFAtransitionSymbols);
+ DFAitems             = newItems;
+ DFAsortedItems       = newSortedItems;
+ DFAtransitionSymbols = newTransitionSymbols;
+
+ /* Rewrite the transitions, grouped by new state of origin in the order they were made */
+
+ if ((oldTransitions = (t_stateTransition *) malloc ((totDFAtransitions + 1) * sizeof (t_stateTransition))) == NULL)
+   ERROR_no_memory (0, __FILE__, __func__, "oldTransitions");
+ memcpy (oldTransitions, DFAtransitions, totDFAtransitions * sizeof (t_stateTransition));
+ for (iState = 0, iTransition = 0; iState < totDFAstates; iState++) {
+   oldIndex = oldIndexAt[iState];
+   for (iOutward = firstOutward[oldIndex]; iOutward < firstOutward[oldIndex + 1]; iOutward++) {
+     p_DFAtransition = &DFAtransitions[iTransition++];
+     *p_DFAtransition = oldTransitions[outwardTransitions[iOutward]];
+     p_DFAtransition->fromState = (t_stateCode) (DFA_STATE_START_CODE + iState);
+     p_DFAtransition->toState   = (t_stateCode) (DFA_STATE_START_CODE + newIndexOf[p_DFAtransition->toState - DFA_STATE_START_CODE]);
+   }
  }
+ b_DFAtransitionViewsBuilt = false;
+ b_DFAnextStateIndexBuilt = false;
+
+ free (oldTransitions);
+ free (newIndexOf);
+ free (oldIndexAt);
+ free (firstOutward);
+ free (outwardTransitions);
+ free (stack);
+}
+
+/*
+*---------------------------------------------------------------------
+* Return the mean distance, in states, between the two ends of a DFA
+* transition: how far apart in a parse table are the rows a parser
+* reads one after the other when it takes a transition
+*---------------------------------------------------------------------
+*/
+
+double dfa_meanTransitionSpan (void)
+{
+ unsigned int
+   iTransition;
+ double
+   totSpan = 0.0;
+
+ if (totDFAtransitions == 0)
+   return (0.0);
+ for (iTransition = 0; iTransition < totDFAtransitions; iTransition++)
+   totSpan += abs (DFAtransitions[iTransition].toState - DFAtransitions[iTransition].fromState);
+ return (totSpan / totDFAtransitions);
 }
 
 /*
@@ -4078,6 +5351,7 @@ void build_first_sets (void)
  b_stillAdding = true;
  while (b_stillAdding) {
    b_stillAdding = false;
+   cnt_firstSetIterations++;
 
    /* For each production choice X -> Y1 Y2 ... Yn do */
 
@@ -4171,6 +5445,7 @@ void build_follow_sets (void)
  b_stillAdding = true;
  while (b_stillAdding) {
    b_stillAdding = false;
+   cnt_followSetIterations++;
 
    /* For each production X -> Y1 Y2 ... Yn do */
 
@@ -4290,12 +5565,15 @@ unsigned int parseTablePos2totParseActions (
   t_stateCode        stateCode,
   t_symbolCode       symbolCode )
 {
+  unsigned int
+    posFirstAction;
+
   if (parse_table_type == t_LR0_parse_table)
     return (LR0parseTable [stateCode2parseTableRow(stateCode)][symbolCode2parseTableCol(symbolCode)].totParseActions);
   if (parse_table_type == t_sLR1_parse_table)
     return (sLR1parseTable[stateCode2parseTableRow(stateCode)][symbolCode2parseTableCol(symbolCode)].totParseActions);
   if (parse_table_type == t_diff_parse_table)
-    return (diffParseTable[stateCode2parseTableRow(stateCode)][symbolCode2parseTableCol(symbolCode)].totParseActions);
+    return (diffParseTablePos (stateCode2parseTableRow(stateCode), symbolCode2parseTableCol(symbolCode), &posFirstAction));
   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize,
            "Unknown parse table type %d (state=%d, symbol=%d)\n",
            parse_table_type, stateCode, symbolCode);
@@ -4316,11 +5594,10 @@ t_parseAction parseTablePos2parseAction (
   unsigned int       actionNumber )
 {
   unsigned int
-    totalActions;
+    totalActions,
+    posFirstAction;
   struct t_parseTableEntry
-    parseTableEntry;
-  struct t_parseActionList
-    *p_parseAction;
+    *p_parseTableEntry;
 
   if ((parse_table_type != t_LR0_parse_table) && (parse_table_type != t_sLR1_parse_table) && (parse_table_type != t_diff_parse_table)) {
     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize,
@@ -4334,24 +5611,188 @@ t_parseAction parseTablePos2parseAction (
              actionNumber, parse_table_type, stateCode, symbolCode);
     ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
   }
-  if (parse_table_type == t_LR0_parse_table)
-    parseTableEntry = LR0parseTable [stateCode2parseTableRow(stateCode)][symbolCode2parseTableCol(symbolCode)];
-  else if (parse_table_type == t_sLR1_parse_table)
-    parseTableEntry = sLR1parseTable[stateCode2parseTableRow(stateCode)][symbolCode2parseTableCol(symbolCode)];
-  else
-    parseTableEntry = diffParseTable[stateCode2parseTableRow(stateCode)][symbolCode2parseTableCol(symbolCode)];
-
-  totalActions = parseTableEntry.totParseActions;
+  if (parse_table_type == t_diff_parse_table)
+    totalActions = diffParseTablePos (stateCode2parseTableRow(stateCode), symbolCode2parseTableCol(symbolCode), &posFirstAction);
+  else {
+    p_parseTableEntry = &parseTableType2parseTable (parse_table_type) [stateCode2parseTableRow(stateCode)][symbolCode2parseTableCol(symbolCode)];
+    totalActions = p_parseTableEntry->totParseActions;
+    posFirstAction = p_parseTableEntry->posFirstAction;
+  }
   if (actionNumber > totalActions) {
     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize,
              "Invalid parse action number %u, total actions = %u (parse_table_type=%d, state=%d, symbol=%d)\n",
              actionNumber, totalActions, parse_table_type, stateCode, symbolCode);
     ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
   }
-  p_parseAction = parseTableEntry.p_parseActionList;
-  while (--actionNumber > 0)
-    p_parseAction = p_parseAction->p_nextParseAction;
-  return (p_parseAction->parseAction);
+  if (parse_table_type == t_diff_parse_table)
+    return (diffParseActions[posFirstAction + actionNumber - 1].parseAction);
+  return (parseTableType2parseActions (parse_table_type)->parseActions[posFirstAction + actionNumber - 1]);
+}
+
+/*
+*---------------------------------------------------------------------
+* Take a parse table type and return the table, or its parse actions
+*---------------------------------------------------------------------
+*/
+
+static t_parseTableRow *parseTableType2parseTable (t_parse_table_type parse_table_type)
+{
+ switch (parse_table_type) {
+   case (t_LR0_parse_table):  return (LR0parseTable);
+   case (t_sLR1_parse_table): return (sLR1parseTable);
+   default:
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Unknown parse table type %d\n", parse_table_type);
+     ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+ }
+ return (NULL);
+}
+
+static t_parseActionArena *parseTableType2parseActions (t_parse_table_type parse_table_type)
+{
+ switch (parse_table_type) {
+   case (t_LR0_parse_table):  return (&LR0parseActions);
+   case (t_sLR1_parse_table): return (&sLR1parseActions);
+   default:
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Unknown parse table type %d\n", parse_table_type);
+     ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+ }
+ return (NULL);
+}
+
+/*
+*---------------------------------------------------------------------
+* Empty a parse table before building it
+*---------------------------------------------------------------------
+*/
+
+static void init_parse_table (t_parse_table_type parse_table_type)
+{
+ free_parse_table (parse_table_type);
+ memset (parseTableType2parseTable (parse_table_type), 0, totDFAstates * sizeof (t_parseTableRow));
+}
+
+/*
+*---------------------------------------------------------------------
+* Once a parse table is built, lay its parse actions out cell after
+* cell, each cell keeping the order its chain had, and drop the chains
+*---------------------------------------------------------------------
+*/
+
+static void pack_parse_table (t_parse_table_type parse_table_type)
+{
+ t_parseTableRow
+   *parseTable;
+ t_parseActionArena
+   *p_parseActions;
+ t_parseAction
+   *packedActions = NULL;
+ unsigned int
+   tableRow,
+   tableCol,
+   iAction,
+   posAction,
+   nextPackedAction = 0;
+
+ parseTable = parseTableType2parseTable (parse_table_type);
+ p_parseActions = parseTableType2parseActions (parse_table_type);
+ if (p_parseActions->totParseActions > 0) {
+   packedActions = (t_parseAction *) malloc (p_parseActions->totParseActions * sizeof (t_parseAction));
+   if (packedActions == NULL)
+     ERROR_no_memory (0, __FILE__, __func__, "packedActions");
+ }
+ for (tableRow = 0; tableRow < totDFAstates; tableRow++)
+   for (tableCol = 0; tableCol <= totTerminals + totNonTerminals; tableCol++) {
+     posAction = parseTable[tableRow][tableCol].posFirstAction;
+     parseTable[tableRow][tableCol].posFirstAction = nextPackedAction;
+     for (iAction = 0; iAction < parseTable[tableRow][tableCol].totParseActions; iAction++) {
+       packedActions[nextPackedAction++] = p_parseActions->parseActions[posAction];
+       posAction = p_parseActions->nextParseAction[posAction];
+     }
+   }
+ free (p_parseActions->parseActions);
+ free (p_parseActions->nextParseAction);
+ p_parseActions->parseActions    = packedActions;
+ p_parseActions->nextParseAction = NULL;
+ p_parseActions->maxParseActions = p_parseActions->totParseActions;
+}
+
+/*
+*---------------------------------------------------------------------
+* Free the parse actions of a parse table
+*---------------------------------------------------------------------
+*/
+
+static void free_parse_table (t_parse_table_type parse_table_type)
+{
+ t_parseActionArena
+   *p_parseActions;
+
+ p_parseActions = parseTableType2parseActions (parse_table_type);
+ free (p_parseActions->parseActions);
+ free (p_parseActions->nextParseAction);
+ memset (p_parseActions, 0, sizeof (t_parseActionArena));
+}
+
+/*
+*---------------------------------------------------------------------
+* Take a row and a column of the differences table, return how many
+* parse actions the cell has and where in diffParseActions the first
+* one is. Only the cells of the row are looked at.
+*---------------------------------------------------------------------
+*/
+
+static unsigned int diffParseTablePos (unsigned int tableRow, unsigned int tableCol, unsigned int *p_posFirstAction)
+{
+ unsigned int
+   posAction,
+   totParseActions = 0;
+
+ *p_posFirstAction = 0;
+ if (tableRow >= totDFAstates)
+   return (0);
+ for (posAction = diffParseRowStart[tableRow]; posAction < diffParseRowStart[tableRow + 1]; posAction++)
+   if (diffParseActions[posAction].tableCol == tableCol) {
+     if (totParseActions++ == 0)
+       *p_posFirstAction = posAction;
+   }
+   else if (totParseActions > 0)
+     break;
+ return (totParseActions);
+}
+
+/*
+*---------------------------------------------------------------------
+* Append a parse action to the row of the differences table being
+* built and count it in the summary statistics
+*---------------------------------------------------------------------
+*/
+
+static void add_diff_parse_action (unsigned int tableRow, unsigned int tableCol, t_parseAction parseAction)
+{
+ t_diffParseAction
+   *p_newDiffParseActions;
+
+ if (totDiffParseActions == maxDiffParseActions) {
+   maxDiffParseActions = (maxDiffParseActions == 0) ? INITIAL_PARSE_ACTIONS : 2 * maxDiffParseActions;
+   if ((p_newDiffParseActions = (t_diffParseAction *) realloc (diffParseActions, maxDiffParseActions * sizeof (t_diffParseAction))) == NULL)
+     ERROR_no_memory (0, __FILE__, __func__, "diffParseActions");
+   diffParseActions = p_newDiffParseActions;
+ }
+ diffParseActions[totDiffParseActions].tableCol    = tableCol;
+ diffParseActions[totDiffParseActions].parseAction = parseAction;
+ totDiffParseActions++;
+ if (parseAction.parseActionType == t_shift) {
+   diffParseTableSummaryRow[tableCol].totShifts++;
+   diffParseTableSummaryCol[tableRow].totShifts++;
+ }
+ else if (parseAction.parseActionType == t_goto) {
+   diffParseTableSummaryRow[tableCol].totGotos++;
+   diffParseTableSummaryCol[tableRow].totGotos++;
+ }
+ else {
+   diffParseTableSummaryRow[tableCol].totReductions++;
+   diffParseTableSummaryCol[tableRow].totReductions++;
+ }
 }
 
 /*
@@ -4409,15 +5850,20 @@ static void addParseAction (
 {
   unsigned int
     tableRow,
-    tableCol;
+    tableCol,
+    iAction,
+    posAction;
   struct t_parseTableEntry
      *p_parseTablePos = NULL;
   t_parseTableSummary
     *p_parseTableSummaryPosInRow = NULL,
     *p_parseTableSummaryPosInCol = NULL;
-  struct t_parseActionList
-    *p_parseActionNode    = NULL,
-    *p_newParseActionNode = NULL;
+  t_parseActionArena
+    *p_parseActions;
+  t_parseAction
+    *p_newParseActions;
+  unsigned int
+    *p_newNextParseAction;
 
   tableRow = stateCode2parseTableRow (stateCode);
   tableCol = symbolCode2parseTableCol (symbolCode);
@@ -4436,11 +5882,6 @@ static void addParseAction (
     p_parseTableSummaryPosInRow = &sLR1parseTableSummaryRow[tableCol];
     p_parseTableSummaryPosInCol = &sLR1parseTableSummaryCol[tableRow];
   }
-  else if (parse_table_type == t_diff_parse_table) {
-    p_parseTablePos             = &diffParseTable[tableRow][tableCol];
-    p_parseTableSummaryPosInRow = &diffParseTableSummaryRow[tableCol];
-    p_parseTableSummaryPosInCol = &diffParseTableSummaryCol[tableRow];
-  }
   else {
     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Unknown parse table type %d (row=%u, column=%u, actionType=%d)\n",
       parse_table_type, tableRow, tableCol, parseAction.parseActionType);
@@ -4469,21 +5910,28 @@ static void addParseAction (
 
   /* 3rd check: duplicate entries */
 
-  for (p_parseActionNode = p_parseTablePos->p_parseActionList;
-       (p_parseActionNode != NULL) && memcmp(&p_parseActionNode->parseAction, &parseAction, sizeof(parseAction));
-       p_parseActionNode = p_parseActionNode->p_nextParseAction);
-  if (p_parseActionNode != NULL)
-    return;
+  p_parseActions = parseTableType2parseActions (parse_table_type);
+  for (iAction = 0, posAction = p_parseTablePos->posFirstAction;
+       iAction < p_parseTablePos->totParseActions;
+       iAction++, posAction = p_parseActions->nextParseAction[posAction])
+    if (memcmp (&p_parseActions->parseActions[posAction], &parseAction, sizeof (parseAction)) == 0)
+      return;
 
   /* All checks OK, so add the parse action to the parse table */
 
-  p_newParseActionNode = (struct t_parseActionList *) malloc (sizeof (struct t_parseActionList));
-  if (p_newParseActionNode == NULL)
-    ERROR_no_memory (0, __FILE__, __func__, "parseActionNode");
-  p_newParseActionNode->p_nextParseAction = NULL;
-  p_newParseActionNode->parseAction = parseAction;
-  p_newParseActionNode->p_nextParseAction = p_parseTablePos->p_parseActionList;
-  p_parseTablePos->p_parseActionList = p_newParseActionNode;
+  if (p_parseActions->totParseActions == p_parseActions->maxParseActions) {
+    p_parseActions->maxParseActions = (p_parseActions->maxParseActions == 0) ? INITIAL_PARSE_ACTIONS : 2 * p_parseActions->maxParseActions;
+    if ((p_newParseActions = (t_parseAction *) realloc (p_parseActions->parseActions, p_parseActions->maxParseActions * sizeof (t_parseAction))) == NULL)
+      ERROR_no_memory (0, __FILE__, __func__, "parseActions");
+    p_parseActions->parseActions = p_newParseActions;
+    if ((p_newNextParseAction = (unsigned int *) realloc (p_parseActions->nextParseAction, p_parseActions->maxParseActions * sizeof (unsigned int))) == NULL)
+      ERROR_no_memory (0, __FILE__, __func__, "nextParseAction");
+    p_parseActions->nextParseAction = p_newNextParseAction;
+  }
+  posAction = p_parseActions->totParseActions++;
+  p_parseActions->parseActions[posAction]    = parseAction;
+  p_parseActions->nextParseAction[posAction] = p_parseTablePos->posFirstAction;
+  p_parseTablePos->posFirstAction = posAction;
   (p_parseTablePos->totParseActions)++;
 
   /* Update array of summary statistics */
@@ -4550,9 +5998,7 @@ void build_LR0_parse_table (void)
  unsigned int
    iState,
    iItem,
-   iSymbol,
-   tableRow,
-   tableColumn;
+   iSymbol;
  t_symbolCode
    symbolCode,
    transitionSymbol;
@@ -4570,22 +6016,7 @@ void build_LR0_parse_table (void)
 
  /* Initialize the parse table */
 
- for (iState = 1; iState <= totDFAstates; iState++) {
-   stateCode = dfa_stateNumber2stateCode (iState);
-   tableRow = stateCode2parseTableRow (stateCode);
-   for (iSymbol = 1; iSymbol <= totTerminals; iSymbol++) {
-     symbolCode = symbolNumber2symbolCode (iSymbol, t_terminal);
-     tableColumn = symbolCode2parseTableCol (symbolCode);
-     LR0parseTable[tableRow][tableColumn].totParseActions = 0;
-     LR0parseTable[tableRow][tableColumn].p_parseActionList = NULL;
-   }
-   for (iSymbol = 1; iSymbol <= totNonTerminals; iSymbol++) {
-     symbolCode = symbolNumber2symbolCode (iSymbol, t_nonTerminal);
-     tableColumn = symbolCode2parseTableCol (symbolCode);
-     LR0parseTable[tableRow][tableColumn].totParseActions = 0;
-     LR0parseTable[tableRow][tableColumn].p_parseActionList = NULL;
-   }
- }
+ init_parse_table (t_LR0_parse_table);
 
  /* Populate parse table */
 
@@ -4625,6 +6056,7 @@ void build_LR0_parse_table (void)
      }
    }
  }
+ pack_parse_table (t_LR0_parse_table);
 }
 
 /*
@@ -4638,10 +6070,7 @@ void build_sLR1_parse_table (void)
  unsigned int
    iState,
    iItem,
-   iSymbol,
-   iFollowSymbol,
-   tableRow,
-   tableColumn;
+   iFollowSymbol;
  t_symbolCode
    symbolCode,
    lefthandSymbol,
@@ -4660,22 +6089,7 @@ void build_sLR1_parse_table (void)
 
  /* Initialize the parse table */
 
- for (iState = 1; iState <= totDFAstates; iState++) {
-   stateCode = dfa_stateNumber2stateCode (iState);
-   tableRow = stateCode2parseTableRow (stateCode);
-   for (iSymbol = 1; iSymbol <= totTerminals; iSymbol++) {
-     symbolCode = symbolNumber2symbolCode (iSymbol, t_terminal);
-     tableColumn = symbolCode2parseTableCol (symbolCode);
-     sLR1parseTable[tableRow][tableColumn].totParseActions = 0;
-     sLR1parseTable[tableRow][tableColumn].p_parseActionList = NULL;
-   }
-   for (iSymbol = 1; iSymbol <= totNonTerminals; iSymbol++) {
-     symbolCode = symbolNumber2symbolCode (iSymbol, t_nonTerminal);
-     tableColumn = symbolCode2parseTableCol (symbolCode);
-     sLR1parseTable[tableRow][tableColumn].totParseActions = 0;
-     sLR1parseTable[tableRow][tableColumn].p_parseActionList = NULL;
-   }
- }
+ init_parse_table (t_sLR1_parse_table);
 
  /* Populate parse table */
 
@@ -4720,11 +6134,15 @@ void build_sLR1_parse_table (void)
      }
    }
  }
+ pack_parse_table (t_sLR1_parse_table);
 }
 
 /*
 *---------------------------------------------------------------------
-* Build table with differences between LR(0) and sLR(1) parse tables
+* Build table with differences between LR(0) and sLR(1) parse tables.
+* The sLR(1) table never has an action the LR(0) table lacks, so only
+* the cells where the two differ in size have anything to show. Only
+* those cells are stored, and no third full table is ever allocated.
 *---------------------------------------------------------------------
 */
 
@@ -4735,7 +6153,7 @@ void build_diff_parse_table (void)
    iSymbol,
    iParseAction,
    tableRow,
-   tableColumn,
+   tableCol,
    totLR0parseActions,
    totsLR1parseActions;
  t_symbolCode
@@ -4747,40 +6165,32 @@ void build_diff_parse_table (void)
 
  /* Initialize the parse table */
 
- for (iState = 1; iState <= totDFAstates; iState++) {
-   stateCode = dfa_stateNumber2stateCode (iState);
-   tableRow = stateCode2parseTableRow (stateCode);
-   for (iSymbol = 1; iSymbol <= totTerminals; iSymbol++) {
-     symbolCode = symbolNumber2symbolCode (iSymbol, t_terminal);
-     tableColumn = symbolCode2parseTableCol (symbolCode);
-     diffParseTable[tableRow][tableColumn].totParseActions = 0;
-     diffParseTable[tableRow][tableColumn].p_parseActionList = NULL;
-   }
-   for (iSymbol = 1; iSymbol <= totNonTerminals; iSymbol++) {
-     symbolCode = symbolNumber2symbolCode (iSymbol, t_nonTerminal);
-     tableColumn = symbolCode2parseTableCol (symbolCode);
-     diffParseTable[tableRow][tableColumn].totParseActions = 0;
-     diffParseTable[tableRow][tableColumn].p_parseActionList = NULL;
-   }
- }
+ free_diff_parse_table_memory();
+ memset (diffParseTableSummaryCol, 0, sizeof (diffParseTableSummaryCol));
+ memset (diffParseTableSummaryRow, 0, sizeof (diffParseTableSummaryRow));
 
- /* Populate parse table */
+ /* Populate parse table, listing the actions of each cell in the */
+ /* reverse order of the LR(0) cell, as the full table used to do */
 
  for (iState = 1; iState <= totDFAstates; iState++) {
    stateCode = dfa_stateNumber2stateCode (iState);
+   tableRow = stateCode2parseTableRow (stateCode);
+   diffParseRowStart[tableRow] = totDiffParseActions;
    for (iSymbol = 1; iSymbol <= totTerminals; iSymbol++) {
      symbolCode = symbolNumber2symbolCode (iSymbol, t_terminal);
      totLR0parseActions = parseTablePos2totParseActions (t_LR0_parse_table, stateCode, symbolCode);
      totsLR1parseActions = parseTablePos2totParseActions (t_sLR1_parse_table, stateCode, symbolCode);
      if (totLR0parseActions == totsLR1parseActions)
        continue;
-     for (iParseAction = 1; iParseAction <= totLR0parseActions; iParseAction++) {
+     tableCol = symbolCode2parseTableCol (symbolCode);
+     for (iParseAction = totLR0parseActions; iParseAction >= 1; iParseAction--) {
        LR0parseAction = parseTablePos2parseAction (t_LR0_parse_table, stateCode, symbolCode, iParseAction);
        if (! b_parseAction_isIn_parseTablePos (LR0parseAction, t_sLR1_parse_table, stateCode, symbolCode))
-         addParseAction (t_diff_parse_table, stateCode, symbolCode, LR0parseAction);
+         add_diff_parse_action (tableRow, tableCol, LR0parseAction);
      }
    }
  }
+ diffParseRowStart[totDFAstates] = totDiffParseActions;
 }
 
 /*
@@ -4791,47 +6201,7 @@ void build_diff_parse_table (void)
 
 void free_LR0_parse_table_memory (void)
 {
- unsigned int
-   iState,
-   iSymbol,
-   tableRow,
-   tableColumn;
- t_stateCode
-   stateCode;
- t_symbolCode
-   symbolCode;
- struct t_parseTableEntry
-   *p_parseTableEntry = NULL;
- struct t_parseActionList
-   *p_parseActionCurrNode = NULL,
-   *p_parseActionNextNode = NULL;
-
- for (iState = 1; iState <= totDFAstates; iState++) {
-   stateCode = dfa_stateNumber2stateCode (iState);
-   tableRow = stateCode2parseTableRow (stateCode);
-   for (iSymbol = 1; iSymbol <= totTerminals; iSymbol++) {
-     symbolCode = symbolNumber2symbolCode (iSymbol, t_terminal);
-     tableColumn = symbolCode2parseTableCol (symbolCode);
-     p_parseTableEntry = &(LR0parseTable[tableRow][tableColumn]);
-     for (p_parseActionCurrNode = p_parseTableEntry->p_parseActionList;
-          p_parseActionCurrNode != NULL;
-          p_parseActionCurrNode = p_parseActionNextNode) {
-       p_parseActionNextNode = p_parseActionCurrNode->p_nextParseAction;
-       free (p_parseActionCurrNode);
-     }
-   }
-   for (iSymbol = 1; iSymbol <= totNonTerminals; iSymbol++) {
-     symbolCode = symbolNumber2symbolCode (iSymbol, t_nonTerminal);
-     tableColumn = symbolCode2parseTableCol (symbolCode);
-     p_parseTableEntry = &(LR0parseTable[tableRow][tableColumn]);
-     for (p_parseActionCurrNode = p_parseTableEntry->p_parseActionList;
-          p_parseActionCurrNode != NULL;
-          p_parseActionCurrNode = p_parseActionNextNode) {
-       p_parseActionNextNode = p_parseActionCurrNode->p_nextParseAction;
-       free (p_parseActionCurrNode);
-     }
-   }
- }
+ free_parse_table (t_LR0_parse_table);
 }
 
 /*
@@ -4842,47 +6212,7 @@ void free_LR0_parse_table_memory (void)
 
 void free_sLR1_parse_table_memory (void)
 {
- unsigned int
-   iState,
-   iSymbol,
-   tableRow,
-   tableColumn;
- t_stateCode
-   stateCode;
- t_symbolCode
-   symbolCode;
- struct t_parseTableEntry
-   *p_parseTableEntry = NULL;
- struct t_parseActionList
-   *p_parseActionCurrNode = NULL,
-   *p_parseActionNextNode = NULL;
-
- for (iState = 1; iState <= totDFAstates; iState++) {
-   stateCode = dfa_stateNumber2stateCode (iState);
-   tableRow = stateCode2parseTableRow (stateCode);
-   for (iSymbol = 1; iSymbol <= totTerminals; iSymbol++) {
-     symbolCode = symbolNumber2symbolCode (iSymbol, t_terminal);
-     tableColumn = symbolCode2parseTableCol (symbolCode);
-     p_parseTableEntry = &(sLR1parseTable[tableRow][tableColumn]);
-     for (p_parseActionCurrNode = p_parseTableEntry->p_parseActionList;
-          p_parseActionCurrNode != NULL;
-          p_parseActionCurrNode = p_parseActionNextNode) {
-       p_parseActionNextNode = p_parseActionCurrNode->p_nextParseAction;
-       free (p_parseActionCurrNode);
-     }
-   }
-   for (iSymbol = 1; iSymbol <= totNonTerminals; iSymbol++) {
-     symbolCode = symbolNumber2symbolCode (iSymbol, t_nonTerminal);
-     tableColumn = symbolCode2parseTableCol (symbolCode);
-     p_parseTableEntry = &(sLR1parseTable[tableRow][tableColumn]);
-     for (p_parseActionCurrNode = p_parseTableEntry->p_parseActionList;
-          p_parseActionCurrNode != NULL;
-          p_parseActionCurrNode = p_parseActionNextNode) {
-       p_parseActionNextNode = p_parseActionCurrNode->p_nextParseAction;
-       free (p_parseActionCurrNode);
-     }
-   }
- }
+ free_parse_table (t_sLR1_parse_table);
 }
 
 /*
@@ -4893,47 +6223,10 @@ void free_sLR1_parse_table_memory (void)
 
 void free_diff_parse_table_memory (void)
 {
- unsigned int
-   iState,
-   iSymbol,
-   tableRow,
-   tableColumn;
- t_stateCode
-   stateCode;
- t_symbolCode
-   symbolCode;
- struct t_parseTableEntry
-   *p_parseTableEntry = NULL;
- struct t_parseActionList
-   *p_parseActionCurrNode = NULL,
-   *p_parseActionNextNode = NULL;
-
- for (iState = 1; iState <= totDFAstates; iState++) {
-   stateCode = dfa_stateNumber2stateCode (iState);
-   tableRow = stateCode2parseTableRow (stateCode);
-   for (iSymbol = 1; iSymbol <= totTerminals; iSymbol++) {
-     symbolCode = symbolNumber2symbolCode (iSymbol, t_terminal);
-     tableColumn = symbolCode2parseTableCol (symbolCode);
-     p_parseTableEntry = &(diffParseTable[tableRow][tableColumn]);
-     for (p_parseActionCurrNode = p_parseTableEntry->p_parseActionList;
-          p_parseActionCurrNode != NULL;
-          p_parseActionCurrNode = p_parseActionNextNode) {
-       p_parseActionNextNode = p_parseActionCurrNode->p_nextParseAction;
-       free (p_parseActionCurrNode);
-     }
-   }
-   for (iSymbol = 1; iSymbol <= totNonTerminals; iSymbol++) {
-     symbolCode = symbolNumber2symbolCode (iSymbol, t_nonTerminal);
-     tableColumn = symbolCode2parseTableCol (symbolCode);
-     p_parseTableEntry = &(diffParseTable[tableRow][tableColumn]);
-     for (p_parseActionCurrNode = p_parseTableEntry->p_parseActionList;
-          p_parseActionCurrNode != NULL;
-          p_parseActionCurrNode = p_parseActionNextNode) {
-       p_parseActionNextNode = p_parseActionCurrNode->p_nextParseAction;
-       free (p_parseActionCurrNode);
-     }
-   }
- }
+ free (diffParseActions);
+ diffParseActions = NULL;
+ totDiffParseActions = maxDiffParseActions = 0;
+ memset (diffParseRowStart, 0, sizeof (diffParseRowStart));
 }
 
 /*
@@ -187,7 +187,8 @@ typedef int
 typedef enum {                      /* Three ways of sorting state transitions: */
   t_transitionSortKey_origin,       /*   - by state of origin                   */
   t_transitionSortKey_symbol,	      /*   - by transition symbol                 */
-  t_transitionSortKey_destination   /*   - by destination state                 */
+  t_transitionSortKey_destination,  /*   - by destination state                 */
+  t_transitionSortKey_total         /* (number of sort keys)                    */
 }
  t_transitionSortKey;
 
@@ -201,6 +202,23 @@ extern unsigned int
   totDFAitems,         /* Total number of DFA items, probably greater than the number of LR(0) items     */
   totDFAtransitions;   /* Total number of DFA state transitions                                          */
 
+/* Counters of work done in the hot paths of grammar reading and the LR(0) and FIRST/FOLLOW construction */
+
+extern unsigned long int
+  cnt_grammarTokens,            /* Tokens read from the grammar file                               */
+  cnt_closureCalls,             /* Calls to dfa_closure()                                          */
+  cnt_closureSweeps,            /* Passes made by dfa_closure() over the items of a state          */
+  cnt_closureItemsAdded,        /* Items added to states by dfa_closure()                          */
+  cnt_gotoCalls,                /* Calls to dfa_gotoState()                                        */
+  cnt_gotoEmptyResults,         /* goto() states left with no items                                */
+  cnt_gotoDuplicateStates,      /* goto() states found to be duplicates of existing states         */
+  cnt_itemLookups,              /* Calls to newItem() that found an existing LR(0) item            */
+  cnt_itemCreations,            /* Calls to newItem() that created a new LR(0) item                */
+  cnt_nfaDuplicateTransitions,  /* NFA transitions rejected by nfa_newTransition() as duplicates   */
+  cnt_dfaDuplicateTransitions,  /* DFA transitions rejected by dfa_newTransition() as duplicates   */
+  cnt_firstSetIterations,       /* Iterations of the FIRST sets fixpoint                           */
+  cnt_followSetIterations;      /* Iterations of the FOLLOW sets fixpoint                          */
+
 /*
 *-----------------------------------------------------------------------
 * Definitions for FIRST and FOLLOW sets
@@ -259,7 +277,18 @@ typedef struct {
 *---------------------------------------------------------------------
 */
 
-extern void read_grammar (char *grammarFileName, char *progName, bool b_stripoff_quotes);
+extern void read_grammar         (char *grammarFileName, char *progName, bool b_stripoff_quotes, bool b_regex_scanner);
+extern void write_grammar_binary (const char *binaryFileName, const char *grammarFileName, bool b_stripoff_quotes);
+extern bool load_grammar_binary  (const char *binaryFileName, const char *grammarFileName, bool b_stripoff_quotes);
+
+/* reduce_grammar() drops the rules that can take no part in a derivation */
+/* of a sentence: those using a non-terminal that derives no terminal     */
+/* string, and those of non-terminals the start symbol never reaches. The */
+/* symbols left with no rules go with them, and the rest are numbered     */
+/* again. What was removed is reported to reportFilePt, if not NULL, and  */
+/* the number of rules removed is returned.                               */
+
+extern unsigned int reduce_grammar (FILE *reportFilePt);
 
 /* Methods for grammar symbols and rules */
 
@@ -301,7 +330,7 @@ extern t_ruleNumber  dfa_stateCode2reductionRule (t_stateCode stateCode, unsigne
 extern bool          dfa_isReductionState        (t_stateCode stateCode);
 extern t_stateCode   dfa_lookupNextState         (t_stateCode currStateCode, t_symbolCode transitionSymbol);
 
-extern void          nfa_sortTransitions                     (t_transitionSortKey sortKey);
+extern unsigned int  nfa_sortedTransition2transitionNumber   (t_transitionSortKey sortKey, unsigned int position);
 extern t_stateCode   nfa_transitionNumber2originState        (unsigned int transitionNumber);
 extern t_symbolCode  nfa_transitionNumber2symbol             (unsigned int transitionNumber);
 extern t_stateCode   nfa_transitionNumber2destState          (unsigned int transitionNumber);
@@ -311,7 +340,7 @@ extern unsigned int  nfa_stateCode2totTransitionsToState     (t_stateCode stateC
 extern t_symbolCode  nfa_stateCode2transitionSymbol          (t_stateCode stateCode, unsigned int whichSymbol);
 extern unsigned int  nfa_stateCode2transitionNumber          (t_stateCode stateCode, unsigned int whichTransition);
 
-extern void          dfa_sortTransitions                     (t_transitionSortKey sortKey);
+extern unsigned int  dfa_sortedTransition2transitionNumber   (t_transitionSortKey sortKey, unsigned int position);
 extern t_stateCode   dfa_transitionNumber2originState        (unsigned int transitionNumber);
 extern t_symbolCode  dfa_transitionNumber2symbol             (unsigned int transitionNumber);
 extern t_stateCode   dfa_transitionNumber2destState          (unsigned int transitionNumber);
@@ -321,8 +350,22 @@ extern unsigned int  dfa_stateCode2totTransitionsToState     (t_stateCode stateC
 extern t_symbolCode  dfa_stateCode2transitionSymbol          (t_stateCode stateCode, unsigned int whichSymbol);
 extern unsigned int  dfa_stateCode2transitionNumber          (t_stateCode stateCode, unsigned int whichTransition);
 
+/* dfa_lookupNextState() reads a next state matrix built on first use, */
+/* or a per-state list of transitions when the DFA is too large for a  */
+/* matrix; dfa_isNextStateIndexDense() tells which one is in use.      */
+
+extern bool          dfa_isNextStateIndexDense               (void);
+
 extern void build_LR0_items_NFA_and_DFA (void);
 
+/* dfa_renumberStates() gives the DFA states new numbers, depth-first */
+/* from the start state, and must be called before anything else is   */
+/* built from the DFA. dfa_meanTransitionSpan() measures how far apart */
+/* the two states of a transition are on average.                      */
+
+extern void   dfa_renumberStates     (void);
+extern double dfa_meanTransitionSpan (void);
+
 /* Methods for FIRST and FOLLOW sets */
 
 extern void          build_first_sets  (void);
@@ -0,0 +1,441 @@
+/*
+*-----------------------------------------------------------------------
+*
+*   File         : gramscan.c
+*   Created      : 2026-10-19
+*   Last Modified: 2026-10-19
+*
+*   DESCRIPTION:
+*   Hand-written scanner for grammar files.
+*
+*   read_grammar() used to tokenize grammar files with a LEXAN job
+*   made of nine regular expressions, all of which are tried with
+*   re_match() at every token. The grammar language is small enough
+*   for a direct-coded DFA: the first character of a token picks the
+*   only rule that can match, and the token is then read in one pass.
+*
+*   The whole file is mapped into memory (privately, so it can be
+*   written to without touching the file) and tokens are returned as
+*   pointers into it. The character following a token is saved and
+*   overwritten with '\0' while the token is in use, then restored
+*   at the next call.
+*
+*   The tokens are those of the LEXAN job in read_grammar():
+*
+*     'string' "string"  LEXAN_token_single_str, LEXAN_token_double_str
+*     identifier         LEXAN_token_iden
+*     -> :=              LEXAN_token_resWord
+*     ; |                LEXAN_token_delim
+*     # and //           comments up to the end of the line
+*     C-style comments   comments that may span several lines
+*
+*-----------------------------------------------------------------------
+*/
+
+#define _POSIX_C_SOURCE 200112L
+
+/*
+*-----------------------------------------------------------------------
+*   LIBRARIES AND INCLUDE FILES
+*-----------------------------------------------------------------------
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "common.h"
+#include "error.h"
+#include "lexan.h"
+#include "gramscan.h"
+
+/*
+*---------------------------------------------------------------------
+*
+*   INTERFACE (visible from other modules)
+*
+*---------------------------------------------------------------------
+*/
+
+/*                     */
+/* Function prototypes */
+/*                     */
+
+bool  GRAMSCAN_start_job       (const char *fileName);
+bool  GRAMSCAN_get_token       (LEXAN_t_tokenType *p_token, LEXAN_t_tokenVal *p_tokenVal);
+char *GRAMSCAN_get_error_descr (void);
+void  GRAMSCAN_terminate_job   (void);
+
+/* To prevent "implicit declaration" warnings */
+
+int snprintf (char *str, size_t size, const char *format, ...);
+
+/*
+*---------------------------------------------------------------------
+*
+*   IMPLEMENTATION (not visible from other modules)
+*
+*---------------------------------------------------------------------
+*/
+
+#define MAX_ERROR_LINE_SIZE 200
+
+/* Character classes: the first character of a token decides its type */
+
+typedef enum {
+  c_invalid = 0,
+  c_blank,
+  c_newline,
+  c_letter,         /* letters and '_' : identifiers start and go on with these */
+  c_digit,          /* digits: identifiers go on with these                     */
+  c_quote,          /* ' and "                                                   */
+  c_delim,          /* ; and |                                                   */
+  c_hash,           /* #                                                         */
+  c_slash,          /* /                                                         */
+  c_star,           /* *                                                         */
+  c_minus,          /* -                                                         */
+  c_colon           /* :                                                         */
+}
+  t_charClass;
+
+static unsigned char
+  charClass [256];
+
+static char
+  *fileName   = NULL,
+  *buffer     = NULL,   /* The mapped file                                     */
+  *tailToken  = NULL,   /* Copy of a token that ends at the very end of file   */
+  holdChar    = '\0';   /* Character overwritten by the '\0' ending last token */
+
+static size_t
+  bufferSize = 0,
+  currPos    = 0,       /* Position of the next character to scan       */
+  lineStart  = 0,       /* Position of the first character of this line */
+  holdPos    = 0;
+
+static bool
+  b_holdingChar = false;
+
+static int
+  lineNumber = 1;
+
+static char
+  lastError [ERROR_maxErrorMsgSize];
+
+/*                       */
+/* Function declarations */
+/*                       */
+
+static void set_char_classes (void);
+static bool scan_error       (const char *errorDescr, size_t errorPos);
+static void skip_line        (void);
+static bool skip_comment     (void);
+static void end_token        (size_t tokenStart, size_t tokenEnd, LEXAN_t_tokenVal *p_tokenVal);
+
+/*
+*---------------------------------------------------------------------
+* Fill in the table of character classes
+*---------------------------------------------------------------------
+*/
+
+static void set_char_classes (void)
+{
+ int
+   iChar;
+
+ memset (charClass, c_invalid, sizeof (charClass));
+ for (iChar = 'a'; iChar <= 'z'; iChar++)
+   charClass[iChar] = c_letter;
+ for (iChar = 'A'; iChar <= 'Z'; iChar++)
+   charClass[iChar] = c_letter;
+ for (iChar = '0'; iChar <= '9'; iChar++)
+   charClass[iChar] = c_digit;
+ charClass['_']  = c_letter;
+ charClass[' ']  = charClass['\t'] = charClass['\r'] = charClass['\f'] = charClass['\v'] = c_blank;
+ charClass['\n'] = c_newline;
+ charClass['\''] = charClass['"'] = c_quote;
+ charClass[';']  = charClass['|'] = c_delim;
+ charClass['#']  = c_hash;
+ charClass['/']  = c_slash;
+ charClass['*']  = c_star;
+ charClass['-']  = c_minus;
+ charClass[':']  = c_colon;
+}
+
+/*
+*---------------------------------------------------------------------
+* Describe a lexical error, showing the line where it happened
+*---------------------------------------------------------------------
+*/
+
+static bool scan_error (const char *errorDescr, size_t errorPos)
+{
+ size_t
+   lineEnd;
+ int
+   lineLength,
+   column;
+ char
+   marker [MAX_ERROR_LINE_SIZE + 1];
+
+ /* Same layout as LEXAN errors: the line, then a row of '-' up to the error */
+
+ for (lineEnd = lineStart; lineEnd < bufferSize && buffer[lineEnd] != '\n'; lineEnd++)
+   ;
+ lineLength = (int) SMALLEST (lineEnd - lineStart, (size_t) MAX_ERROR_LINE_SIZE);
+ column = (int) SMALLEST (errorPos - lineStart, (size_t) MAX_ERROR_LINE_SIZE);
+ memset (marker, '-', (size_t) column);
+ marker[column] = '\0';
+ snprintf (lastError, ERROR_maxErrorMsgSize, "GRAMSCAN_get_token(): %s in \"%s\"\n[%4d] %.*s\n       %s^\n",
+           errorDescr, fileName, lineNumber, lineLength, &buffer[lineStart], marker);
+ return (false);
+}
+
+/*
+*---------------------------------------------------------------------
+* Skip the rest of a one-line comment
+*---------------------------------------------------------------------
+*/
+
+static void skip_line (void)
+{
+ while (currPos < bufferSize && buffer[currPos] != '\n')
+   currPos++;
+}
+
+/*
+*---------------------------------------------------------------------
+* Skip a multi-line comment, from just after its opening characters
+*---------------------------------------------------------------------
+*/
+
+static bool skip_comment (void)
+{
+ int
+   openLineNumber = lineNumber;
+
+ while (currPos + 1 < bufferSize) {
+   if (buffer[currPos] == '*' && buffer[currPos + 1] == '/') {
+     currPos += 2;
+     return (true);
+   }
+   if (buffer[currPos] == '\n') {
+     lineNumber++;
+     lineStart = currPos + 1;
+   }
+   currPos++;
+ }
+ snprintf (lastError, ERROR_maxErrorMsgSize, "GRAMSCAN_get_token(): Comment opened in line %d of \"%s\" was not closed\n", openLineNumber, fileName);
+ return (false);
+}
+
+/*
+*---------------------------------------------------------------------
+* Return a token string as a '\0'-terminated view into the buffer
+*---------------------------------------------------------------------
+*/
+
+static void end_token (size_t tokenStart, size_t tokenEnd, LEXAN_t_tokenVal *p_tokenVal)
+{
+ size_t
+   tokenSize = tokenEnd - tokenStart;
+
+ if (tokenEnd < bufferSize) {
+   holdPos = tokenEnd;
+   holdChar = buffer[holdPos];
+   buffer[holdPos] = '\0';
+   b_holdingChar = true;
+   p_tokenVal->tokenStr = &buffer[tokenStart];
+   return;
+ }
+
+ /* No room for the '\0' after the last character of the file */
+
+ free (tailToken);
+ if ((tailToken = (char *) malloc (tokenSize + 1)) == NULL)
+   ERROR_no_memory (0, __FILE__, __func__, "tailToken");
+ memcpy (tailToken, &buffer[tokenStart], tokenSize);
+ tailToken[tokenSize] = '\0';
+ p_tokenVal->tokenStr = tailToken;
+}
+
+/*
+*---------------------------------------------------------------------
+* Map a grammar file into memory and get ready to scan it
+*---------------------------------------------------------------------
+*/
+
+bool GRAMSCAN_start_job (const char *grammarFileName)
+{
+ int
+   fileDescr;
+ struct stat
+   fileStat;
+ void
+   *p_mapped;
+
+ GRAMSCAN_terminate_job();
+ if ((fileDescr = open (grammarFileName, O_RDONLY)) < 0)
+   return (false);
+ if ((fstat (fileDescr, &fileStat) != 0) || (! S_ISREG (fileStat.st_mode)) || (fileStat.st_size == 0)) {
+   (void) close (fileDescr);
+   return (false);
+ }
+ p_mapped = mmap (NULL, (size_t) fileStat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileDescr, 0);
+ (void) close (fileDescr);
+ if (p_mapped == MAP_FAILED)
+   return (false);
+
+ if ((fileName = (char *) malloc (strlen (grammarFileName) + 1)) == NULL)
+   ERROR_no_memory (0, __FILE__, __func__, "fileName");
+ strcpy (fileName, grammarFileName);
+ buffer = (char *) p_mapped;
+ bufferSize = (size_t) fileStat.st_size;
+ currPos = lineStart = 0;
+ lineNumber = 1;
+ b_holdingChar = false;
+ strcpy (lastError, "");
+ set_char_classes();
+ return (true);
+}
+
+/*
+*---------------------------------------------------------------------
+* Get the next token from the grammar file
+*---------------------------------------------------------------------
+*/
+
+bool GRAMSCAN_get_token (LEXAN_t_tokenType *p_token, LEXAN_t_tokenVal *p_tokenVal)
+{
+ size_t
+   tokenStart;
+ char
+   quote;
+
+ memset (p_tokenVal, 0, sizeof (LEXAN_t_tokenVal));
+ *p_token = LEXAN_token_NULL;
+ if (buffer == NULL) {
+   snprintf (lastError, ERROR_maxErrorMsgSize, "%s(): No grammar file being scanned\n", __func__);
+   return (false);
+ }
+
+ /* Give back the character hidden behind the end of the previous token */
+
+ if (b_holdingChar) {
+   buffer[holdPos] = holdChar;
+   b_holdingChar = false;
+ }
+
+ while (currPos < bufferSize) {
+   tokenStart = currPos;
+   switch (charClass[(unsigned char) buffer[currPos++]]) {
+
+     case (c_blank):
+       break;
+
+     case (c_newline):
+       lineNumber++;
+       lineStart = currPos;
+       break;
+
+     case (c_hash):
+       skip_line();
+       break;
+
+     case (c_slash):
+       if (currPos < bufferSize && buffer[currPos] == '/') {
+         skip_line();
+         break;
+       }
+       if (currPos < bufferSize && buffer[currPos] == '*') {
+         currPos++;
+         if (! skip_comment())
+           return (false);
+         break;
+       }
+       return (scan_error ("Invalid token", tokenStart));
+
+     case (c_star):
+       if (currPos < bufferSize && buffer[currPos] == '/') {
+         currPos++;
+         return (scan_error ("No comment to close", tokenStart));
+       }
+       return (scan_error ("Invalid token", tokenStart));
+
+     case (c_letter):
+       while (currPos < bufferSize && (charClass[(unsigned char) buffer[currPos]] == c_letter ||
+                                       charClass[(unsigned char) buffer[currPos]] == c_digit))
+         currPos++;
+       *p_token = LEXAN_token_iden;
+       end_token (tokenStart, currPos, p_tokenVal);
+       return (true);
+
+     case (c_quote):
+
+       /* Strings keep their quotes and, as in LEXAN, end on the same line */
+
+       quote = buffer[tokenStart];
+       while (currPos < bufferSize && buffer[currPos] != quote && buffer[currPos] != '\n')
+         currPos++;
+       if (currPos == bufferSize || buffer[currPos] != quote)
+         return (scan_error ("Invalid token", tokenStart));
+       currPos++;
+       *p_token = (quote == '\'') ? LEXAN_token_single_str : LEXAN_token_double_str;
+       end_token (tokenStart, currPos, p_tokenVal);
+       return (true);
+
+     case (c_minus):
+     case (c_colon):
+       if (currPos < bufferSize && buffer[currPos] == ((buffer[tokenStart] == '-') ? '>' : '=')) {
+         currPos++;
+         *p_token = LEXAN_token_resWord;
+         end_token (tokenStart, currPos, p_tokenVal);
+         return (true);
+       }
+       return (scan_error ("Invalid token", tokenStart));
+
+     case (c_delim):
+       *p_token = LEXAN_token_delim;
+       p_tokenVal->delimChar = buffer[tokenStart];
+       return (true);
+
+     default:
+       return (scan_error ("Invalid token", tokenStart));
+   }
+ }
+ *p_token = LEXAN_token_EOF;
+ return (true);
+}
+
+/*
+*---------------------------------------------------------------------
+* Return a description of the last lexical error
+*---------------------------------------------------------------------
+*/
+
+char *GRAMSCAN_get_error_descr (void)
+{
+ return (lastError);
+}
+
+/*
+*---------------------------------------------------------------------
+* Unmap the grammar file and free all memory used by the scanner
+*---------------------------------------------------------------------
+*/
+
+void GRAMSCAN_terminate_job (void)
+{
+ if (buffer != NULL)
+   (void) munmap ((void *) buffer, bufferSize);
+ free (fileName);
+ free (tailToken);
+ buffer = fileName = tailToken = NULL;
+ bufferSize = currPos = lineStart = holdPos = 0;
+ b_holdingChar = false;
+}
@@ -0,0 +1,52 @@
+/*
+*-----------------------------------------------------------------------
+*
+*   File         : gramscan.h
+*   Created      : 2026-10-19
+*   Last Modified: 2026-10-19
+*
+*   DESCRIPTION:
+*   Hand-written scanner for grammar files. It returns the same
+*   tokens as the LEXAN job set up in read_grammar(), reading the
+*   whole file through mmap instead of matching regular expressions
+*
+*-----------------------------------------------------------------------
+*/
+
+/*                                           */
+/* Make sure this file is not included twice */
+/*                                           */
+
+#ifndef _GRAMSCAN_DOT_H_
+#define _GRAMSCAN_DOT_H_
+
+/*
+*---------------------------------------------------------------------
+*   INCLUDE FILES
+*---------------------------------------------------------------------
+*/
+
+#include <stdbool.h>
+
+#include "lexan.h"
+
+/*
+*---------------------------------------------------------------------
+* Function prototypes
+*---------------------------------------------------------------------
+*/
+
+/* GRAMSCAN_start_job() returns false if the file cannot be mapped   */
+/* into memory (eg. it is empty or not a regular file), in which case */
+/* the caller should fall back to LEXAN.                              */
+/*                                                                    */
+/* The string returned in p_tokenVal->tokenStr points into the mapped */
+/* file: it must not be freed, and it stays valid only until the next */
+/* call to GRAMSCAN_get_token() or GRAMSCAN_terminate_job().          */
+
+extern bool  GRAMSCAN_start_job       (const char *fileName);
+extern bool  GRAMSCAN_get_token       (LEXAN_t_tokenType *p_token, LEXAN_t_tokenVal *p_tokenVal);
+extern char *GRAMSCAN_get_error_descr (void);
+extern void  GRAMSCAN_terminate_job   (void);
+
+#endif /* ifndef _GRAMSCAN_DOT_H_ */
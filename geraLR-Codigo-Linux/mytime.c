@@ -3,7 +3,7 @@
 *
 *   File         : time.c
 *   Created      : 1994-05-19
-*   Last Modified: 2012-05-28 (2018-03-28: realTimeStrSize bug fixed)
+*   Last Modified: 2026-10-19 (wall clock readings added)
 *
 *   Time-related functions and stopwatches
 *
@@ -16,6 +16,10 @@
 *---------------------------------------------------------------------
 */
 
+/* clock_gettime() is POSIX, not ANSI */
+
+#define _POSIX_C_SOURCE 199309L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
@@ -39,6 +43,7 @@
 void              TIME_init_stopwatches    (void);
 TIME_t_stopwatch  TIME_setup_stopwatch     (void);
 TIME_t_seconds    TIME_read_stopwatch      (TIME_t_stopwatch index);
+TIME_t_seconds    TIME_read_wall_stopwatch (TIME_t_stopwatch index);
 TIME_t_seconds    TIME_stop_stopwatch      (TIME_t_stopwatch index);
 TIME_t_seconds    TIME_start_stopwatch     (TIME_t_stopwatch index);
 TIME_t_seconds    TIME_clear_stopwatch     (TIME_t_stopwatch index);
@@ -107,7 +112,9 @@ typedef struct {
     initial_time;
   TIME_t_seconds
     curr_reading,
-    acc_reading;
+    acc_reading,
+    initial_wall,
+    acc_wall;
   t_realTimeStr
     starting_timeStr;
 }
@@ -124,8 +131,9 @@ static bool
 /* Function prototypes */
 /*                     */
 
-static bool valid_stopWatch  (TIME_t_stopwatch index);
-static void update_stopWatch (TIME_t_stopwatch index);
+static bool           valid_stopWatch  (TIME_t_stopwatch index);
+static void           update_stopWatch (TIME_t_stopwatch index);
+static TIME_t_seconds wall_clock       (void);
 
 /*
 *---------------------------------------------------------------------
@@ -144,6 +152,8 @@ void TIME_init_stopwatches (void)
  dummy_stopWatch.initial_time  = (time_t)  0;
  dummy_stopWatch.curr_reading  = (TIME_t_seconds)  0;
  dummy_stopWatch.acc_reading   = (TIME_t_seconds)  0;
+ dummy_stopWatch.initial_wall  = (TIME_t_seconds)  0;
+ dummy_stopWatch.acc_wall      = (TIME_t_seconds)  0;
  strcpy (dummy_stopWatch.starting_timeStr, "");
  for (c_watch = 0; c_watch < maxStopWatches; c_watch++)
    stopWatch [c_watch] = dummy_stopWatch;
@@ -178,6 +188,8 @@ TIME_t_stopwatch TIME_setup_stopwatch (void)
    p_stopWatch->initial_time  = (time_t)  0;
    p_stopWatch->curr_reading  = (TIME_t_seconds)  0;
    p_stopWatch->acc_reading   = (TIME_t_seconds)  0;
+   p_stopWatch->initial_wall  = (TIME_t_seconds)  0;
+   p_stopWatch->acc_wall      = (TIME_t_seconds)  0;
    strcpy (p_stopWatch->starting_timeStr, "");
    return (index);
  }
@@ -259,6 +271,43 @@ TIME_t_seconds TIME_read_stopwatch (TIME_t_stopwatch index)
  return (running_time);
 }
 
+/*
+*---------------------------------------------------------------------
+*   Returns the seconds elapsed on a monotonic wall clock
+*---------------------------------------------------------------------
+*/
+
+static TIME_t_seconds wall_clock (void)
+{
+ struct timespec
+   now;
+
+ if (clock_gettime (CLOCK_MONOTONIC, &now) != 0)
+   return ((TIME_t_seconds) time(NULL));
+ return ((TIME_t_seconds) now.tv_sec + (TIME_t_seconds) now.tv_nsec / 1e9);
+}
+
+/*
+*---------------------------------------------------------------------
+*   Returns the current wall clock reading of a stopwatch. Unlike
+*   TIME_read_stopwatch(), which measures processor time, this
+*   includes the time spent waiting for I/O and child processes.
+*---------------------------------------------------------------------
+*/
+
+TIME_t_seconds TIME_read_wall_stopwatch (TIME_t_stopwatch index)
+{
+ TIME_t_seconds
+   running_time;
+
+ if (! valid_stopWatch (index))
+   return (TIME_NULL_TIME);
+ running_time = stopWatch[index].acc_wall;
+ if (stopWatch[index].b_running)
+   running_time += wall_clock() - stopWatch[index].initial_wall;
+ return (running_time);
+}
+
 /*
 *---------------------------------------------------------------------
 *   Stops (pauses) a stopwatch and returns its current reading
@@ -276,6 +325,7 @@ TIME_t_seconds TIME_stop_stopwatch (TIME_t_stopwatch index)
    return (TIME_NULL_TIME);
  running_secs = TIME_read_stopwatch (index);
  p_stopWatch = (t_stopWatch *) stopWatch + index;
+ p_stopWatch->acc_wall = TIME_read_wall_stopwatch (index);
  p_stopWatch->acc_reading += p_stopWatch->curr_reading;
  p_stopWatch->curr_reading = (TIME_t_seconds) 0;
  stopWatch[index].b_running = false;
@@ -301,6 +351,7 @@ TIME_t_seconds TIME_start_stopwatch (TIME_t_stopwatch index)
  p_stopWatch = (t_stopWatch *) stopWatch + index;
  p_stopWatch->initial_clock = clock();
  p_stopWatch->initial_time  = time(NULL);
+ p_stopWatch->initial_wall  = wall_clock();
  p_stopWatch->b_running     = true;
  strcpy (p_stopWatch->starting_timeStr, TIME_getCurrentTimeStr());
  return (running_secs);
@@ -326,8 +377,10 @@ TIME_t_seconds TIME_clear_stopwatch (TIME_t_stopwatch index)
  p_stopWatch = (t_stopWatch *) stopWatch + index;
  p_stopWatch->initial_clock = clock();
  p_stopWatch->initial_time  = time(NULL);
+ p_stopWatch->initial_wall  = wall_clock();
  p_stopWatch->acc_reading   = (TIME_t_seconds) 0;
  p_stopWatch->curr_reading  = (TIME_t_seconds) 0;
+ p_stopWatch->acc_wall      = (TIME_t_seconds) 0;
  return (running_secs);
 }
 
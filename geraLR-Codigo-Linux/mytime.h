@@ -3,7 +3,7 @@
 *
 *   File         : time.h
 *   Created      : 1994-05-19
-*   Last Modified: 2012-05-28
+*   Last Modified: 2026-10-19
 *
 *   Time-related functions and stopwatches
 *
@@ -38,6 +38,7 @@
 extern void              TIME_init_stopwatches    (void);
 extern TIME_t_stopwatch  TIME_setup_stopwatch     (void);
 extern TIME_t_seconds    TIME_read_stopwatch      (TIME_t_stopwatch index);
+extern TIME_t_seconds    TIME_read_wall_stopwatch (TIME_t_stopwatch index);
 extern TIME_t_seconds    TIME_stop_stopwatch      (TIME_t_stopwatch index);
 extern TIME_t_seconds    TIME_start_stopwatch     (TIME_t_stopwatch index);
 extern TIME_t_seconds    TIME_clear_stopwatch     (TIME_t_stopwatch index);
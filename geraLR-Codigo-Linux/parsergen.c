@@ -0,0 +1,1077 @@
+/*
+*-----------------------------------------------------------------------
+*
+*   File         : parsergen.c
+*   Created      : 2026-10-19
+*   Last Modified: 2026-10-19
+*
+*   DESCRIPTION:
+*   Generation of direct-coded sLR(1) parsers in C source form.
+*
+*   Each DFA state becomes a labelled block whose ACTION row is a
+*   switch on the lookahead token, so a shift is a direct jump to the
+*   next state block. Each rule becomes a labelled block that pops the
+*   stack and switches on the uncovered state to take the GOTO.
+*
+*   When compiled with -DSLR1_BENCHMARK the generated file also holds
+*   a classic table-driven parser over the very same tables, and a
+*   main() that times both parsers on random sentences of the grammar.
+*
+*   Unit rules (A -> B, B a non-terminal) can be bypassed: when every
+*   action in the row of the state reached by a GOTO on B is a reduction
+*   by the same A -> B, the GOTO on B is taken straight to the state a
+*   GOTO on A would reach, following chains of unit rules, and the
+*   reduction never happens.
+*
+*-----------------------------------------------------------------------
+*/
+
+/*
+*-----------------------------------------------------------------------
+*   LIBRARIES AND INCLUDE FILES
+*-----------------------------------------------------------------------
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "common.h"
+#include "error.h"
+#include "grammar.h"
+#include "geraLR.h"
+#include "parsergen.h"
+
+/*
+*---------------------------------------------------------------------
+*
+*   INTERFACE (visible from other modules)
+*
+*---------------------------------------------------------------------
+*/
+
+/*                     */
+/* Function prototypes */
+/*                     */
+
+void print_slr1_parser_code (int argc, char *argv[], bool b_bypassUnitRules);
+
+/* To prevent "implicit declaration" warnings */
+
+int snprintf (char *str, size_t size, const char *format, ...);
+
+/*
+*---------------------------------------------------------------------
+*
+*   IMPLEMENTATION (not visible from other modules)
+*
+*---------------------------------------------------------------------
+*/
+
+#define NO_SHORTEST_RULE  0   /* Non-terminal does not derive any terminal string */
+
+static unsigned int
+  totShiftReduceConflicts  = 0,
+  totReduceReduceConflicts = 0;
+
+static unsigned int
+  totBypassedUnitRules = 0,
+  totBypassedGotos     = 0;
+
+static bool
+  b_liveState   [MAX_DFA_STATES + 1],   /* Indexed by state number */
+  b_reducedRule [MAX_RULES + 1];
+
+static t_ruleNumber
+  bypassedUnitRule [MAX_DFA_STATES + 1];   /* Indexed by state number; 0 if the state is kept */
+
+/*                       */
+/* Function declarations */
+/*                       */
+
+static t_parseAction resolve_parse_action     (t_stateCode stateCode, t_symbolCode symbolCode);
+static int           parse_action2table_entry (t_parseAction parseAction);
+static void          count_conflicts          (void);
+static void          find_unit_rule_states    (bool b_bypassUnitRules);
+static t_stateCode   goto_state               (t_stateCode stateCode, t_symbolCode symbolCode);
+static void          find_live_states         (void);
+static void          find_shortest_rules      (t_ruleNumber shortestRule[]);
+static void          print_comment_string     (FILE *filePt, const char *string);
+static void          print_string_literal     (FILE *filePt, const char *string);
+static void          print_prologue           (void);
+static void          print_direct_parser      (void);
+static void          print_state_block        (t_stateCode stateCode);
+static void          print_reduce_block       (t_ruleNumber ruleNumber);
+static void          print_benchmark          (void);
+static void          print_benchmark_tables   (void);
+static void          print_table_parser       (const char *functionName, const char *gotoTableName);
+static void          print_benchmark_driver   (void);
+
+/*
+*---------------------------------------------------------------------
+* Take a state and a terminal and return the single sLR(1) action the
+* generated parser will take. Conflicts are resolved the yacc way:
+* shift wins over reduce, and the lowest-numbered rule wins over any
+* other reduction. Returns a t_error action for an empty table cell.
+*---------------------------------------------------------------------
+*/
+
+static t_parseAction resolve_parse_action (t_stateCode stateCode, t_symbolCode symbolCode)
+{
+ unsigned int
+   iAction,
+   totActions;
+ t_parseAction
+   parseAction,
+   chosenAction;
+
+ chosenAction.parseActionType = t_error;
+ chosenAction.parseActionParam.nextState = 0;
+ totActions = parseTablePos2totParseActions (t_sLR1_parse_table, stateCode, symbolCode);
+ for (iAction = 1; iAction <= totActions; iAction++) {
+   parseAction = parseTablePos2parseAction (t_sLR1_parse_table, stateCode, symbolCode, iAction);
+   if (parseAction.parseActionType == t_shift)
+     return (parseAction);
+   if ((chosenAction.parseActionType == t_error) ||
+       (parseAction.parseActionParam.reductionRule < chosenAction.parseActionParam.reductionRule))
+     chosenAction = parseAction;
+ }
+ return (chosenAction);
+}
+
+/*
+*---------------------------------------------------------------------
+* Encode a parse action as a table entry of the generated parser:
+* shift to state S is +S, reduce by rule R is -R (so -1 accepts, as
+* rule 1 is the augmented rule), and the error action is 0
+*---------------------------------------------------------------------
+*/
+
+static int parse_action2table_entry (t_parseAction parseAction)
+{
+ switch (parseAction.parseActionType) {
+   case (t_shift):
+   case (t_goto):
+     return ((int) parseAction.parseActionParam.nextState);
+   case (t_reduce):
+   case (t_accept):
+     return (- (int) parseAction.parseActionParam.reductionRule);
+   default:
+     return (0);
+ }
+}
+
+/*
+*---------------------------------------------------------------------
+* Count the sLR(1) table cells that need conflict resolution
+*---------------------------------------------------------------------
+*/
+
+static void count_conflicts (void)
+{
+ unsigned int
+   iState,
+   iSymbol,
+   iAction,
+   totActions,
+   totShifts;
+ t_stateCode
+   stateCode;
+ t_symbolCode
+   symbolCode;
+
+ totShiftReduceConflicts  = 0;
+ totReduceReduceConflicts = 0;
+ for (iState = 1; iState <= totDFAstates; iState++) {
+   stateCode = dfa_stateNumber2stateCode (iState);
+   for (iSymbol = 1; iSymbol <= totTerminals; iSymbol++) {
+     symbolCode = symbolNumber2symbolCode (iSymbol, t_terminal);
+     totActions = parseTablePos2totParseActions (t_sLR1_parse_table, stateCode, symbolCode);
+     if (totActions < 2)
+       continue;
+     totShifts = 0;
+     for (iAction = 1; iAction <= totActions; iAction++)
+       if (parseTablePos2parseAction (t_sLR1_parse_table, stateCode, symbolCode, iAction).parseActionType == t_shift)
+         totShifts++;
+     if (totShifts > 0)
+       totShiftReduceConflicts++;
+     else
+       totReduceReduceConflicts++;
+   }
+ }
+}
+
+/*
+*---------------------------------------------------------------------
+* Find the states whose whole row is a reduction by one unit rule, so
+* that GOTOs into them can be bypassed. With b_bypassUnitRules false
+* no state is bypassed and the GOTOs are those of the sLR(1) table.
+*---------------------------------------------------------------------
+*/
+
+static void find_unit_rule_states (bool b_bypassUnitRules)
+{
+ unsigned int
+   iState,
+   iSymbol;
+ t_stateCode
+   stateCode;
+ t_symbolCode
+   symbolCode;
+ t_ruleNumber
+   ruleNumber;
+ t_parseAction
+   parseAction;
+ bool
+   b_bypassed [MAX_RULES + 1];
+
+ memset (bypassedUnitRule, 0, sizeof (bypassedUnitRule));
+ memset (b_bypassed, 0, sizeof (b_bypassed));
+ totBypassedUnitRules = 0;
+ totBypassedGotos     = 0;
+ if (! b_bypassUnitRules)
+   return;
+
+ for (iState = 2; iState <= totDFAstates; iState++) {
+   stateCode = dfa_stateNumber2stateCode (iState);
+   ruleNumber = 0;
+   for (iSymbol = 1; iSymbol <= totTerminals; iSymbol++) {
+     parseAction = resolve_parse_action (stateCode, symbolNumber2symbolCode (iSymbol, t_terminal));
+     if (parseAction.parseActionType == t_error)
+       continue;
+     if ((parseAction.parseActionType != t_reduce) ||
+         ((ruleNumber != 0) && (parseAction.parseActionParam.reductionRule != ruleNumber))) {
+       ruleNumber = 0;
+       break;
+     }
+     ruleNumber = parseAction.parseActionParam.reductionRule;
+   }
+   if ((ruleNumber == 0) ||
+       (ruleNumber2ruleSize (ruleNumber) != 1) ||
+       (symbolCode2symbolType (rulePos2symbolCode (ruleNumber, 1)) != t_nonTerminal))
+     continue;
+   for (iSymbol = 1; iSymbol <= totNonTerminals; iSymbol++)
+     if (parseTablePos2totParseActions (t_sLR1_parse_table, stateCode, symbolNumber2symbolCode (iSymbol, t_nonTerminal)) > 0)
+       break;
+   if (iSymbol <= totNonTerminals)
+     continue;
+   bypassedUnitRule[iState] = ruleNumber;
+   if (! b_bypassed[ruleNumber]) {
+     b_bypassed[ruleNumber] = true;
+     totBypassedUnitRules++;
+   }
+ }
+
+ /* Count the GOTO entries that no longer lead where the sLR(1) table says */
+
+ totBypassedGotos = 0;
+ for (iState = 1; iState <= totDFAstates; iState++) {
+   stateCode = dfa_stateNumber2stateCode (iState);
+   for (iSymbol = 1; iSymbol <= totNonTerminals; iSymbol++) {
+     symbolCode = symbolNumber2symbolCode (iSymbol, t_nonTerminal);
+     if ((parseTablePos2totParseActions (t_sLR1_parse_table, stateCode, symbolCode) > 0) &&
+         (goto_state (stateCode, symbolCode) != parseTablePos2parseAction (t_sLR1_parse_table, stateCode, symbolCode, 1).parseActionParam.nextState))
+       totBypassedGotos++;
+   }
+ }
+}
+
+/*
+*---------------------------------------------------------------------
+* Take the GOTO on a non-terminal out of a state, skipping over any
+* states that would only reduce by a unit rule. The GOTO must exist.
+* A cycle of unit rules (A -> B, B -> A) stops after as many steps as
+* there are states.
+*---------------------------------------------------------------------
+*/
+
+static t_stateCode goto_state (t_stateCode stateCode, t_symbolCode symbolCode)
+{
+ unsigned int
+   iStep;
+ t_stateCode
+   nextState;
+ t_ruleNumber
+   ruleNumber;
+
+ nextState = parseTablePos2parseAction (t_sLR1_parse_table, stateCode, symbolCode, 1).parseActionParam.nextState;
+ for (iStep = 0; iStep < totDFAstates; iStep++) {
+   ruleNumber = bypassedUnitRule[dfa_stateCode2stateNumber (nextState)];
+   if (ruleNumber == 0)
+     break;
+   nextState = parseTablePos2parseAction (t_sLR1_parse_table, stateCode, rulePos2symbolCode (ruleNumber, 0), 1).parseActionParam.nextState;
+ }
+ return (nextState);
+}
+
+/*
+*---------------------------------------------------------------------
+* Find the states the direct-coded parser can actually reach, and the
+* rules it can actually reduce, once conflicts have been resolved.
+* Only those get a labelled block, so the generated code has neither
+* dead blocks nor unused labels.
+*---------------------------------------------------------------------
+*/
+
+static void find_live_states (void)
+{
+ unsigned int
+   iState,
+   iSymbol,
+   iRule;
+ t_stateCode
+   stateCode,
+   nextState;
+ t_symbolCode
+   lefthandSymbol;
+ t_parseAction
+   parseAction;
+ bool
+   b_stillChanging;
+
+ memset (b_liveState, 0, sizeof (b_liveState));
+ memset (b_reducedRule, 0, sizeof (b_reducedRule));
+ b_liveState[1] = true;
+
+ b_stillChanging = true;
+ while (b_stillChanging) {
+   b_stillChanging = false;
+   for (iState = 1; iState <= totDFAstates; iState++) {
+     if (! b_liveState[iState])
+       continue;
+     stateCode = dfa_stateNumber2stateCode (iState);
+
+     /* Shifts and reductions out of this state */
+
+     for (iSymbol = 1; iSymbol <= totTerminals; iSymbol++) {
+       parseAction = resolve_parse_action (stateCode, symbolNumber2symbolCode (iSymbol, t_terminal));
+       if (parseAction.parseActionType == t_shift) {
+         nextState = dfa_stateCode2stateNumber (parseAction.parseActionParam.nextState);
+         if (! b_liveState[nextState])
+           b_liveState[nextState] = b_stillChanging = true;
+       }
+       else if ((parseAction.parseActionType == t_reduce) && ! b_reducedRule[parseAction.parseActionParam.reductionRule])
+         b_reducedRule[parseAction.parseActionParam.reductionRule] = b_stillChanging = true;
+     }
+
+     /* GOTOs out of this state, after any reduction it may uncover */
+
+     for (iRule = 2; iRule <= totRules; iRule++) {
+       if (! b_reducedRule[iRule])
+         continue;
+       lefthandSymbol = rulePos2symbolCode (iRule, 0);
+       if (parseTablePos2totParseActions (t_sLR1_parse_table, stateCode, lefthandSymbol) == 0)
+         continue;
+       nextState = dfa_stateCode2stateNumber (goto_state (stateCode, lefthandSymbol));
+       if (! b_liveState[nextState])
+         b_liveState[nextState] = b_stillChanging = true;
+     }
+   }
+ }
+}
+
+/*
+*---------------------------------------------------------------------
+* For each non-terminal find the rule that derives a terminal string
+* in the fewest derivation levels. The benchmark sentence generator
+* switches to these rules once a sentence has grown long enough, which
+* guarantees that every sentence is finite.
+*---------------------------------------------------------------------
+*/
+
+static void find_shortest_rules (t_ruleNumber shortestRule[])
+{
+ unsigned int
+   iRule,
+   iSymbol,
+   ruleSize,
+   ruleHeight,
+   lefthandNumber,
+   symbolHeight,
+   height [MAX_NON_TERMINALS + 1];
+ t_symbolCode
+   symbolCode;
+ bool
+   b_stillChanging,
+   b_productive;
+
+ for (iSymbol = 1; iSymbol <= totNonTerminals; iSymbol++) {
+   shortestRule[iSymbol] = NO_SHORTEST_RULE;
+   height[iSymbol] = 0;
+ }
+
+ /* Bellman-Ford style relaxation: a rule's height is one more than */
+ /* the greatest height among its righthand side non-terminals      */
+
+ b_stillChanging = true;
+ while (b_stillChanging) {
+   b_stillChanging = false;
+   for (iRule = 1; iRule <= totRules; iRule++) {
+     lefthandNumber = (unsigned int) (rulePos2symbolCode (iRule, 0) - symbolNumber2symbolCode (1, t_nonTerminal)) + 1;
+     ruleSize = ruleNumber2ruleSize (iRule);
+     ruleHeight = 1;
+     b_productive = true;
+     for (iSymbol = 1; (iSymbol <= ruleSize) && b_productive; iSymbol++) {
+       symbolCode = rulePos2symbolCode (iRule, iSymbol);
+       if (symbolCode2symbolType (symbolCode) != t_nonTerminal)
+         continue;
+       symbolHeight = height[(unsigned int) (symbolCode - symbolNumber2symbolCode (1, t_nonTerminal)) + 1];
+       if (symbolHeight == 0)
+         b_productive = false;
+       else
+         ruleHeight = GREATEST (ruleHeight, symbolHeight + 1);
+     }
+     if (b_productive && ((height[lefthandNumber] == 0) || (ruleHeight < height[lefthandNumber]))) {
+       height[lefthandNumber] = ruleHeight;
+       shortestRule[lefthandNumber] = iRule;
+       b_stillChanging = true;
+     }
+   }
+ }
+}
+
+/*
+*---------------------------------------------------------------------
+* Print a grammar symbol inside a C comment, making sure it cannot
+* close the comment early
+*---------------------------------------------------------------------
+*/
+
+static void print_comment_string (FILE *filePt, const char *string)
+{
+ for (; *string != '\0'; string++) {
+   fputc (*string, filePt);
+   if ((string[0] == '*') && (string[1] == '/'))
+     fputc (' ', filePt);
+ }
+}
+
+/*
+*---------------------------------------------------------------------
+* Print a grammar symbol as a C string literal
+*---------------------------------------------------------------------
+*/
+
+static void print_string_literal (FILE *filePt, const char *string)
+{
+ fputc ('"', filePt);
+ for (; *string != '\0'; string++) {
+   if ((*string == '"') || (*string == '\\'))
+     fputc ('\\', filePt);
+   fputc (*string, filePt);
+ }
+ fputc ('"', filePt);
+}
+
+/*
+*---------------------------------------------------------------------
+* Print the definitions shared by both parsers
+*---------------------------------------------------------------------
+*/
+
+static void print_prologue (void)
+{
+ unsigned int
+   iSymbol;
+ t_symbolCode
+   symbolCode;
+ FILE
+   *filePt = slr1ParserCodeFilePt;
+
+ fprintf (filePt, "/*\n");
+ fprintf (filePt, "*-----------------------------------------------------------------------\n");
+ fprintf (filePt, "* Direct-coded sLR(1) parser\n");
+ fprintf (filePt, "*\n");
+ fprintf (filePt, "* Call slr1_parse() with an array of terminal codes (end of input is\n");
+ fprintf (filePt, "* implied after the last token). Define SLR1_REDUCE_ACTION(rule) to\n");
+ fprintf (filePt, "* run semantic actions. Compile with -DSLR1_BENCHMARK to time this\n");
+ fprintf (filePt, "* parser against a table-driven one on random sentences.\n");
+ fprintf (filePt, "*\n");
+ fprintf (filePt, "* sLR(1) conflicts resolved in favour of shift : %u\n", totShiftReduceConflicts);
+ fprintf (filePt, "* sLR(1) conflicts resolved in favour of rule  : %u\n", totReduceReduceConflicts);
+ if (totBypassedUnitRules > 0) {
+   fprintf (filePt, "* Unit rules bypassed                          : %u\n", totBypassedUnitRules);
+   fprintf (filePt, "* GOTO entries rewritten to bypass them        : %u\n", totBypassedGotos);
+   fprintf (filePt, "* SLR1_REDUCE_ACTION() is not run for the unit rules that are bypassed.\n");
+ }
+ fprintf (filePt, "*-----------------------------------------------------------------------\n");
+ fprintf (filePt, "*/\n\n");
+
+ fprintf (filePt, "#include <stddef.h>\n\n");
+
+ fprintf (filePt, "#define SLR1_TOT_TERMINALS       %u\n", totTerminals);
+ fprintf (filePt, "#define SLR1_TOT_NON_TERMINALS   %u\n", totNonTerminals);
+ fprintf (filePt, "#define SLR1_TOT_RULES           %u\n", totRules);
+ fprintf (filePt, "#define SLR1_TOT_STATES          %u\n", totDFAstates);
+ fprintf (filePt, "#define SLR1_START_STATE         %d\n", dfa_stateNumber2stateCode (1));
+ fprintf (filePt, "#define SLR1_END_OF_INPUT        %d\n", end_of_input_code);
+ fprintf (filePt, "#define SLR1_FIRST_NON_TERMINAL  %d\n\n", symbolNumber2symbolCode (1, t_nonTerminal));
+
+ fprintf (filePt, "#define SLR1_ACCEPT               0\n");
+ fprintf (filePt, "#define SLR1_SYNTAX_ERROR        -1\n");
+ fprintf (filePt, "#define SLR1_STACK_OVERFLOW      -2\n\n");
+
+ fprintf (filePt, "#ifndef SLR1_STACK_SIZE\n");
+ fprintf (filePt, "#define SLR1_STACK_SIZE  4096\n");
+ fprintf (filePt, "#endif\n\n");
+
+ fprintf (filePt, "#ifdef SLR1_BENCHMARK\n");
+ fprintf (filePt, "static unsigned long slr1_totReductions = 0;\n");
+ fprintf (filePt, "#ifndef SLR1_REDUCE_ACTION\n");
+ fprintf (filePt, "#define SLR1_REDUCE_ACTION(rule)  (slr1_totReductions++)\n");
+ fprintf (filePt, "#endif\n");
+ fprintf (filePt, "#endif\n\n");
+
+ fprintf (filePt, "#ifndef SLR1_REDUCE_ACTION\n");
+ fprintf (filePt, "#define SLR1_REDUCE_ACTION(rule)  ((void) 0)\n");
+ fprintf (filePt, "#endif\n\n");
+
+ fprintf (filePt, "#define SLR1_LOOKAHEAD(pos)  ((pos) < totTokens ? tokens[pos] : SLR1_END_OF_INPUT)\n\n");
+
+ fprintf (filePt, "#define SLR1_PUSH(state)                \\\n");
+ fprintf (filePt, "  do {                                  \\\n");
+ fprintf (filePt, "    if (++top >= SLR1_STACK_SIZE)       \\\n");
+ fprintf (filePt, "      return (SLR1_STACK_OVERFLOW);     \\\n");
+ fprintf (filePt, "    stack[top] = (state);               \\\n");
+ fprintf (filePt, "  } while (0)\n\n");
+
+ fprintf (filePt, "#define SLR1_SHIFT(state)               \\\n");
+ fprintf (filePt, "  do {                                  \\\n");
+ fprintf (filePt, "    SLR1_PUSH (state);                  \\\n");
+ fprintf (filePt, "    pos++;                              \\\n");
+ fprintf (filePt, "    lookahead = SLR1_LOOKAHEAD (pos);   \\\n");
+ fprintf (filePt, "  } while (0)\n\n");
+
+ /* Symbol names, indexed by terminal code and by non-terminal number */
+
+ fprintf (filePt, "const char *const slr1_terminalNames [SLR1_TOT_TERMINALS + 1] = {\n");
+ fprintf (filePt, "  \"\"");
+ for (iSymbol = 1; iSymbol <= totTerminals; iSymbol++) {
+   symbolCode = symbolNumber2symbolCode (iSymbol, t_terminal);
+   fprintf (filePt, ",\n  ");
+   print_string_literal (filePt, symbolCode2symbolString (symbolCode));
+ }
+ fprintf (filePt, "\n};\n\n");
+
+ fprintf (filePt, "const char *const slr1_nonTerminalNames [SLR1_TOT_NON_TERMINALS + 1] = {\n");
+ fprintf (filePt, "  \"\"");
+ for (iSymbol = 1; iSymbol <= totNonTerminals; iSymbol++) {
+   symbolCode = symbolNumber2symbolCode (iSymbol, t_nonTerminal);
+   fprintf (filePt, ",\n  ");
+   print_string_literal (filePt, symbolCode2symbolString (symbolCode));
+ }
+ fprintf (filePt, "\n};\n\n");
+
+ fprintf (filePt, "int slr1_parse (const int *tokens, size_t totTokens, size_t *p_errorPos);\n\n");
+}
+
+/*
+*---------------------------------------------------------------------
+* Print the labelled block for one DFA state: a switch on the
+* lookahead token, with terminals sharing an action grouped together
+*---------------------------------------------------------------------
+*/
+
+static void print_state_block (t_stateCode stateCode)
+{
+ unsigned int
+   iSymbol,
+   jSymbol;
+ t_symbolCode
+   symbolCode;
+ t_parseAction
+   parseAction,
+   rowActions [MAX_TERMINALS + 1];
+ bool
+   b_printed [MAX_TERMINALS + 1];
+ FILE
+   *filePt = slr1ParserCodeFilePt;
+
+ for (iSymbol = 1; iSymbol <= totTerminals; iSymbol++) {
+   rowActions[iSymbol] = resolve_parse_action (stateCode, symbolNumber2symbolCode (iSymbol, t_terminal));
+   b_printed[iSymbol] = (rowActions[iSymbol].parseActionType == t_error);
+ }
+
+ fprintf (filePt, "state_%d:\n", stateCode);
+ fprintf (filePt, " switch (lookahead) {\n");
+ for (iSymbol = 1; iSymbol <= totTerminals; iSymbol++) {
+   if (b_printed[iSymbol])
+     continue;
+   parseAction = rowActions[iSymbol];
+   for (jSymbol = iSymbol; jSymbol <= totTerminals; jSymbol++) {
+     if (b_printed[jSymbol] || (parse_action2table_entry (rowActions[jSymbol]) != parse_action2table_entry (parseAction)))
+       continue;
+     symbolCode = symbolNumber2symbolCode (jSymbol, t_terminal);
+     fprintf (filePt, "   case %d:  /* ", symbolCode);
+     print_comment_string (filePt, symbolCode2symbolString (symbolCode));
+     fprintf (filePt, " */\n");
+     b_printed[jSymbol] = true;
+   }
+   switch (parseAction.parseActionType) {
+     case (t_shift): {
+       fprintf (filePt, "     SLR1_SHIFT (%d);\n", parseAction.parseActionParam.nextState);
+       fprintf (filePt, "     goto state_%d;\n", parseAction.parseActionParam.nextState);
+       break;
+     }
+     case (t_reduce): {
+       fprintf (filePt, "     goto reduce_%u;\n", parseAction.parseActionParam.reductionRule);
+       break;
+     }
+     case (t_accept): {
+       fprintf (filePt, "     SLR1_REDUCE_ACTION (%u);\n", parseAction.parseActionParam.reductionRule);
+       fprintf (filePt, "     return (SLR1_ACCEPT);\n");
+       break;
+     }
+     default: {
+       snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Invalid parse action type %d in state %d\n", parseAction.parseActionType, stateCode);
+       ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+     }
+   }
+ }
+ fprintf (filePt, "   default:\n");
+ fprintf (filePt, "     goto syntax_error;\n");
+ fprintf (filePt, " }\n\n");
+}
+
+/*
+*---------------------------------------------------------------------
+* Print the labelled block for one rule: pop the righthand side and
+* take the GOTO on the lefthand side from the uncovered state
+*---------------------------------------------------------------------
+*/
+
+static void print_reduce_block (t_ruleNumber ruleNumber)
+{
+ unsigned int
+   iState,
+   iSymbol,
+   ruleSize;
+ t_stateCode
+   stateCode,
+   nextState;
+ t_symbolCode
+   lefthandSymbol;
+ FILE
+   *filePt = slr1ParserCodeFilePt;
+
+ lefthandSymbol = rulePos2symbolCode (ruleNumber, 0);
+ ruleSize = ruleNumber2ruleSize (ruleNumber);
+
+ fprintf (filePt, "reduce_%u:  /* ", ruleNumber);
+ print_comment_string (filePt, symbolCode2symbolString (lefthandSymbol));
+ fprintf (filePt, " ->");
+ for (iSymbol = 1; iSymbol <= ruleSize; iSymbol++) {
+   fprintf (filePt, " ");
+   print_comment_string (filePt, symbolCode2symbolString (rulePos2symbolCode (ruleNumber, iSymbol)));
+ }
+ fprintf (filePt, " */\n");
+ if (ruleSize > 0)
+   fprintf (filePt, " top -= %u;\n", ruleSize);
+ fprintf (filePt, " SLR1_REDUCE_ACTION (%u);\n", ruleNumber);
+ fprintf (filePt, " switch (stack[top]) {\n");
+ for (iState = 1; iState <= totDFAstates; iState++) {
+   stateCode = dfa_stateNumber2stateCode (iState);
+   if ((! b_liveState[iState]) || (parseTablePos2totParseActions (t_sLR1_parse_table, stateCode, lefthandSymbol) == 0))
+     continue;
+   nextState = goto_state (stateCode, lefthandSymbol);
+   fprintf (filePt, "   case %d:\n", stateCode);
+   fprintf (filePt, "     SLR1_PUSH (%d);\n", nextState);
+   fprintf (filePt, "     goto state_%d;\n", nextState);
+ }
+ fprintf (filePt, "   default:\n");
+ fprintf (filePt, "     goto syntax_error;\n");
+ fprintf (filePt, " }\n\n");
+}
+
+/*
+*---------------------------------------------------------------------
+* Print the direct-coded parser function
+*---------------------------------------------------------------------
+*/
+
+static void print_direct_parser (void)
+{
+ unsigned int
+   iState,
+   iRule;
+ FILE
+   *filePt = slr1ParserCodeFilePt;
+
+ fprintf (filePt, "int slr1_parse (const int *tokens, size_t totTokens, size_t *p_errorPos)\n");
+ fprintf (filePt, "{\n");
+ fprintf (filePt, " int\n");
+ fprintf (filePt, "   stack [SLR1_STACK_SIZE],\n");
+ fprintf (filePt, "   top = 0,\n");
+ fprintf (filePt, "   lookahead;\n");
+ fprintf (filePt, " size_t\n");
+ fprintf (filePt, "   pos = 0;\n\n");
+ fprintf (filePt, " stack[0] = SLR1_START_STATE;\n");
+ fprintf (filePt, " lookahead = SLR1_LOOKAHEAD (pos);\n");
+ fprintf (filePt, " goto state_%d;\n\n", dfa_stateNumber2stateCode (1));
+
+ /* One block per reachable state, then one per reducible rule */
+
+ find_live_states ();
+ for (iState = 1; iState <= totDFAstates; iState++)
+   if (b_liveState[iState])
+     print_state_block (dfa_stateNumber2stateCode (iState));
+ for (iRule = 2; iRule <= totRules; iRule++)
+   if (b_reducedRule[iRule])
+     print_reduce_block (iRule);
+
+ fprintf (filePt, "syntax_error:\n");
+ fprintf (filePt, " if (p_errorPos != NULL)\n");
+ fprintf (filePt, "   *p_errorPos = pos;\n");
+ fprintf (filePt, " return (SLR1_SYNTAX_ERROR);\n");
+ fprintf (filePt, "}\n\n");
+}
+
+/*
+*---------------------------------------------------------------------
+* Print the tables used by the table-driven parser and by the
+* sentence generator of the benchmark
+*---------------------------------------------------------------------
+*/
+
+static void print_benchmark_tables (void)
+{
+ unsigned int
+   iTable,
+   iState,
+   iSymbol,
+   iRule,
+   ruleSize,
+   posFirstSymbol;
+ t_stateCode
+   stateCode;
+ t_symbolCode
+   symbolCode;
+ t_ruleNumber
+   shortestRule [MAX_NON_TERMINALS + 1];
+ t_parseAction
+   parseAction;
+ FILE
+   *filePt = slr1ParserCodeFilePt;
+
+ /* ACTION and GOTO tables, one row per state */
+
+ fprintf (filePt, "/* ACTION: shift to S is +S, reduce by rule R is -R (-1 accepts), error is 0 */\n\n");
+ fprintf (filePt, "static const int slr1_actionTable [SLR1_TOT_STATES + 1][SLR1_TOT_TERMINALS + 1] = {\n");
+ fprintf (filePt, "  { 0 }");
+ for (iState = 1; iState <= totDFAstates; iState++) {
+   stateCode = dfa_stateNumber2stateCode (iState);
+   fprintf (filePt, ",\n  { 0");
+   for (iSymbol = 1; iSymbol <= totTerminals; iSymbol++) {
+     parseAction = resolve_parse_action (stateCode, symbolNumber2symbolCode (iSymbol, t_terminal));
+     fprintf (filePt, ", %d", parse_action2table_entry (parseAction));
+   }
+   fprintf (filePt, " }");
+ }
+ fprintf (filePt, "\n};\n\n");
+
+ for (iTable = (totBypassedUnitRules > 0) ? 1 : 2; iTable <= 2; iTable++) {
+   if (iTable == 1)
+     fprintf (filePt, "/* GOTO as in the sLR(1) table, without the unit rule bypass */\n\n");
+   fprintf (filePt, "static const int %s [SLR1_TOT_STATES + 1][SLR1_TOT_NON_TERMINALS + 1] = {\n",
+            (iTable == 1) ? "slr1_unitGotoTable" : "slr1_gotoTable");
+   fprintf (filePt, "  { 0 }");
+   for (iState = 1; iState <= totDFAstates; iState++) {
+     stateCode = dfa_stateNumber2stateCode (iState);
+     fprintf (filePt, ",\n  { 0");
+     for (iSymbol = 1; iSymbol <= totNonTerminals; iSymbol++) {
+       symbolCode = symbolNumber2symbolCode (iSymbol, t_nonTerminal);
+       if (parseTablePos2totParseActions (t_sLR1_parse_table, stateCode, symbolCode) == 0)
+         fprintf (filePt, ", 0");
+       else if (iTable == 1)
+         fprintf (filePt, ", %d", parse_action2table_entry (parseTablePos2parseAction (t_sLR1_parse_table, stateCode, symbolCode, 1)));
+       else
+         fprintf (filePt, ", %d", goto_state (stateCode, symbolCode));
+     }
+     fprintf (filePt, " }");
+   }
+   fprintf (filePt, "\n};\n\n");
+ }
+
+ /* Rules: size, lefthand side number and righthand side symbols */
+
+ fprintf (filePt, "static const int slr1_ruleSize [SLR1_TOT_RULES + 1] = {\n  0");
+ for (iRule = 1; iRule <= totRules; iRule++)
+   fprintf (filePt, ", %u", ruleNumber2ruleSize (iRule));
+ fprintf (filePt, "\n};\n\n");
+
+ fprintf (filePt, "static const int slr1_ruleLefthand [SLR1_TOT_RULES + 1] = {\n  0");
+ for (iRule = 1; iRule <= totRules; iRule++)
+   fprintf (filePt, ", %d", rulePos2symbolCode (iRule, 0) - symbolNumber2symbolCode (1, t_nonTerminal) + 1);
+ fprintf (filePt, "\n};\n\n");
+
+ fprintf (filePt, "static const int slr1_ruleFirstSymbol [SLR1_TOT_RULES + 2] = {\n  0");
+ posFirstSymbol = 0;
+ for (iRule = 1; iRule <= totRules + 1; iRule++) {
+   fprintf (filePt, ", %u", posFirstSymbol);
+   if (iRule <= totRules)
+     posFirstSymbol += ruleNumber2ruleSize (iRule);
+ }
+ fprintf (filePt, "\n};\n\n");
+
+ fprintf (filePt, "static const int slr1_righthandSymbols [%u] = {\n ", posFirstSymbol);
+ for (iRule = 1; iRule <= totRules; iRule++) {
+   ruleSize = ruleNumber2ruleSize (iRule);
+   for (iSymbol = 1; iSymbol <= ruleSize; iSymbol++)
+     fprintf (filePt, " %d%s", rulePos2symbolCode (iRule, iSymbol), ((iRule == totRules) && (iSymbol == ruleSize)) ? "" : ",");
+   fprintf (filePt, "\n ");
+ }
+ fprintf (filePt, "};\n\n");
+
+ find_shortest_rules (shortestRule);
+ fprintf (filePt, "static const int slr1_shortestRule [SLR1_TOT_NON_TERMINALS + 1] = {\n  0");
+ for (iSymbol = 1; iSymbol <= totNonTerminals; iSymbol++)
+   fprintf (filePt, ", %u", shortestRule[iSymbol]);
+ fprintf (filePt, "\n};\n\n");
+}
+
+/*
+*---------------------------------------------------------------------
+* Print a table-driven parser that takes its GOTOs from the given table
+*---------------------------------------------------------------------
+*/
+
+static void print_table_parser (const char *functionName, const char *gotoTableName)
+{
+ FILE
+   *filePt = slr1ParserCodeFilePt;
+
+ fprintf (filePt, "static int %s (const int *tokens, size_t totTokens, size_t *p_errorPos)\n", functionName);
+ fprintf (filePt, "{\n");
+ fprintf (filePt, " int\n");
+ fprintf (filePt, "   stack [SLR1_STACK_SIZE],\n");
+ fprintf (filePt, "   top = 0,\n");
+ fprintf (filePt, "   lookahead,\n");
+ fprintf (filePt, "   action;\n");
+ fprintf (filePt, " size_t\n");
+ fprintf (filePt, "   pos = 0;\n\n");
+ fprintf (filePt, " stack[0] = SLR1_START_STATE;\n");
+ fprintf (filePt, " lookahead = SLR1_LOOKAHEAD (pos);\n");
+ fprintf (filePt, " for (;;) {\n");
+ fprintf (filePt, "   action = ((lookahead < 1) || (lookahead > SLR1_TOT_TERMINALS)) ? 0 : slr1_actionTable[stack[top]][lookahead];\n");
+ fprintf (filePt, "   if (action > 0)\n");
+ fprintf (filePt, "     SLR1_SHIFT (action);\n");
+ fprintf (filePt, "   else if (action == -1) {\n");
+ fprintf (filePt, "     SLR1_REDUCE_ACTION (1);\n");
+ fprintf (filePt, "     return (SLR1_ACCEPT);\n");
+ fprintf (filePt, "   }\n");
+ fprintf (filePt, "   else if (action < 0) {\n");
+ fprintf (filePt, "     top -= slr1_ruleSize[-action];\n");
+ fprintf (filePt, "     SLR1_REDUCE_ACTION (-action);\n");
+ fprintf (filePt, "     action = %s[stack[top]][slr1_ruleLefthand[-action]];\n", gotoTableName);
+ fprintf (filePt, "     SLR1_PUSH (action);\n");
+ fprintf (filePt, "   }\n");
+ fprintf (filePt, "   else {\n");
+ fprintf (filePt, "     if (p_errorPos != NULL)\n");
+ fprintf (filePt, "       *p_errorPos = pos;\n");
+ fprintf (filePt, "     return (SLR1_SYNTAX_ERROR);\n");
+ fprintf (filePt, "   }\n");
+ fprintf (filePt, " }\n");
+ fprintf (filePt, "}\n\n");
+}
+
+/*
+*---------------------------------------------------------------------
+* Print the table-driven parsers, the sentence generator and main()
+*---------------------------------------------------------------------
+*/
+
+static void print_benchmark_driver (void)
+{
+ FILE
+   *filePt = slr1ParserCodeFilePt;
+
+ /* Table-driven parsers, the second one without the unit rule bypass */
+
+ print_table_parser ("slr1_parse_table_driven", "slr1_gotoTable");
+ if (totBypassedUnitRules > 0)
+   print_table_parser ("slr1_parse_table_unit", "slr1_unitGotoTable");
+
+ /* Random number generator (xorshift), so that runs are reproducible everywhere */
+
+ fprintf (filePt, "static unsigned long slr1_randomState = 2463534242UL;\n\n");
+ fprintf (filePt, "static unsigned long slr1_random (void)\n");
+ fprintf (filePt, "{\n");
+ fprintf (filePt, " slr1_randomState ^= (slr1_randomState << 13) & 0xffffffffUL;\n");
+ fprintf (filePt, " slr1_randomState ^= (slr1_randomState >> 17);\n");
+ fprintf (filePt, " slr1_randomState ^= (slr1_randomState << 5) & 0xffffffffUL;\n");
+ fprintf (filePt, " return (slr1_randomState);\n");
+ fprintf (filePt, "}\n\n");
+
+ /* Sentence generator: random leftmost derivation from the start symbol */
+
+ fprintf (filePt, "static size_t slr1_generate_sentence (int *tokens, size_t maxTokens, size_t targetTokens)\n");
+ fprintf (filePt, "{\n");
+ fprintf (filePt, " int\n");
+ fprintf (filePt, "   pending [SLR1_STACK_SIZE],\n");
+ fprintf (filePt, "   top = 0,\n");
+ fprintf (filePt, "   symbol,\n");
+ fprintf (filePt, "   nonTerminal,\n");
+ fprintf (filePt, "   rule,\n");
+ fprintf (filePt, "   iRule,\n");
+ fprintf (filePt, "   iSymbol,\n");
+ fprintf (filePt, "   alternatives,\n");
+ fprintf (filePt, "   choice;\n");
+ fprintf (filePt, " size_t\n");
+ fprintf (filePt, "   totTokens = 0;\n\n");
+ fprintf (filePt, " pending[top++] = slr1_righthandSymbols[slr1_ruleFirstSymbol[1]];\n");
+ fprintf (filePt, " while (top > 0) {\n");
+ fprintf (filePt, "   symbol = pending[--top];\n");
+ fprintf (filePt, "   if (symbol < SLR1_FIRST_NON_TERMINAL) {\n");
+ fprintf (filePt, "     if (totTokens == maxTokens)\n");
+ fprintf (filePt, "       return (0);\n");
+ fprintf (filePt, "     tokens[totTokens++] = symbol;\n");
+ fprintf (filePt, "     continue;\n");
+ fprintf (filePt, "   }\n");
+ fprintf (filePt, "   nonTerminal = symbol - SLR1_FIRST_NON_TERMINAL + 1;\n");
+ fprintf (filePt, "   rule = slr1_shortestRule[nonTerminal];\n");
+ fprintf (filePt, "   if (rule == 0)\n");
+ fprintf (filePt, "     return (0);\n");
+ fprintf (filePt, "   if (totTokens + (size_t) top < targetTokens) {\n");
+ fprintf (filePt, "     for (alternatives = 0, iRule = 2; iRule <= SLR1_TOT_RULES; iRule++)\n");
+ fprintf (filePt, "       alternatives += (slr1_ruleLefthand[iRule] == nonTerminal);\n");
+ fprintf (filePt, "     choice = (int) (slr1_random () %% (unsigned long) alternatives);\n");
+ fprintf (filePt, "     for (iRule = 2; iRule <= SLR1_TOT_RULES; iRule++)\n");
+ fprintf (filePt, "       if ((slr1_ruleLefthand[iRule] == nonTerminal) && (choice-- == 0))\n");
+ fprintf (filePt, "         break;\n");
+ fprintf (filePt, "     rule = iRule;\n");
+ fprintf (filePt, "   }\n");
+ fprintf (filePt, "   if (top + slr1_ruleSize[rule] > SLR1_STACK_SIZE)\n");
+ fprintf (filePt, "     return (0);\n");
+ fprintf (filePt, "   for (iSymbol = slr1_ruleFirstSymbol[rule+1] - 1; iSymbol >= slr1_ruleFirstSymbol[rule]; iSymbol--)\n");
+ fprintf (filePt, "     pending[top++] = slr1_righthandSymbols[iSymbol];\n");
+ fprintf (filePt, " }\n");
+ fprintf (filePt, " return (totTokens);\n");
+ fprintf (filePt, "}\n\n");
+
+ /* main(): build a corpus, then run both parsers over it */
+
+ fprintf (filePt, "typedef int (*slr1_t_parser) (const int *tokens, size_t totTokens, size_t *p_errorPos);\n\n");
+ fprintf (filePt, "static double slr1_time_parser (const char *label, slr1_t_parser parser, const int *corpus,\n");
+ fprintf (filePt, "                                const size_t *sentenceStart, size_t totSentences, int rounds)\n");
+ fprintf (filePt, "{\n");
+ fprintf (filePt, " size_t\n");
+ fprintf (filePt, "   iSentence,\n");
+ fprintf (filePt, "   totTokens = 0,\n");
+ fprintf (filePt, "   totAccepted = 0;\n");
+ fprintf (filePt, " int\n");
+ fprintf (filePt, "   iRound;\n");
+ fprintf (filePt, " clock_t\n");
+ fprintf (filePt, "   startTime;\n");
+ fprintf (filePt, " double\n");
+ fprintf (filePt, "   seconds,\n");
+ fprintf (filePt, "   reductionsPerToken;\n\n");
+ fprintf (filePt, " slr1_totReductions = 0;\n");
+ fprintf (filePt, " startTime = clock ();\n");
+ fprintf (filePt, " for (iRound = 0; iRound < rounds; iRound++)\n");
+ fprintf (filePt, "   for (iSentence = 0; iSentence < totSentences; iSentence++) {\n");
+ fprintf (filePt, "     totTokens += sentenceStart[iSentence+1] - sentenceStart[iSentence];\n");
+ fprintf (filePt, "     if (parser (&corpus[sentenceStart[iSentence]], sentenceStart[iSentence+1] - sentenceStart[iSentence], NULL) == SLR1_ACCEPT)\n");
+ fprintf (filePt, "       totAccepted++;\n");
+ fprintf (filePt, "   }\n");
+ fprintf (filePt, " seconds = (double) (clock () - startTime) / CLOCKS_PER_SEC;\n");
+ fprintf (filePt, " reductionsPerToken = (totTokens > 0) ? (double) slr1_totReductions / (double) totTokens : 0.0;\n");
+ fprintf (filePt, " printf (\"%%-14s %%12lu tokens %%10lu accepted %%12lu reductions %%7.3f per token %%9.3f s %%14.0f tokens/s\\n\",\n");
+ fprintf (filePt, "         label, (unsigned long) totTokens, (unsigned long) totAccepted, slr1_totReductions, reductionsPerToken,\n");
+ fprintf (filePt, "         seconds, (seconds > 0.0) ? (double) totTokens / seconds : 0.0);\n");
+ fprintf (filePt, " return (reductionsPerToken);\n");
+ fprintf (filePt, "}\n\n");
+
+ fprintf (filePt, "int main (int argc, char *argv[])\n");
+ fprintf (filePt, "{\n");
+ fprintf (filePt, " size_t\n");
+ fprintf (filePt, "   iSentence,\n");
+ fprintf (filePt, "   totSentences = 0,\n");
+ fprintf (filePt, "   wantedSentences = 10000,\n");
+ fprintf (filePt, "   targetTokens    = 100,\n");
+ fprintf (filePt, "   maxTokens,\n");
+ fprintf (filePt, "   sentenceLength,\n");
+ fprintf (filePt, "   corpusSize = 0,\n");
+ fprintf (filePt, "   *sentenceStart = NULL;\n");
+ fprintf (filePt, " int\n");
+ fprintf (filePt, "   rounds = 10,\n");
+ fprintf (filePt, "   *corpus = NULL;\n");
+ if (totBypassedUnitRules > 0) {
+   fprintf (filePt, " double\n");
+   fprintf (filePt, "   reductionsPerToken,\n");
+   fprintf (filePt, "   unitReductionsPerToken;\n");
+ }
+ fprintf (filePt, "\n");
+ fprintf (filePt, " if (argc > 1) wantedSentences  = (size_t) strtoul (argv[1], NULL, 10);\n");
+ fprintf (filePt, " if (argc > 2) targetTokens     = (size_t) strtoul (argv[2], NULL, 10);\n");
+ fprintf (filePt, " if (argc > 3) rounds           = atoi (argv[3]);\n");
+ fprintf (filePt, " if (argc > 4) slr1_randomState = strtoul (argv[4], NULL, 10) | 1UL;\n");
+ fprintf (filePt, " maxTokens = 4 * targetTokens + SLR1_STACK_SIZE;\n\n");
+ fprintf (filePt, " corpus = (int *) malloc (wantedSentences * maxTokens * sizeof (int));\n");
+ fprintf (filePt, " sentenceStart = (size_t *) malloc ((wantedSentences + 1) * sizeof (size_t));\n");
+ fprintf (filePt, " if ((corpus == NULL) || (sentenceStart == NULL)) {\n");
+ fprintf (filePt, "   fprintf (stderr, \"Not enough memory for %%lu sentences\\n\", (unsigned long) wantedSentences);\n");
+ fprintf (filePt, "   return (EXIT_FAILURE);\n");
+ fprintf (filePt, " }\n");
+ fprintf (filePt, " for (iSentence = 0; iSentence < wantedSentences; iSentence++) {\n");
+ fprintf (filePt, "   sentenceLength = slr1_generate_sentence (&corpus[corpusSize], maxTokens, targetTokens);\n");
+ fprintf (filePt, "   if (sentenceLength == 0)\n");
+ fprintf (filePt, "     continue;\n");
+ fprintf (filePt, "   sentenceStart[totSentences++] = corpusSize;\n");
+ fprintf (filePt, "   corpusSize += sentenceLength;\n");
+ fprintf (filePt, " }\n");
+ fprintf (filePt, " sentenceStart[totSentences] = corpusSize;\n");
+ fprintf (filePt, " printf (\"%%lu sentences, %%lu tokens, %%d rounds\\n\", (unsigned long) totSentences, (unsigned long) corpusSize, rounds);\n\n");
+ fprintf (filePt, " slr1_time_parser (\"direct-coded\", slr1_parse,              corpus, sentenceStart, totSentences, rounds);\n");
+ if (totBypassedUnitRules == 0)
+   fprintf (filePt, " slr1_time_parser (\"table-driven\", slr1_parse_table_driven, corpus, sentenceStart, totSentences, rounds);\n\n");
+ else {
+   fprintf (filePt, " reductionsPerToken     = slr1_time_parser (\"table-driven\", slr1_parse_table_driven, corpus, sentenceStart, totSentences, rounds);\n");
+   fprintf (filePt, " unitReductionsPerToken = slr1_time_parser (\"table-unit\",   slr1_parse_table_unit,   corpus, sentenceStart, totSentences, rounds);\n");
+   fprintf (filePt, " printf (\"Unit rule bypass saves %%.3f reductions per token (%%.1f%%%%)\\n\", unitReductionsPerToken - reductionsPerToken,\n");
+   fprintf (filePt, "         (unitReductionsPerToken > 0.0) ? 100.0 * (unitReductionsPerToken - reductionsPerToken) / unitReductionsPerToken : 0.0);\n\n");
+ }
+ fprintf (filePt, " free (sentenceStart);\n");
+ fprintf (filePt, " free (corpus);\n");
+ fprintf (filePt, " return (EXIT_SUCCESS);\n");
+ fprintf (filePt, "}\n\n");
+}
+
+/*
+*---------------------------------------------------------------------
+* Print the benchmark section of the generated file
+*---------------------------------------------------------------------
+*/
+
+static void print_benchmark (void)
+{
+ FILE
+   *filePt = slr1ParserCodeFilePt;
+
+ fprintf (filePt, "#ifdef SLR1_BENCHMARK\n\n");
+ fprintf (filePt, "#include <stdio.h>\n");
+ fprintf (filePt, "#include <stdlib.h>\n");
+ fprintf (filePt, "#include <time.h>\n\n");
+ print_benchmark_tables ();
+ print_benchmark_driver ();
+ fprintf (filePt, "#endif /* SLR1_BENCHMARK */\n");
+}
+
+/*
+*---------------------------------------------------------------------
+* Print the direct-coded sLR(1) parser for the current grammar,
+* bypassing unit rules if asked to. The sLR(1) parse table must
+* already have been built.
+*---------------------------------------------------------------------
+*/
+
+void print_slr1_parser_code (int argc, char *argv[], bool b_bypassUnitRules)
+{
+ print_output_header (slr1ParserCodeFilePt, slr1ParserCodeFileName, argc, argv);
+ count_conflicts ();
+ find_unit_rule_states (b_bypassUnitRules);
+ print_prologue ();
+ print_direct_parser ();
+ print_benchmark ();
+ fflush (slr1ParserCodeFilePt);
+}
@@ -0,0 +1,37 @@
+/*
+*-----------------------------------------------------------------------
+*
+*   File         : parsergen.h
+*   Created      : 2026-10-19
+*   Last Modified: 2026-10-19
+*
+*   DESCRIPTION:
+*   Generation of direct-coded sLR(1) parsers in C source form
+*
+*-----------------------------------------------------------------------
+*/
+
+/*                                           */
+/* Make sure this file is not included twice */
+/*                                           */
+
+#ifndef _PARSERGEN_DOT_H_
+#define _PARSERGEN_DOT_H_
+
+/*
+*---------------------------------------------------------------------
+*   INCLUDE FILES
+*---------------------------------------------------------------------
+*/
+
+#include <stdbool.h>
+
+/*
+*---------------------------------------------------------------------
+* Function prototypes
+*---------------------------------------------------------------------
+*/
+
+extern void print_slr1_parser_code (int argc, char *argv[], bool b_bypassUnitRules);
+
+#endif /* ifndef _PARSERGEN_DOT_H_ */
@@ -0,0 +1,330 @@
+/*
+*-----------------------------------------------------------------------
+*
+*   File         : server.c
+*   Created      : 2026-10-19
+*   Last Modified: 2026-10-19
+*
+*   DESCRIPTION:
+*   Server mode. The server listens on a Unix domain socket and takes
+*   one request per connection. Each request is run in a child forked
+*   from the server, so whatever the server set up before its first
+*   request (the Graphviz context, the SVG attributes read from the
+*   configuration file, the loaded shared libraries) is already there,
+*   and a fatal error in one request cannot bring the server down.
+*
+*   A request is a single line holding a geraLR command line without
+*   the program name, its arguments separated by blanks (so they can
+*   hold no blanks themselves). The reply is everything the run writes
+*   to standard output and standard error, then a last line
+*
+*     #status N
+*
+*   with its exit status, and the server closes the connection. File
+*   names are relative to the working directory of the server.
+*
+*-----------------------------------------------------------------------
+*/
+
+/*
+*-----------------------------------------------------------------------
+*   LIBRARIES AND INCLUDE FILES
+*-----------------------------------------------------------------------
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+#include "error.h"
+#include "server.h"
+
+/*
+*---------------------------------------------------------------------
+*
+*   INTERFACE (visible from other modules)
+*
+*---------------------------------------------------------------------
+*/
+
+/*                     */
+/* Function prototypes */
+/*                     */
+
+void serve_requests (const char *socketName, char *programName, t_requestHandler requestHandler);
+
+/*
+*---------------------------------------------------------------------
+*
+*   IMPLEMENTATION (not visible from other modules)
+*
+*---------------------------------------------------------------------
+*/
+
+#define MAX_REQUEST_SIZE  4096
+#define MAX_REQUEST_ARGS  64
+#define LISTEN_BACKLOG    64
+
+static volatile sig_atomic_t
+  b_stopServing = 0;
+
+/*                       */
+/* Function declarations */
+/*                       */
+
+static void stop_serving   (int signalNumber);
+static int  open_socket    (const char *socketName);
+static bool read_request   (int connection, char *request);
+static int  split_request  (char *request, char *programName, char *argv[]);
+static void write_all      (int connection, const char *data, size_t dataSize);
+static void handle_request (int connection, int listener, char *programName, t_requestHandler requestHandler);
+
+/*
+*---------------------------------------------------------------------
+* Signal handler for SIGINT and SIGTERM
+*---------------------------------------------------------------------
+*/
+
+static void stop_serving (int signalNumber)
+{
+ (void) signalNumber;
+ b_stopServing = 1;
+}
+
+/*
+*---------------------------------------------------------------------
+* Create the socket, bind it to its name and listen on it. A socket
+* file left behind by an earlier server is removed first.
+*---------------------------------------------------------------------
+*/
+
+static int open_socket (const char *socketName)
+{
+ int
+   listener;
+ struct sockaddr_un
+   address;
+
+ if (strlen (socketName) >= sizeof (address.sun_path)) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Socket name \"%s\" is too long", socketName);
+   ERROR_short_fatal_error (ERROR_auxErrorMsg);
+ }
+ memset (&address, 0, sizeof (address));
+ address.sun_family = AF_UNIX;
+ strcpy (address.sun_path, socketName);
+
+ errno = 0;
+ if ((listener = socket (AF_UNIX, SOCK_STREAM, 0)) < 0)
+   ERROR_fatal_error (errno, __FILE__, __func__, "Cannot create socket");
+ (void) unlink (socketName);
+ errno = 0;
+ if (bind (listener, (struct sockaddr *) &address, sizeof (address)) < 0) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Cannot bind socket to \"%s\"", socketName);
+   ERROR_fatal_error (errno, __FILE__, __func__, ERROR_auxErrorMsg);
+ }
+ errno = 0;
+ if (listen (listener, LISTEN_BACKLOG) < 0) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Cannot listen on \"%s\"", socketName);
+   ERROR_fatal_error (errno, __FILE__, __func__, ERROR_auxErrorMsg);
+ }
+ return (listener);
+}
+
+/*
+*---------------------------------------------------------------------
+* Read one request line, without its newline. Returns false if the
+* client went away or sent a line too long to be a command line.
+*---------------------------------------------------------------------
+*/
+
+static bool read_request (int connection, char *request)
+{
+ size_t
+   requestSize = 0;
+ ssize_t
+   bytesRead;
+ char
+   *newLine;
+
+ for (;;) {
+   bytesRead = read (connection, request + requestSize, MAX_REQUEST_SIZE - 1 - requestSize);
+   if ((bytesRead < 0) && (errno == EINTR))
+     continue;
+   if (bytesRead <= 0)
+     return (false);
+   requestSize += (size_t) bytesRead;
+   request[requestSize] = '\0';
+   if ((newLine = strchr (request, '\n')) != NULL) {
+     *newLine = '\0';
+     return (true);
+   }
+   if (requestSize == MAX_REQUEST_SIZE - 1)
+     return (false);
+ }
+}
+
+/*
+*---------------------------------------------------------------------
+* Split a request line into a command line, in place. Returns argc,
+* or -1 if there are too many arguments.
+*---------------------------------------------------------------------
+*/
+
+static int split_request (char *request, char *programName, char *argv[])
+{
+ int
+   argc = 0;
+ char
+   *arg;
+
+ argv[argc++] = programName;
+ for (arg = strtok (request, " \t\r"); arg != NULL; arg = strtok (NULL, " \t\r")) {
+   if (argc == MAX_REQUEST_ARGS)
+     return (-1);
+   argv[argc++] = arg;
+ }
+ argv[argc] = NULL;
+ return (argc);
+}
+
+/*
+*---------------------------------------------------------------------
+* Write a whole buffer to the client, giving up if it went away
+*---------------------------------------------------------------------
+*/
+
+static void write_all (int connection, const char *data, size_t dataSize)
+{
+ ssize_t
+   bytesWritten;
+
+ while (dataSize > 0) {
+   bytesWritten = write (connection, data, dataSize);
+   if ((bytesWritten < 0) && (errno == EINTR))
+     continue;
+   if (bytesWritten <= 0)
+     return;
+   data += bytesWritten;
+   dataSize -= (size_t) bytesWritten;
+ }
+}
+
+/*
+*---------------------------------------------------------------------
+* Read a request, run it in a child process with its standard output
+* and standard error sent to the client, then send its exit status
+*---------------------------------------------------------------------
+*/
+
+static void handle_request (int connection, int listener, char *programName, t_requestHandler requestHandler)
+{
+ int
+   argc,
+   status,
+   exitStatus;
+ char
+   request [MAX_REQUEST_SIZE],
+   statusLine [32],
+   *argv [MAX_REQUEST_ARGS + 1];
+ pid_t
+   child;
+
+ if (! read_request (connection, request))
+   return;
+ if ((argc = split_request (request, programName, argv)) < 0) {
+   snprintf (statusLine, sizeof (statusLine), "#status %d\n", EXIT_FAILURE);
+   write_all (connection, statusLine, strlen (statusLine));
+   return;
+ }
+
+ fflush (NULL);
+ errno = 0;
+ if ((child = fork ()) < 0)
+   ERROR_fatal_error (errno, __FILE__, __func__, "Cannot fork a child for the request");
+
+ if (child == 0) {
+
+   signal (SIGINT,  SIG_DFL);
+   signal (SIGTERM, SIG_DFL);
+   close (listener);
+   if ((dup2 (connection, STDOUT_FILENO) < 0) || (dup2 (connection, STDERR_FILENO) < 0))
+     _exit (EXIT_FAILURE);
+   close (connection);
+
+   /* The handler parses a fresh command line, so getopt() must start over */
+
+   optind = 1;
+   requestHandler (argc, argv);
+   exit (EXIT_SUCCESS);
+ }
+
+ while (waitpid (child, &status, 0) < 0)
+   if (errno != EINTR) {
+     status = EXIT_FAILURE << 8;
+     break;
+   }
+ if (WIFEXITED (status))
+   exitStatus = WEXITSTATUS (status);
+ else if (WIFSIGNALED (status))
+   exitStatus = 128 + WTERMSIG (status);
+ else
+   exitStatus = EXIT_FAILURE;
+ snprintf (statusLine, sizeof (statusLine), "#status %d\n", exitStatus);
+ write_all (connection, statusLine, strlen (statusLine));
+}
+
+/*
+*---------------------------------------------------------------------
+* Serve requests on a Unix domain socket, one connection at a time,
+* until the server is told to stop by SIGINT or SIGTERM
+*---------------------------------------------------------------------
+*/
+
+void serve_requests (const char *socketName, char *programName, t_requestHandler requestHandler)
+{
+ int
+   listener,
+   connection;
+ unsigned long int
+   totRequests = 0;
+ struct sigaction
+   action;
+
+ /* No SA_RESTART, so that a signal gets the server out of accept() */
+
+ memset (&action, 0, sizeof (action));
+ action.sa_handler = stop_serving;
+ sigemptyset (&action.sa_mask);
+ sigaction (SIGINT,  &action, NULL);
+ sigaction (SIGTERM, &action, NULL);
+ signal (SIGPIPE, SIG_IGN);
+
+ listener = open_socket (socketName);
+ printf ("%s: serving requests on \"%s\"\n", programName, socketName);
+ fflush (stdout);
+
+ while (! b_stopServing) {
+   if ((connection = accept (listener, NULL, NULL)) < 0) {
+     if ((errno == EINTR) || (errno == ECONNABORTED))
+       continue;
+     ERROR_fatal_error (errno, __FILE__, __func__, "Cannot accept a connection");
+   }
+   handle_request (connection, listener, programName, requestHandler);
+   close (connection);
+   totRequests++;
+ }
+
+ close (listener);
+ unlink (socketName);
+ printf ("%s: served %lu requests\n", programName, totRequests);
+}
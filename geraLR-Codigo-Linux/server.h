@@ -0,0 +1,47 @@
+/*
+*-----------------------------------------------------------------------
+*
+*   File         : server.h
+*   Created      : 2026-10-19
+*   Last Modified: 2026-10-19
+*
+*   DESCRIPTION:
+*   Server mode: geraLR command lines read from a Unix domain socket
+*   and run one after the other, each in a child process forked from
+*   a server that has already done its start-up work
+*
+*-----------------------------------------------------------------------
+*/
+
+/*                                           */
+/* Make sure this file is not included twice */
+/*                                           */
+
+#ifndef _SERVER_DOT_H_
+#define _SERVER_DOT_H_
+
+/*
+*---------------------------------------------------------------------
+*   Type definitions
+*---------------------------------------------------------------------
+*/
+
+/* Runs one request in the child process. It gets a command line    */
+/* whose argv[0] is the program name, and should not return: the    */
+/* child's exit status is the request's status. The child's standard */
+/* output and standard error go to the client.                      */
+
+typedef void (*t_requestHandler) (int argc, char *argv[]);
+
+/*
+*---------------------------------------------------------------------
+* Function prototypes
+*---------------------------------------------------------------------
+*/
+
+/* serve_requests() only returns once SIGINT or SIGTERM is received, */
+/* after removing the socket.                                         */
+
+extern void serve_requests (const char *socketName, char *programName, t_requestHandler requestHandler);
+
+#endif /* ifndef _SERVER_DOT_H_ */
@@ -0,0 +1,581 @@
+/*
+*-----------------------------------------------------------------------
+*
+*   File         : subsetdfa.c
+*   Created      : 2026-10-19
+*   Last Modified: 2026-10-19
+*
+*   DESCRIPTION:
+*   A second DFA construction engine, independent of the item-based
+*   dfa_gotoState() path in grammar.c: classic subset construction
+*   over the LR(0) NFA.
+*
+*   Each DFA state is a bitset of NFA states. States are hash-consed,
+*   so finding out whether a goto() set is new takes one hash look up
+*   instead of a comparison with every existing state. States are
+*   numbered breadth first, trying non-terminals before terminals,
+*   which is the order the item-based builder uses.
+*
+*   check_subset_DFA() matches both automata state by state and
+*   transition by transition, and aborts on the first difference.
+*
+*-----------------------------------------------------------------------
+*/
+
+/*
+*-----------------------------------------------------------------------
+*   LIBRARIES AND INCLUDE FILES
+*-----------------------------------------------------------------------
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+
+#include "common.h"
+#include "error.h"
+#include "grammar.h"
+#include "subsetdfa.h"
+
+/*
+*---------------------------------------------------------------------
+*
+*   INTERFACE (visible from other modules)
+*
+*---------------------------------------------------------------------
+*/
+
+/*                     */
+/* Function prototypes */
+/*                     */
+
+void build_subset_DFA (void);
+void check_subset_DFA (void);
+void free_subset_DFA  (void);
+
+/* To prevent "implicit declaration" warnings */
+
+int snprintf (char *str, size_t size, const char *format, ...);
+
+/*
+*---------------------------------------------------------------------
+*
+*   IMPLEMENTATION (not visible from other modules)
+*
+*---------------------------------------------------------------------
+*/
+
+#define BITS_PER_WORD         (CHAR_BIT * sizeof (t_bitsetWord))
+#define NO_SUBSET_STATE       (-1)
+#define NO_SYMBOL_SLOT        (-1)
+#define INITIAL_SUBSET_STATES 256
+#define FNV_OFFSET_BASIS      2166136261UL
+#define FNV_PRIME             16777619UL
+
+typedef unsigned long
+  t_bitsetWord;
+
+typedef struct {                 /* How subset DFA transitions are stored: */
+  unsigned int fromState;        /*   index of the state of origin         */
+  t_symbolCode withSymbol;       /*   the numeric code of the symbol       */
+  unsigned int toState;          /*   index of the destination state       */
+}
+  t_subsetTransition;
+
+/* Grammar symbols in the order goto() is tried: non-terminals, then terminals */
+
+static t_symbolCode
+  *slot2symbolCode = NULL;
+
+/* The NFA, as seen from each state number minus one. Every NFA state has at */
+/* most one transition with a grammar symbol, plus zero or more epsilon ones */
+
+static int
+  *nfaMoveSlot      = NULL;      /* slot of the symbol of the non-epsilon transition, or NO_SYMBOL_SLOT */
+static unsigned int
+  *nfaMoveDest      = NULL,      /* its destination                                                     */
+  *nfaEpsilonFirst  = NULL,      /* position of the first epsilon destination in nfaEpsilonDest[]      */
+  *nfaEpsilonDest   = NULL,      /* epsilon destinations, grouped by state of origin                    */
+  *itemCode2nfaState = NULL;     /* the NFA state holding each LR(0) item                               */
+
+/* Subset DFA states, transitions and the hash table used to find states */
+
+static t_bitsetWord
+  *subsetStates = NULL;          /* totWords words per state */
+static t_subsetTransition
+  *subsetTransitions = NULL;
+static int
+  *hashTable = NULL;             /* indices into subsetStates, or NO_SUBSET_STATE */
+
+/* Work areas */
+
+static t_bitsetWord
+  *moveSets = NULL,              /* totWords words per symbol slot */
+  *newSet   = NULL;
+static bool
+  *b_slotUsed = NULL;
+static unsigned int
+  *workStack = NULL;
+
+static unsigned int
+  totNFAnumbers        = 0,
+  totWords             = 0,
+  totSlots             = 0,
+  totSubsetStates      = 0,
+  maxSubsetStates      = 0,
+  totSubsetTransitions = 0,
+  maxSubsetTransitions = 0,
+  hashTableSize        = 0;
+
+/*                       */
+/* Function declarations */
+/*                       */
+
+static void         *subset_malloc          (size_t size, const char *procName, const char *varName);
+static void          setup_symbol_slots     (void);
+static void          setup_nfa_tables       (void);
+static void          epsilon_closure        (t_bitsetWord *set);
+static unsigned long hash_bitset            (const t_bitsetWord *set);
+static int           find_subset_state      (const t_bitsetWord *set);
+static void          rehash_subset_states   (unsigned int newSize);
+static unsigned int  add_subset_state       (const t_bitsetWord *set);
+static void          add_subset_transition  (unsigned int fromState, t_symbolCode withSymbol, unsigned int toState);
+
+/*
+*---------------------------------------------------------------------
+* Allocate memory or abort
+*---------------------------------------------------------------------
+*/
+
+static void *subset_malloc (size_t size, const char *procName, const char *varName)
+{
+ void
+   *pMemory;
+
+ if ((pMemory = malloc (size > 0 ? size : 1)) == NULL)
+   ERROR_no_memory (0, __FILE__, procName, varName);
+ return (pMemory);
+}
+
+/*
+*---------------------------------------------------------------------
+* List the grammar symbols in the order the item-based builder
+* tries them, so both number their states in the same order
+*---------------------------------------------------------------------
+*/
+
+static void setup_symbol_slots (void)
+{
+ unsigned int
+   iSymbol;
+
+ totSlots = totNonTerminals + totTerminals;
+ slot2symbolCode = (t_symbolCode *) subset_malloc (totSlots * sizeof (t_symbolCode), __func__, "slot2symbolCode");
+ for (iSymbol = 1; iSymbol <= totNonTerminals; iSymbol++)
+   slot2symbolCode[iSymbol - 1] = symbolNumber2symbolCode (iSymbol, t_nonTerminal);
+ for (iSymbol = 1; iSymbol <= totTerminals; iSymbol++)
+   slot2symbolCode[totNonTerminals + iSymbol - 1] = symbolNumber2symbolCode (iSymbol, t_terminal);
+}
+
+/*
+*---------------------------------------------------------------------
+* Copy the NFA transitions into flat arrays indexed by state number
+*---------------------------------------------------------------------
+*/
+
+static void setup_nfa_tables (void)
+{
+ unsigned int
+   iState,
+   iTransition,
+   iSlot,
+   transitionNumber,
+   totEpsilonDest;
+ t_stateCode
+   stateCode;
+ t_symbolCode
+   symbolCode;
+
+ totNFAnumbers = totNFAstates;
+ nfaMoveSlot       = (int *)          subset_malloc (totNFAnumbers * sizeof (int),                   __func__, "nfaMoveSlot");
+ nfaMoveDest       = (unsigned int *) subset_malloc (totNFAnumbers * sizeof (unsigned int),          __func__, "nfaMoveDest");
+ nfaEpsilonFirst   = (unsigned int *) subset_malloc ((totNFAnumbers + 1) * sizeof (unsigned int),    __func__, "nfaEpsilonFirst");
+ nfaEpsilonDest    = (unsigned int *) subset_malloc ((totNFAtransitions + 1) * sizeof (unsigned int), __func__, "nfaEpsilonDest");
+ itemCode2nfaState = (unsigned int *) subset_malloc ((totLR0items + 1) * sizeof (unsigned int),      __func__, "itemCode2nfaState");
+
+ for (iState = 0, totEpsilonDest = 0; iState < totNFAnumbers; iState++) {
+   stateCode = nfa_stateNumber2stateCode (iState + 1);
+   itemCode2nfaState[nfa_stateCode2itemCode (stateCode)] = iState;
+   nfaMoveSlot[iState]     = NO_SYMBOL_SLOT;
+   nfaEpsilonFirst[iState] = totEpsilonDest;
+   if (nfa_isReductionState (stateCode))
+     continue;
+   for (iTransition = 1; iTransition <= nfa_stateCode2totTransitionsFromState (stateCode); iTransition++) {
+     transitionNumber = nfa_stateCode2transitionNumber (stateCode, iTransition);
+     symbolCode = nfa_transitionNumber2symbol (transitionNumber);
+     if (symbolCode == epsilon_code) {
+       nfaEpsilonDest[totEpsilonDest++] = nfa_stateCode2stateNumber (nfa_transitionNumber2destState (transitionNumber)) - 1;
+       continue;
+     }
+     for (iSlot = 0; iSlot < totSlots; iSlot++)
+       if (slot2symbolCode[iSlot] == symbolCode)
+         break;
+     if (iSlot == totSlots) {
+       snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "NFA state %d has a transition with unknown symbol %d\n", stateCode, symbolCode);
+       ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+     }
+     nfaMoveSlot[iState] = (int) iSlot;
+     nfaMoveDest[iState] = nfa_stateCode2stateNumber (nfa_transitionNumber2destState (transitionNumber)) - 1;
+   }
+ }
+ nfaEpsilonFirst[totNFAnumbers] = totEpsilonDest;
+}
+
+/*
+*---------------------------------------------------------------------
+* Add to a set of NFA states all states reachable by epsilon transitions
+*---------------------------------------------------------------------
+*/
+
+static void epsilon_closure (t_bitsetWord *set)
+{
+ unsigned int
+   iState,
+   iDest,
+   destState,
+   totStacked = 0;
+
+ for (iState = 0; iState < totNFAnumbers; iState++)
+   if (set[iState / BITS_PER_WORD] & (1UL << (iState % BITS_PER_WORD)))
+     workStack[totStacked++] = iState;
+ while (totStacked > 0) {
+   iState = workStack[--totStacked];
+   for (iDest = nfaEpsilonFirst[iState]; iDest < nfaEpsilonFirst[iState + 1]; iDest++) {
+     destState = nfaEpsilonDest[iDest];
+     if (set[destState / BITS_PER_WORD] & (1UL << (destState % BITS_PER_WORD)))
+       continue;
+     set[destState / BITS_PER_WORD] |= (1UL << (destState % BITS_PER_WORD));
+     workStack[totStacked++] = destState;
+   }
+ }
+}
+
+/*
+*---------------------------------------------------------------------
+* FNV-1a hash of a set of NFA states
+*---------------------------------------------------------------------
+*/
+
+static unsigned long hash_bitset (const t_bitsetWord *set)
+{
+ unsigned int
+   iWord;
+ unsigned long
+   hash = FNV_OFFSET_BASIS;
+
+ for (iWord = 0; iWord < totWords; iWord++) {
+   hash ^= set[iWord];
+   hash *= FNV_PRIME;
+ }
+ return (hash ^ (hash >> 17));
+}
+
+/*
+*---------------------------------------------------------------------
+* Return the index of the subset state equal to a set of NFA states,
+* or NO_SUBSET_STATE if there is none
+*---------------------------------------------------------------------
+*/
+
+static int find_subset_state (const t_bitsetWord *set)
+{
+ unsigned int
+   iSlot;
+ int
+   iState;
+
+ iSlot = (unsigned int) (hash_bitset (set) & (hashTableSize - 1));
+ while ((iState = hashTable[iSlot]) != NO_SUBSET_STATE) {
+   if (memcmp (&subsetStates[(size_t) iState * totWords], set, totWords * sizeof (t_bitsetWord)) == 0)
+     return (iState);
+   iSlot = (iSlot + 1) & (hashTableSize - 1);
+ }
+ return (NO_SUBSET_STATE);
+}
+
+/*
+*---------------------------------------------------------------------
+* Rebuild the hash table with a new size (a power of two)
+*---------------------------------------------------------------------
+*/
+
+static void rehash_subset_states (unsigned int newSize)
+{
+ unsigned int
+   iSlot,
+   iState;
+
+ free (hashTable);
+ hashTableSize = newSize;
+ hashTable = (int *) subset_malloc (hashTableSize * sizeof (int), __func__, "hashTable");
+ for (iSlot = 0; iSlot < hashTableSize; iSlot++)
+   hashTable[iSlot] = NO_SUBSET_STATE;
+ for (iState = 0; iState < totSubsetStates; iState++) {
+   iSlot = (unsigned int) (hash_bitset (&subsetStates[(size_t) iState * totWords]) & (hashTableSize - 1));
+   while (hashTable[iSlot] != NO_SUBSET_STATE)
+     iSlot = (iSlot + 1) & (hashTableSize - 1);
+   hashTable[iSlot] = (int) iState;
+ }
+}
+
+/*
+*---------------------------------------------------------------------
+* Add a new subset state and return its index
+*---------------------------------------------------------------------
+*/
+
+static unsigned int add_subset_state (const t_bitsetWord *set)
+{
+ unsigned int
+   iSlot;
+ t_bitsetWord
+   *p_newStates;
+
+ if (totSubsetStates == maxSubsetStates) {
+   maxSubsetStates *= 2;
+   p_newStates = (t_bitsetWord *) realloc (subsetStates, (size_t) maxSubsetStates * totWords * sizeof (t_bitsetWord));
+   if (p_newStates == NULL)
+     ERROR_no_memory (0, __FILE__, __func__, "subsetStates");
+   subsetStates = p_newStates;
+ }
+ memcpy (&subsetStates[(size_t) totSubsetStates * totWords], set, totWords * sizeof (t_bitsetWord));
+ totSubsetStates++;
+
+ /* Keep the hash table at most half full; rehashing also inserts the new */
+ /* state, otherwise it goes in the first free slot after its hash value  */
+
+ if (totSubsetStates * 2 > hashTableSize)
+   rehash_subset_states (hashTableSize * 2);
+ else {
+   iSlot = (unsigned int) (hash_bitset (set) & (hashTableSize - 1));
+   while (hashTable[iSlot] != NO_SUBSET_STATE)
+     iSlot = (iSlot + 1) & (hashTableSize - 1);
+   hashTable[iSlot] = (int) (totSubsetStates - 1);
+ }
+ return (totSubsetStates - 1);
+}
+
+/*
+*---------------------------------------------------------------------
+* Add a transition between two subset states
+*---------------------------------------------------------------------
+*/
+
+static void add_subset_transition (unsigned int fromState, t_symbolCode withSymbol, unsigned int toState)
+{
+ t_subsetTransition
+   *p_newTransitions;
+
+ if (totSubsetTransitions == maxSubsetTransitions) {
+   maxSubsetTransitions *= 2;
+   p_newTransitions = (t_subsetTransition *) realloc (subsetTransitions, maxSubsetTransitions * sizeof (t_subsetTransition));
+   if (p_newTransitions == NULL)
+     ERROR_no_memory (0, __FILE__, __func__, "subsetTransitions");
+   subsetTransitions = p_newTransitions;
+ }
+ subsetTransitions[totSubsetTransitions].fromState  = fromState;
+ subsetTransitions[totSubsetTransitions].withSymbol = withSymbol;
+ subsetTransitions[totSubsetTransitions].toState    = toState;
+ totSubsetTransitions++;
+}
+
+/*
+*---------------------------------------------------------------------
+* Build the DFA by subset construction over the NFA
+*---------------------------------------------------------------------
+*/
+
+void build_subset_DFA (void)
+{
+ unsigned int
+   iState,
+   iWord,
+   iBit,
+   iSlot,
+   nfaState,
+   toState;
+ int
+   foundState;
+ t_bitsetWord
+   word;
+
+ free_subset_DFA();
+ setup_symbol_slots();
+ setup_nfa_tables();
+
+ totWords = (totNFAnumbers + BITS_PER_WORD - 1) / BITS_PER_WORD;
+ if (totWords == 0)
+   totWords = 1;
+ moveSets   = (t_bitsetWord *) subset_malloc ((size_t) totSlots * totWords * sizeof (t_bitsetWord), __func__, "moveSets");
+ newSet     = (t_bitsetWord *) subset_malloc (totWords * sizeof (t_bitsetWord),                     __func__, "newSet");
+ b_slotUsed = (bool *)         subset_malloc (totSlots * sizeof (bool),                             __func__, "b_slotUsed");
+ workStack  = (unsigned int *) subset_malloc ((totNFAnumbers + 1) * sizeof (unsigned int),          __func__, "workStack");
+ memset (moveSets,   0, (size_t) totSlots * totWords * sizeof (t_bitsetWord));
+ memset (b_slotUsed, 0, totSlots * sizeof (bool));
+
+ maxSubsetStates = maxSubsetTransitions = INITIAL_SUBSET_STATES;
+ subsetStates      = (t_bitsetWord *)       subset_malloc ((size_t) maxSubsetStates * totWords * sizeof (t_bitsetWord), __func__, "subsetStates");
+ subsetTransitions = (t_subsetTransition *) subset_malloc (maxSubsetTransitions * sizeof (t_subsetTransition),         __func__, "subsetTransitions");
+ rehash_subset_states (2 * INITIAL_SUBSET_STATES);
+
+ /* The start state is the closure of the NFA state with item E' -> . E $ */
+
+ memset (newSet, 0, totWords * sizeof (t_bitsetWord));
+ nfaState = itemCode2nfaState[ruleNumberDotPosition2itemCode (1, 0)];
+ newSet[nfaState / BITS_PER_WORD] |= (1UL << (nfaState % BITS_PER_WORD));
+ epsilon_closure (newSet);
+ (void) add_subset_state (newSet);
+
+ /* Breadth first: work out the goto() sets of each state in turn; */
+ /* new states are appended and processed later in the same loop   */
+
+ for (iState = 0; iState < totSubsetStates; iState++) {
+
+   /* Move: sort the symbol transitions of all NFA states in the set by symbol */
+
+   for (iWord = 0; iWord < totWords; iWord++) {
+     word = subsetStates[(size_t) iState * totWords + iWord];
+     for (iBit = 0; word != 0; iBit++, word >>= 1) {
+       if (! (word & 1UL))
+         continue;
+       nfaState = iWord * BITS_PER_WORD + iBit;
+       if (nfaMoveSlot[nfaState] == NO_SYMBOL_SLOT)
+         continue;
+       iSlot = (unsigned int) nfaMoveSlot[nfaState];
+       b_slotUsed[iSlot] = true;
+       moveSets[(size_t) iSlot * totWords + nfaMoveDest[nfaState] / BITS_PER_WORD] |= (1UL << (nfaMoveDest[nfaState] % BITS_PER_WORD));
+     }
+   }
+
+   /* Closure and hash-consing of each goto() set, in symbol order */
+
+   for (iSlot = 0; iSlot < totSlots; iSlot++) {
+     if (! b_slotUsed[iSlot])
+       continue;
+     b_slotUsed[iSlot] = false;
+     memcpy (newSet, &moveSets[(size_t) iSlot * totWords], totWords * sizeof (t_bitsetWord));
+     memset (&moveSets[(size_t) iSlot * totWords], 0, totWords * sizeof (t_bitsetWord));
+     epsilon_closure (newSet);
+     foundState = find_subset_state (newSet);
+     toState = (foundState == NO_SUBSET_STATE) ? add_subset_state (newSet) : (unsigned int) foundState;
+     add_subset_transition (iState, slot2symbolCode[iSlot], toState);
+   }
+ }
+}
+
+/*
+*---------------------------------------------------------------------
+* Check that the subset DFA and the item-based DFA are the same
+* automaton, with the same state numbers, and report the result
+*---------------------------------------------------------------------
+*/
+
+void check_subset_DFA (void)
+{
+ unsigned int
+   iState,
+   iItem,
+   iTransition,
+   nfaState;
+ int
+   subsetState;
+ t_stateCode
+   stateCode,
+   fromState,
+   toState;
+ t_subsetTransition
+   *p_transition;
+
+ if (totSubsetStates != totDFAstates) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Subset construction built %u DFA states; the item-based DFA has %u\n", totSubsetStates, totDFAstates);
+   ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+ }
+ if (totSubsetTransitions != totDFAtransitions) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Subset construction built %u DFA transitions; the item-based DFA has %u\n", totSubsetTransitions, totDFAtransitions);
+   ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+ }
+
+ /* Each item-based state must hold exactly the NFA states of the */
+ /* subset state with the same number                             */
+
+ for (iState = 1; iState <= totDFAstates; iState++) {
+   stateCode = dfa_stateNumber2stateCode (iState);
+   memset (newSet, 0, totWords * sizeof (t_bitsetWord));
+   for (iItem = 1; iItem <= dfa_stateCode2totItems (stateCode); iItem++) {
+     nfaState = itemCode2nfaState[dfa_stateCode2itemCode (stateCode, iItem)];
+     newSet[nfaState / BITS_PER_WORD] |= (1UL << (nfaState % BITS_PER_WORD));
+   }
+   subsetState = find_subset_state (newSet);
+   if (subsetState != (int) iState - 1) {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "DFA state %d does not match subset state %u\n", stateCode, iState);
+     ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+   }
+ }
+
+ /* Every subset transition must be in the item-based DFA */
+
+ for (iTransition = 0; iTransition < totSubsetTransitions; iTransition++) {
+   p_transition = &subsetTransitions[iTransition];
+   fromState = dfa_stateNumber2stateCode (p_transition->fromState + 1);
+   toState   = dfa_stateNumber2stateCode (p_transition->toState + 1);
+   if (dfa_lookupNextState (fromState, p_transition->withSymbol) != toState) {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Subset DFA transition from %d with %s to %d is not in the item-based DFA\n",
+               fromState, symbolCode2symbolString (p_transition->withSymbol), toState);
+     ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+   }
+ }
+ printf ("Subset construction: %u DFA states and %u transitions, same as the item-based DFA\n", totSubsetStates, totSubsetTransitions);
+ fflush (stdout);
+}
+
+/*
+*---------------------------------------------------------------------
+* Free all memory used by the subset DFA
+*---------------------------------------------------------------------
+*/
+
+void free_subset_DFA (void)
+{
+ free (slot2symbolCode);
+ free (nfaMoveSlot);
+ free (nfaMoveDest);
+ free (nfaEpsilonFirst);
+ free (nfaEpsilonDest);
+ free (itemCode2nfaState);
+ free (subsetStates);
+ free (subsetTransitions);
+ free (hashTable);
+ free (moveSets);
+ free (newSet);
+ free (b_slotUsed);
+ free (workStack);
+ slot2symbolCode   = NULL;
+ nfaMoveSlot       = NULL;
+ nfaMoveDest       = NULL;
+ nfaEpsilonFirst   = NULL;
+ nfaEpsilonDest    = NULL;
+ itemCode2nfaState = NULL;
+ subsetStates      = NULL;
+ subsetTransitions = NULL;
+ hashTable         = NULL;
+ moveSets          = NULL;
+ newSet            = NULL;
+ b_slotUsed        = NULL;
+ workStack         = NULL;
+ totNFAnumbers = totWords = totSlots = 0;
+ totSubsetStates = maxSubsetStates = 0;
+ totSubsetTransitions = maxSubsetTransitions = 0;
+ hashTableSize = 0;
+}
@@ -0,0 +1,38 @@
+/*
+*-----------------------------------------------------------------------
+*
+*   File         : subsetdfa.h
+*   Created      : 2026-10-19
+*   Last Modified: 2026-10-19
+*
+*   DESCRIPTION:
+*   DFA construction by subset construction over the LR(0) NFA,
+*   used to cross-check the item-based DFA
+*
+*-----------------------------------------------------------------------
+*/
+
+/*                                           */
+/* Make sure this file is not included twice */
+/*                                           */
+
+#ifndef _SUBSETDFA_DOT_H_
+#define _SUBSETDFA_DOT_H_
+
+/*
+*---------------------------------------------------------------------
+*   INCLUDE FILES
+*---------------------------------------------------------------------
+*/
+
+/*
+*---------------------------------------------------------------------
+* Function prototypes
+*---------------------------------------------------------------------
+*/
+
+extern void build_subset_DFA  (void);
+extern void check_subset_DFA  (void);
+extern void free_subset_DFA   (void);
+
+#endif /* ifndef _SUBSETDFA_DOT_H_ */
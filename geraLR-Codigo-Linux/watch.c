@@ -0,0 +1,443 @@
+/*
+*-----------------------------------------------------------------------
+*
+*   File         : watch.c
+*   Created      : 2026-10-19
+*   Last Modified: 2026-10-19
+*
+*   DESCRIPTION:
+*   Watch mode. The watched files are followed with inotify through
+*   their directories, so that editors that save by writing a new file
+*   and renaming it over the old one are noticed as well. Events are
+*   debounced: once a file changes, the watcher waits until no event
+*   has come for WATCH_DEBOUNCE_MS before regenerating anything, so a
+*   save that touches the file several times costs one regeneration.
+*
+*   The work is split in three stages run by a "holder" child process:
+*   the build stage does the expensive part and keeps its results in
+*   memory, the write stage writes every output, and the refresh stage
+*   writes again only the outputs that depend on the files that can
+*   change without a new build. The write and refresh stages run in
+*   children of the holder, so the holder's memory is still intact
+*   after them. When a file that needs a new build changes, or the
+*   holder has died (e.g. the build stage found an error in the
+*   grammar), the holder is replaced.
+*
+*-----------------------------------------------------------------------
+*/
+
+/*
+*-----------------------------------------------------------------------
+*   LIBRARIES AND INCLUDE FILES
+*-----------------------------------------------------------------------
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/inotify.h>
+
+#include "error.h"
+#include "watch.h"
+
+/*
+*---------------------------------------------------------------------
+*
+*   INTERFACE (visible from other modules)
+*
+*---------------------------------------------------------------------
+*/
+
+/*                     */
+/* Function prototypes */
+/*                     */
+
+void watch_files (char *programName, int totFiles, char *fileNames[], const bool b_rebuildOnChange[],
+                  t_watchStage buildStage, t_watchStage writeStage, t_watchStage refreshStage);
+
+/*
+*---------------------------------------------------------------------
+*
+*   IMPLEMENTATION (not visible from other modules)
+*
+*---------------------------------------------------------------------
+*/
+
+#define MAX_WATCHED_FILES  4
+#define WATCH_DEBOUNCE_MS  150
+#define WATCH_EVENTS       (IN_CLOSE_WRITE | IN_MOVED_TO)
+
+static volatile sig_atomic_t
+  b_stopWatching = 0;
+
+/* What is watched: each file through the directory that holds it */
+
+static int
+  inotifyFd = -1,
+  totWatchedFiles = 0,
+  watchDescriptor [MAX_WATCHED_FILES];
+static const char
+  *watchedBaseName [MAX_WATCHED_FILES];
+
+/* The holder process, and the pipe on which it is asked to refresh */
+
+static pid_t
+  holderPid = -1;
+static int
+  holderPipe = -1;
+
+static char
+  *watcherName = NULL;
+
+/*                       */
+/* Function declarations */
+/*                       */
+
+static void   stop_watching   (int signalNumber);
+static void   add_watch       (int iFile, const char *fileName);
+static bool   read_events     (bool b_changed[]);
+static double elapsed_seconds (const struct timespec *p_start);
+static void   run_stage       (t_watchStage stage, const struct timespec *p_start);
+static void   start_holder    (t_watchStage buildStage, t_watchStage writeStage, t_watchStage refreshStage);
+static void   stop_holder     (void);
+static bool   b_holder_alive  (void);
+
+/*
+*---------------------------------------------------------------------
+* Signal handler for SIGINT and SIGTERM
+*---------------------------------------------------------------------
+*/
+
+static void stop_watching (int signalNumber)
+{
+ (void) signalNumber;
+ b_stopWatching = 1;
+}
+
+/*
+*---------------------------------------------------------------------
+* Watch the directory of a file for files written or moved into it
+*---------------------------------------------------------------------
+*/
+
+static void add_watch (int iFile, const char *fileName)
+{
+ char
+   dirName [FILENAME_MAX];
+ const char
+   *slash;
+
+ slash = strrchr (fileName, '/');
+ if (slash == NULL) {
+   strcpy (dirName, ".");
+   watchedBaseName[iFile] = fileName;
+ }
+ else {
+   if ((size_t) (slash - fileName) >= sizeof (dirName)) {
+     snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "File name \"%s\" is too long", fileName);
+     ERROR_short_fatal_error (ERROR_auxErrorMsg);
+   }
+   if (slash == fileName)
+     strcpy (dirName, "/");
+   else {
+     memcpy (dirName, fileName, (size_t) (slash - fileName));
+     dirName[slash - fileName] = '\0';
+   }
+   watchedBaseName[iFile] = slash + 1;
+ }
+
+ errno = 0;
+ if ((watchDescriptor[iFile] = inotify_add_watch (inotifyFd, dirName, WATCH_EVENTS)) < 0) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Cannot watch directory \"%s\"", dirName);
+   ERROR_fatal_error (errno, __FILE__, __func__, ERROR_auxErrorMsg);
+ }
+}
+
+/*
+*---------------------------------------------------------------------
+* Read the pending inotify events and mark the watched files they
+* name. Returns false if the read was interrupted by a signal.
+*---------------------------------------------------------------------
+*/
+
+static bool read_events (bool b_changed[])
+{
+ char
+   buffer [4096] __attribute__ ((aligned (__alignof__ (struct inotify_event))));
+ const struct inotify_event
+   *event;
+ ssize_t
+   bytesRead;
+ char
+   *next;
+ int
+   iFile;
+
+ errno = 0;
+ if ((bytesRead = read (inotifyFd, buffer, sizeof (buffer))) < 0) {
+   if (errno == EINTR)
+     return (false);
+   ERROR_fatal_error (errno, __FILE__, __func__, "Cannot read inotify events");
+ }
+ for (next = buffer; next < buffer + bytesRead; next += sizeof (struct inotify_event) + event->len) {
+   event = (const struct inotify_event *) next;
+   if (event->len == 0)
+     continue;
+   for (iFile = 0; iFile < totWatchedFiles; iFile++)
+     if ((event->wd == watchDescriptor[iFile]) && (strcmp (event->name, watchedBaseName[iFile]) == 0))
+       b_changed[iFile] = true;
+ }
+ return (true);
+}
+
+/*
+*---------------------------------------------------------------------
+* Seconds since a reading of the monotonic clock
+*---------------------------------------------------------------------
+*/
+
+static double elapsed_seconds (const struct timespec *p_start)
+{
+ struct timespec
+   now;
+
+ clock_gettime (CLOCK_MONOTONIC, &now);
+ return ((double) (now.tv_sec - p_start->tv_sec) + (double) (now.tv_nsec - p_start->tv_nsec) / 1e9);
+}
+
+/*
+*---------------------------------------------------------------------
+* Run a stage in a child of the holder, wait for it and tell how it
+* went
+*---------------------------------------------------------------------
+*/
+
+static void run_stage (t_watchStage stage, const struct timespec *p_start)
+{
+ pid_t
+   child;
+ int
+   status;
+
+ fflush (NULL);
+ errno = 0;
+ if ((child = fork ()) < 0)
+   ERROR_fatal_error (errno, __FILE__, __func__, "Cannot fork a child for the outputs");
+ if (child == 0) {
+   stage ();
+   exit (EXIT_SUCCESS);
+ }
+
+ while (waitpid (child, &status, 0) < 0)
+   if (errno != EINTR) {
+     status = EXIT_FAILURE << 8;
+     break;
+   }
+ if (WIFEXITED (status) && (WEXITSTATUS (status) == EXIT_SUCCESS))
+   printf ("%s: done in %.3f s\n", watcherName, elapsed_seconds (p_start));
+ else if (WIFSIGNALED (status))
+   printf ("%s: failed (signal %d)\n", watcherName, WTERMSIG (status));
+ else
+   printf ("%s: failed (exit status %d)\n", watcherName, WEXITSTATUS (status));
+ fflush (stdout);
+}
+
+/*
+*---------------------------------------------------------------------
+* Start a holder: it builds, writes every output, then refreshes them
+* for each byte read from its pipe until the pipe is closed
+*---------------------------------------------------------------------
+*/
+
+static void start_holder (t_watchStage buildStage, t_watchStage writeStage, t_watchStage refreshStage)
+{
+ int
+   pipeFds [2];
+ char
+   requests [64];
+ ssize_t
+   bytesRead;
+ struct timespec
+   start;
+
+ errno = 0;
+ if (pipe (pipeFds) < 0)
+   ERROR_fatal_error (errno, __FILE__, __func__, "Cannot create a pipe for the holder");
+ fflush (NULL);
+ errno = 0;
+ if ((holderPid = fork ()) < 0)
+   ERROR_fatal_error (errno, __FILE__, __func__, "Cannot fork the holder");
+
+ if (holderPid > 0) {
+   close (pipeFds[0]);
+   holderPipe = pipeFds[1];
+   return;
+ }
+
+ signal (SIGINT,  SIG_DFL);
+ signal (SIGTERM, SIG_DFL);
+ close (pipeFds[1]);
+ close (inotifyFd);
+
+ /* build() parses the command line again, so getopt() must start over */
+
+ optind = 1;
+ clock_gettime (CLOCK_MONOTONIC, &start);
+ buildStage ();
+ run_stage (writeStage, &start);
+
+ /* Several refresh requests sent while one is running make a single one */
+
+ for (;;) {
+   bytesRead = read (pipeFds[0], requests, sizeof (requests));
+   if ((bytesRead < 0) && (errno == EINTR))
+     continue;
+   if (bytesRead <= 0)
+     exit (EXIT_SUCCESS);
+   clock_gettime (CLOCK_MONOTONIC, &start);
+   run_stage (refreshStage, &start);
+ }
+}
+
+/*
+*---------------------------------------------------------------------
+* Close the holder's pipe, which tells it to exit, and wait for it
+*---------------------------------------------------------------------
+*/
+
+static void stop_holder (void)
+{
+ if (holderPid < 0)
+   return;
+ close (holderPipe);
+ while ((waitpid (holderPid, NULL, 0) < 0) && (errno == EINTR))
+   ;
+ holderPid = -1;
+ holderPipe = -1;
+}
+
+/*
+*---------------------------------------------------------------------
+* Tell whether the holder is still running, collecting it if it
+* has exited
+*---------------------------------------------------------------------
+*/
+
+static bool b_holder_alive (void)
+{
+ if (holderPid < 0)
+   return (false);
+ if (waitpid (holderPid, NULL, WNOHANG) == 0)
+   return (true);
+ close (holderPipe);
+ holderPid = -1;
+ holderPipe = -1;
+ return (false);
+}
+
+/*
+*---------------------------------------------------------------------
+* Build and write everything, then regenerate on each change to the
+* watched files until SIGINT or SIGTERM is received
+*---------------------------------------------------------------------
+*/
+
+void watch_files (char *programName, int totFiles, char *fileNames[], const bool b_rebuildOnChange[],
+                  t_watchStage buildStage, t_watchStage writeStage, t_watchStage refreshStage)
+{
+ int
+   iFile,
+   ready;
+ bool
+   b_changed [MAX_WATCHED_FILES],
+   b_rebuild,
+   b_refresh;
+ struct pollfd
+   inotifyPoll;
+ struct sigaction
+   action;
+
+ if (totFiles > MAX_WATCHED_FILES) {
+   snprintf (ERROR_auxErrorMsg, ERROR_maxErrorMsgSize, "Too many files to watch (max = %d)", MAX_WATCHED_FILES);
+   ERROR_fatal_error (0, __FILE__, __func__, ERROR_auxErrorMsg);
+ }
+ watcherName = programName;
+
+ /* No SA_RESTART, so that a signal gets the watcher out of poll() */
+
+ memset (&action, 0, sizeof (action));
+ action.sa_handler = stop_watching;
+ sigemptyset (&action.sa_mask);
+ sigaction (SIGINT,  &action, NULL);
+ sigaction (SIGTERM, &action, NULL);
+ signal (SIGPIPE, SIG_IGN);
+
+ errno = 0;
+ if ((inotifyFd = inotify_init ()) < 0)
+   ERROR_fatal_error (errno, __FILE__, __func__, "Cannot initialize inotify");
+ totWatchedFiles = totFiles;
+ for (iFile = 0; iFile < totFiles; iFile++)
+   add_watch (iFile, fileNames[iFile]);
+ inotifyPoll.fd = inotifyFd;
+ inotifyPoll.events = POLLIN;
+
+ printf ("%s: watching", programName);
+ for (iFile = 0; iFile < totFiles; iFile++)
+   printf ("%s \"%s\"", (iFile == 0) ? "" : ((iFile == totFiles - 1) ? " and" : ","), fileNames[iFile]);
+ printf (" (Ctrl-C to stop)\n");
+ start_holder (buildStage, writeStage, refreshStage);
+
+ while (! b_stopWatching) {
+
+   /* Wait for a change, then for WATCH_DEBOUNCE_MS without any */
+
+   memset (b_changed, 0, sizeof (b_changed));
+   if (! read_events (b_changed))
+     continue;
+   while ((ready = poll (&inotifyPoll, 1, WATCH_DEBOUNCE_MS)) != 0) {
+     if (ready < 0) {
+       if (errno == EINTR)
+         break;
+       ERROR_fatal_error (errno, __FILE__, __func__, "Cannot poll for inotify events");
+     }
+     (void) read_events (b_changed);
+   }
+   if (b_stopWatching)
+     break;
+
+   b_rebuild = false;
+   b_refresh = false;
+   for (iFile = 0; iFile < totFiles; iFile++)
+     if (b_changed[iFile]) {
+       printf ("%s: \"%s\" changed\n", programName, fileNames[iFile]);
+       if (b_rebuildOnChange[iFile])
+         b_rebuild = true;
+       else
+         b_refresh = true;
+     }
+   fflush (stdout);
+
+   if (b_rebuild || (b_refresh && ! b_holder_alive ())) {
+     stop_holder ();
+     start_holder (buildStage, writeStage, refreshStage);
+   }
+   else if (b_refresh && (write (holderPipe, "r", 1) != 1)) {
+     stop_holder ();
+     start_holder (buildStage, writeStage, refreshStage);
+   }
+ }
+
+ stop_holder ();
+ close (inotifyFd);
+ printf ("%s: stopped watching\n", programName);
+}
@@ -0,0 +1,53 @@
+/*
+*-----------------------------------------------------------------------
+*
+*   File         : watch.h
+*   Created      : 2026-10-19
+*   Last Modified: 2026-10-19
+*
+*   DESCRIPTION:
+*   Watch mode: input files watched with inotify, and the outputs
+*   regenerated whenever one of them is saved, rebuilding only what
+*   depends on the files that changed
+*
+*-----------------------------------------------------------------------
+*/
+
+/*                                           */
+/* Make sure this file is not included twice */
+/*                                           */
+
+#ifndef _WATCH_DOT_H_
+#define _WATCH_DOT_H_
+
+#include <stdbool.h>
+
+/*
+*---------------------------------------------------------------------
+*   Type definitions
+*---------------------------------------------------------------------
+*/
+
+/* One stage of the regeneration. See watch_files(). */
+
+typedef void (*t_watchStage) (void);
+
+/*
+*---------------------------------------------------------------------
+* Function prototypes
+*---------------------------------------------------------------------
+*/
+
+/* watch_files() keeps a child process that runs buildStage() and   */
+/* holds what it built. writeStage() then runs in a child of that   */
+/* process, and so does refreshStage() each time a file whose       */
+/* b_rebuildOnChange entry is false changes. A change to any other  */
+/* file replaces the holder with a new one, which builds everything */
+/* again. writeStage() and refreshStage() may free or overwrite     */
+/* anything, as their children exit when they return. Returns once  */
+/* SIGINT or SIGTERM is received.                                   */
+
+extern void watch_files (char *programName, int totFiles, char *fileNames[], const bool b_rebuildOnChange[],
+                         t_watchStage buildStage, t_watchStage writeStage, t_watchStage refreshStage);
+
+#endif /* ifndef _WATCH_DOT_H_ */